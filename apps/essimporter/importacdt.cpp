@@ -70,7 +70,7 @@ namespace ESSImport
             esm.skipHSub(); // "PlayerSaveGame", link to some object?
 
         while (esm.isNextSub("FGTN"))
-            esm.getHString(); // fight target?
+            esm.getHStringView(); // fight target?
 
         // unsure at which point between TGTN and CRED
         if (esm.isNextSub("AADT"))
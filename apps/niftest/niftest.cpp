@@ -49,7 +49,7 @@ void readVFS(VFS::Archive* anArchive,std::string archivePath = "")
             if(isNIF(name))
             {
             //           std::cout << "Decoding: " << name << std::endl;
-                Nif::NIFFile temp_nif(myManager.get(name),archivePath+name);
+                Nif::NIFFile temp_nif(myManager.getView(name),archivePath+name);
             }
             else if(isBSA(name))
             {
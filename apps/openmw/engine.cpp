@@ -2,9 +2,11 @@
 
 #include <iomanip>
 #include <chrono>
+#include <sstream>
 #include <thread>
 
 #include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
 
 #include <osg/Version>
 
@@ -18,6 +20,9 @@
 
 #include <components/misc/rng.hpp>
 
+#include <components/bsa/decompressedcache.hpp>
+
+#include <components/vfs/indexcache.hpp>
 #include <components/vfs/manager.hpp>
 #include <components/vfs/registerarchives.hpp>
 
@@ -25,10 +30,12 @@
 #include <components/sdlutil/imagetosurface.hpp>
 
 #include <components/resource/resourcesystem.hpp>
+#include <components/resource/scenecache.hpp>
 #include <components/resource/scenemanager.hpp>
 #include <components/resource/stats.hpp>
 
 #include <components/compiler/extensions0.hpp>
+#include <components/compiler/scriptcache.hpp>
 
 #include <components/sceneutil/workqueue.hpp>
 
@@ -55,6 +62,7 @@
 
 #include "mwworld/class.hpp"
 #include "mwworld/player.hpp"
+#include "mwworld/storesnapshot.hpp"
 #include "mwworld/worldimp.hpp"
 
 #include "mwrender/vismask.hpp"
@@ -238,6 +246,30 @@ namespace
         void operator()(std::string) const {}
     };
 
+    std::string makeScriptCacheKey(const std::string& version, int warningsMode, const Compiler::Extensions& extensions,
+        const Files::Collections& fileCollections, const std::vector<std::string>& contentFiles)
+    {
+        std::ostringstream key;
+        key << version << '\n' << "warnings mode " << warningsMode << '\n';
+        // Scripts refer to global variables, locals of other scripts and object IDs from any content file
+        for (const std::string& file : contentFiles)
+        {
+            const Files::MultiDirCollection& collection
+                = fileCollections.getCollection(boost::filesystem::path(file).extension().string());
+            if (!collection.doesExist(file))
+            {
+                key << file << '\n';
+                continue;
+            }
+            const boost::filesystem::path path = collection.getPath(file);
+            boost::system::error_code ec;
+            key << path.string() << ' ' << boost::filesystem::file_size(path, ec)
+                << ' ' << boost::filesystem::last_write_time(path, ec) << '\n';
+        }
+        extensions.write(key);
+        return key.str();
+    }
+
     class IdentifyOpenGLOperation : public osg::GraphicsOperation
     {
     public:
@@ -448,8 +480,13 @@ OMW::Engine::~Engine()
     if (mScreenCaptureOperation != nullptr)
         mScreenCaptureOperation->stop();
 
+    if (mScriptCache != nullptr)
+        mScriptCache->save();
+
     mEnvironment.cleanup();
 
+    mScriptCache = nullptr;
+
     delete mScriptContext;
     mScriptContext = nullptr;
 
@@ -681,7 +718,23 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
 
     mVFS.reset(new VFS::Manager(mFSStrict));
 
-    VFS::registerArchives(mVFS.get(), mFileCollections, mArchives, true);
+    std::unique_ptr<VFS::IndexCache> vfsIndexCache;
+    if (Settings::Manager::getBool("cache data directory index", "General"))
+    {
+        vfsIndexCache = std::make_unique<VFS::IndexCache>(mCfgMgr.getCachePath() / "vfsindex.bin");
+        vfsIndexCache->load();
+    }
+
+    VFS::registerArchives(mVFS.get(), mFileCollections, mArchives, true,
+        Settings::Manager::getBool("memory map archives", "General"), vfsIndexCache.get());
+
+    if (vfsIndexCache != nullptr)
+        vfsIndexCache->save();
+
+    const int decompressedCacheSize = Settings::Manager::getInt("decompressed file cache size", "Cells");
+    if (decompressedCacheSize < 0)
+        throw std::runtime_error("Invalid setting: 'decompressed file cache size' must be >=0");
+    Bsa::getDecompressedCache().setMaxSize(static_cast<std::size_t>(decompressedCacheSize) * 1024 * 1024);
 
     mResourceSystem.reset(new Resource::ResourceSystem(mVFS.get()));
     mResourceSystem->getSceneManager()->setUnRefImageDataAfterApply(false); // keep to Off for now to allow better state sharing
@@ -691,6 +744,9 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
         Settings::Manager::getString("texture mipmap", "General"),
         Settings::Manager::getInt("anisotropy", "General")
     );
+    if (Settings::Manager::getBool("cache converted models", "Models"))
+        mResourceSystem->getSceneManager()->setSceneCache(std::make_unique<Resource::SceneCache>(
+            (mCfgMgr.getCachePath() / "scenes").string(), Version::getOpenmwVersionDescription(mResDir.string())));
 
     int numThreads = Settings::Manager::getInt("preload num threads", "Cells");
     if (numThreads <= 0)
@@ -803,10 +859,15 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
             window->playVideo(logo, true);
     }
 
+    std::unique_ptr<MWWorld::StoreSnapshot> storeSnapshot;
+    if (Settings::Manager::getBool("cache merged content", "General"))
+        storeSnapshot = std::make_unique<MWWorld::StoreSnapshot>(mCfgMgr.getCachePath() / "content.snapshot",
+            Version::getOpenmwVersionDescription(mResDir.string()));
+
     // Create the world
     mEnvironment.setWorld( new MWWorld::World (mViewer, rootNode, mResourceSystem.get(), mWorkQueue.get(),
         mFileCollections, mContentFiles, mGroundcoverFiles, mEncoder, mActivationDistanceOverride, mCellName,
-        mStartupScript, mResDir.string(), mCfgMgr.getUserDataPath().string()));
+        mStartupScript, mResDir.string(), mCfgMgr.getUserDataPath().string(), storeSnapshot.get()));
     mEnvironment.getWorld()->setupPlayer();
 
     window->setStore(mEnvironment.getWorld()->getStore());
@@ -823,8 +884,16 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
     mScriptContext = new MWScript::CompilerContext (MWScript::CompilerContext::Type_Full);
     mScriptContext->setExtensions (&mExtensions);
 
+    if (Settings::Manager::getBool("cache compiled scripts", "General"))
+    {
+        mScriptCache = std::make_unique<Compiler::ScriptCache>(mCfgMgr.getCachePath() / "scripts.bin",
+            makeScriptCacheKey(Version::getOpenmwVersionDescription(mResDir.string()), mWarningsMode, mExtensions,
+                mFileCollections, mContentFiles));
+        mScriptCache->load();
+    }
+
     mEnvironment.setScriptManager (new MWScript::ScriptManager (mEnvironment.getWorld()->getStore(), *mScriptContext, mWarningsMode,
-        mScriptBlacklistUse ? mScriptBlacklist : std::vector<std::string>()));
+        mScriptBlacklistUse ? mScriptBlacklist : std::vector<std::string>(), mScriptCache.get()));
 
     // Create game mechanics system
     MWMechanics::MechanicsManager* mechanics = new MWMechanics::MechanicsManager;
@@ -845,6 +914,13 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
                 << 100*static_cast<double> (result.second)/result.first
                 << "%)";
     }
+    else if (Settings::Manager::getBool("precompile scripts", "General"))
+    {
+        const std::pair<int, int> result = mEnvironment.getScriptManager()->compileAll();
+        Log(Debug::Info) << "Precompiled " << result.second << " of " << result.first << " scripts";
+    }
+    if (mScriptCache != nullptr)
+        mScriptCache->save();
     if (mCompileAllDialogue)
     {
         std::pair<int, int> result = MWDialogue::ScriptTest::compileAll(&mExtensions, mWarningsMode);
@@ -912,6 +988,9 @@ private:
         ScopedProfile<UserStatsType::Lua> profile(frameStart, frameNumber, *osg::Timer::instance(), *viewer->getViewerStats());
 
         mEngine->mLuaManager->update();
+
+        if (viewer->getViewerStats()->collectStats("resource"))
+            mEngine->mLuaManager->reportStats(frameNumber, *viewer->getViewerStats());
     }
 
     void threadBody()
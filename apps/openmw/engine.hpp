@@ -32,6 +32,7 @@ namespace VFS
 namespace Compiler
 {
     class Context;
+    class ScriptCache;
 }
 
 namespace MWLua
@@ -90,6 +91,7 @@ namespace OMW
 
             Compiler::Extensions mExtensions;
             Compiler::Context *mScriptContext;
+            std::unique_ptr<Compiler::ScriptCache> mScriptCache;
 
             MWLua::LuaManager* mLuaManager;
 
@@ -372,7 +372,7 @@ namespace MWDialogue
                     if(!inJournal(topicId, answer->mId))
                     {
                         // Does this dialogue contains some actor-specific answer?
-                        if (Misc::StringUtils::ciEqual(answer->mActor, mActor.getCellRef().getRefId()))
+                        if (answer->mActor == mActor.getCellRef().getRefId())
                             topicFlags |= MWBase::DialogueManager::TopicType::Specific;
                     }
                     else
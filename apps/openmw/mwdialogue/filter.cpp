@@ -28,7 +28,8 @@ bool MWDialogue::Filter::testActor (const ESM::DialInfo& info) const
     // actor id
     if (!info.mActor.empty())
     {
-        if ( !Misc::StringUtils::ciEqual(info.mActor, mActor.getCellRef().getRefId()))
+        // Both IDs are lower-cased
+        if (info.mActor != mActor.getCellRef().getRefId())
             return false;
     }
     else if (isCreature)
@@ -476,7 +477,7 @@ bool MWDialogue::Filter::getSelectStructBoolean (const SelectWrapper& select) co
 
         case SelectWrapper::Function_NotId:
 
-            return !Misc::StringUtils::ciEqual(mActor.getCellRef().getRefId(), select.getName());
+            return mActor.getCellRef().getRefId() != select.getName();
 
         case SelectWrapper::Function_NotFaction:
 
@@ -4,6 +4,7 @@
 
 #include <components/debug/debuglog.hpp>
 #include <components/lua/luastate.hpp>
+#include <components/misc/stringops.hpp>
 #include <components/settings/settings.hpp>
 
 #include <apps/openmw/mwbase/luamanager.hpp>
@@ -98,7 +99,7 @@ namespace MWLua
             else
             {
                 const std::string& recordId = std::get<std::string>(item);
-                if (old_it != store.end() && old_it->getCellRef().getRefId() == recordId)
+                if (old_it != store.end() && Misc::StringUtils::ciEqual(old_it->getCellRef().getRefId(), recordId))
                     return true;  // already equipped
                 itemPtr = store.search(recordId);
                 if (itemPtr.isEmpty() || itemPtr.getRefData().getCount() == 0)
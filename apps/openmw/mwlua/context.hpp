@@ -25,6 +25,7 @@ namespace MWLua
         WorldView* mWorldView;
         LocalEventQueue* mLocalEventQueue;
         GlobalEventQueue* mGlobalEventQueue;
+        EventDataPool* mEventDataPool;
     };
 
 }
@@ -11,6 +11,26 @@
 namespace MWLua
 {
 
+    std::string EventDataPool::take()
+    {
+        if (mBuffers.empty())
+            return {};
+        std::string res = std::move(mBuffers.back());
+        mBuffers.pop_back();
+        return res;
+    }
+
+    void EventDataPool::release(std::string&& data)
+    {
+        // Rare big events shouldn't hold memory forever
+        constexpr std::size_t maxBuffers = 1024;
+        constexpr std::size_t maxBufferSize = 64 * 1024;
+        if (mBuffers.size() >= maxBuffers || data.capacity() > maxBufferSize)
+            return;
+        data.clear();
+        mBuffers.push_back(std::move(data));
+    }
+
     template <typename Event>
     void saveEvent(ESM::ESMWriter& esm, const ObjectId& dest, const Event& event)
     {
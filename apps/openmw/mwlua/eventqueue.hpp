@@ -21,20 +21,45 @@ namespace sol
 
 namespace MWLua
 {
+    class EventDataPool;
+
     struct GlobalEvent
     {
         std::string mEventName;
         std::string mEventData;
+        EventDataPool* mDataPool = nullptr;  ///< The pool mEventData was taken from, if any.
     };
     struct LocalEvent
     {
         ObjectId mDest;
         std::string mEventName;
         std::string mEventData;
+        EventDataPool* mDataPool = nullptr;  ///< The pool mEventData was taken from, if any.
     };
     using GlobalEventQueue = std::vector<GlobalEvent>;
     using LocalEventQueue = std::vector<LocalEvent>;
 
+    // Keeps the buffers of delivered events to serialize new events into them without memory allocations.
+    // Not thread safe, every thread that sends events needs its own pool.
+    class EventDataPool
+    {
+    public:
+        std::string take();
+        void release(std::string&& data);
+
+    private:
+        std::vector<std::string> mBuffers;
+    };
+
+    // Returns the buffer of a delivered event to the pool it was taken from. The pool may belong to another
+    // thread, so it must not be used concurrently.
+    template <class Event>
+    void releaseEventData(Event& event)
+    {
+        if (event.mDataPool != nullptr)
+            event.mDataPool->release(std::move(event.mEventData));
+    }
+
     void loadEvents(sol::state& lua, ESM::ESMReader& esm, GlobalEventQueue&, LocalEventQueue&,
                     const std::map<int, int>& contentFileMapping, const LuaUtil::UserdataSerializer* serializer);
     void saveEvents(ESM::ESMWriter& esm, const GlobalEventQueue&, const LocalEventQueue&);
@@ -63,6 +63,7 @@ namespace MWLua
         selfAPI["getCombatTarget"] = [worldView=context.mWorldView](SelfObject& self) -> sol::optional<LObject>
         {
             const MWWorld::Ptr& ptr = self.ptr();
+            const auto lock = worldView->lockObjectData();
             MWMechanics::AiSequence& ai = ptr.getClass().getCreatureStats(ptr).getAiSequence();
             MWWorld::Ptr target;
             if (ai.getCombatTarget(target))
@@ -70,15 +71,17 @@ namespace MWLua
             else
                 return {};
         };
-        selfAPI["stopCombat"] = [](SelfObject& self)
+        selfAPI["stopCombat"] = [worldView=context.mWorldView](SelfObject& self)
         {
             const MWWorld::Ptr& ptr = self.ptr();
+            const auto lock = worldView->lockObjectData();
             MWMechanics::AiSequence& ai = ptr.getClass().getCreatureStats(ptr).getAiSequence();
             ai.stopCombat();
         };
-        selfAPI["startCombat"] = [](SelfObject& self, const LObject& target)
+        selfAPI["startCombat"] = [worldView=context.mWorldView](SelfObject& self, const LObject& target)
         {
             const MWWorld::Ptr& ptr = self.ptr();
+            const auto lock = worldView->lockObjectData();
             MWMechanics::AiSequence& ai = ptr.getClass().getCreatureStats(ptr).getAiSequence();
             ai.stack(MWMechanics::AiCombat(target.ptr()), ptr);
         };
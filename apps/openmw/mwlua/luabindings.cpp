@@ -57,7 +57,9 @@ namespace MWLua
         };
         api["sendGlobalEvent"] = [context](std::string eventName, const sol::object& eventData)
         {
-            context.mGlobalEventQueue->push_back({std::move(eventName), LuaUtil::serialize(eventData, context.mSerializer)});
+            std::string data = context.mEventDataPool->take();
+            LuaUtil::serialize(data, eventData, context.mSerializer);
+            context.mGlobalEventQueue->push_back({std::move(eventName), std::move(data), context.mEventDataPool});
         };
         addTimeBindings(api, context, false);
         api["OBJECT_TYPE"] = definitionList(*lua,
@@ -190,7 +192,10 @@ namespace MWLua
     sol::table initLocalStoragePackage(const Context& context, LuaUtil::LuaStorage* globalStorage)
     {
         sol::table res(context.mLua->sol(), sol::create);
-        res["globalSection"] = [globalStorage](std::string_view section) { return globalStorage->getReadOnlySection(section); };
+        res["globalSection"] = [globalStorage](sol::this_state lua, std::string_view section)
+        {
+            return globalStorage->getReadOnlySection(section, lua);
+        };
         return LuaUtil::makeReadOnly(res);
     }
 
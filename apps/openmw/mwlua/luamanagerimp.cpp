@@ -1,6 +1,11 @@
 #include "luamanagerimp.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
+#include <iterator>
+
+#include <osg/Stats>
 
 #include <components/debug/debuglog.hpp>
 
@@ -26,7 +31,20 @@
 namespace MWLua
 {
 
-    LuaManager::LuaManager(const VFS::Manager* vfs, const std::string& libsDir) : mLua(vfs, &mConfiguration), mI18n(vfs, &mLua)
+    namespace
+    {
+        // Action queue of the local scripts shard running on the current thread, null for the main Lua state.
+        thread_local std::vector<std::unique_ptr<Action>>* currentShardActionQueue = nullptr;
+
+        struct ShardActionQueueGuard
+        {
+            explicit ShardActionQueueGuard(std::vector<std::unique_ptr<Action>>* queue) { currentShardActionQueue = queue; }
+            ~ShardActionQueueGuard() { currentShardActionQueue = nullptr; }
+        };
+    }
+
+    LuaManager::LuaManager(const VFS::Manager* vfs, const std::string& libsDir)
+        : mVFS(vfs), mLibsDir(libsDir), mLua(vfs, &mConfiguration), mI18n(vfs, &mLua)
     {
         Log(Debug::Info) << "Lua version: " << LuaUtil::getLuaVersion();
         mLua.addInternalLibSearchPath(libsDir);
@@ -57,6 +75,7 @@ namespace MWLua
         context.mWorldView = &mWorldView;
         context.mLocalEventQueue = &mLocalEvents;
         context.mGlobalEventQueue = &mGlobalEvents;
+        context.mEventDataPool = &mEventDataPool;
         context.mSerializer = mGlobalSerializer.get();
 
         Context localContext = context;
@@ -91,10 +110,125 @@ namespace MWLua
         mLocalStoragePackage = initLocalStoragePackage(localContext, &mGlobalStorage);
         mPlayerStoragePackage = initPlayerStoragePackage(localContext, &mGlobalStorage, &mPlayerStorage);
 
+        auto mainShard = std::make_unique<LocalScriptsShard>();
+        mainShard->mLua = &mLua;
+        mainShard->mEventDataPool = &mEventDataPool;
+        mainShard->mNearbyPackage = mNearbyPackage;
+        mainShard->mSettingsPackage = mLocalSettingsPackage;
+        mainShard->mStoragePackage = mLocalStoragePackage;
+        mLocalScriptsShards.push_back(std::move(mainShard));
+        const int extraShards = std::max(0, Settings::Manager::getInt("lua local script shards", "Lua"));
+        for (int i = 0; i < extraShards; ++i)
+            mLocalScriptsShards.push_back(createLocalScriptsShard());
+        mLocalScriptsThreadPool = std::make_unique<Misc::ThreadPool>(extraShards);
+        if (extraShards > 0)
+            Log(Debug::Info) << "Local Lua scripts are split between " << mLocalScriptsShards.size() << " Lua states";
+
         initConfiguration();
         mInitialized = true;
     }
 
+    std::unique_ptr<LuaManager::LocalScriptsShard> LuaManager::createLocalScriptsShard()
+    {
+        auto shard = std::make_unique<LocalScriptsShard>();
+        shard->mOwnLua = std::make_unique<LuaUtil::LuaState>(mVFS, &mConfiguration);
+        shard->mLua = shard->mOwnLua.get();
+        shard->mEventDataPool = &shard->mOwnEventDataPool;
+        shard->mLua->addInternalLibSearchPath(mLibsDir);
+        shard->mOwnI18n = std::make_unique<LuaUtil::I18nManager>(mVFS, shard->mLua);
+        shard->mOwnI18n->init();
+        shard->mOwnI18n->setPreferredLanguages(mI18n.getPreferredLanguages());
+
+        // Same as in `init`, but everything sent by the scripts goes to the queues of the shard.
+        Context context;
+        context.mIsGlobal = true;
+        context.mLuaManager = this;
+        context.mLua = shard->mLua;
+        context.mI18n = shard->mOwnI18n.get();
+        context.mWorldView = &mWorldView;
+        context.mLocalEventQueue = &shard->mLocalEvents;
+        context.mGlobalEventQueue = &shard->mGlobalEvents;
+        context.mEventDataPool = shard->mEventDataPool;
+        context.mSerializer = mGlobalSerializer.get();
+
+        Context localContext = context;
+        localContext.mIsGlobal = false;
+        localContext.mSerializer = mLocalSerializer.get();
+
+        initObjectBindingsForLocalScripts(localContext);
+        initCellBindingsForLocalScripts(localContext);
+        LocalScripts::initializeSelfPackage(localContext);
+        LuaUtil::LuaStorage::initLuaBindings(shard->mLua->sol());
+
+        shard->mLua->addCommonPackage("openmw.async", getAsyncPackageInitializer(context));
+        shard->mLua->addCommonPackage("openmw.util", LuaUtil::initUtilPackage(shard->mLua->sol()));
+        shard->mLua->addCommonPackage("openmw.core", initCorePackage(context));
+        shard->mLua->addCommonPackage("openmw.query", initQueryPackage(context));
+        shard->mNearbyPackage = initNearbyPackage(localContext);
+        shard->mSettingsPackage = initGlobalSettingsPackage(localContext);
+        shard->mStoragePackage = initLocalStoragePackage(localContext, &mGlobalStorage);
+        return shard;
+    }
+
+    LuaManager::LocalScriptsShard& LuaManager::selectLocalScriptsShard(const MWWorld::Ptr& ptr, ESM::LuaScriptCfg::Flags flag)
+    {
+        // The player scripts use packages that exist only in the main Lua state.
+        if (mLocalScriptsShards.size() == 1 || flag == ESM::LuaScriptCfg::sPlayer)
+            return *mLocalScriptsShards.front();
+        const ObjectId id = getId(ptr);
+        const std::size_t hash = static_cast<std::size_t>(id.mIndex) + static_cast<std::uint32_t>(id.mContentFile) * 31u;
+        return *mLocalScriptsShards[1 + hash % (mLocalScriptsShards.size() - 1)];
+    }
+
+    LuaManager::LocalScriptsShard& LuaManager::getLocalScriptsShard(LocalScripts& scripts)
+    {
+        LuaUtil::LuaState* lua = &scripts.getLuaState();
+        for (const auto& shard : mLocalScriptsShards)
+            if (shard->mLua == lua)
+                return *shard;
+        throw std::logic_error("Local scripts don't belong to any shard");
+    }
+
+    void LuaManager::runLocalScripts(const std::function<void(LocalScriptsShard&)>& fn)
+    {
+        // Objects registered by the scripts get the same ids regardless of which thread ran them
+        ObjectRegistry* objectRegistry = mWorldView.getObjectRegistry();
+        const bool parallel = mLocalScriptsShards.size() > 1;
+        if (parallel)
+            objectRegistry->splitIntoShards(mLocalScriptsShards.size());
+        try
+        {
+            mLocalScriptsThreadPool->run(mLocalScriptsShards.size(), [&](std::size_t i)
+            {
+                LocalScriptsShard& shard = *mLocalScriptsShards[i];
+                ShardActionQueueGuard guard(i == 0 ? nullptr : &shard.mActionQueue);
+                ObjectRegistry::ShardGuard registryGuard(*objectRegistry, i);
+                fn(shard);
+            });
+        }
+        catch (...)
+        {
+            if (parallel)
+                objectRegistry->mergeShards();
+            throw;
+        }
+        if (parallel)
+            objectRegistry->mergeShards();
+    }
+
+    void LuaManager::mergeLocalScriptsShards()
+    {
+        for (const auto& shard : mLocalScriptsShards)
+        {
+            std::move(shard->mGlobalEvents.begin(), shard->mGlobalEvents.end(), std::back_inserter(mGlobalEvents));
+            std::move(shard->mLocalEvents.begin(), shard->mLocalEvents.end(), std::back_inserter(mLocalEvents));
+            std::move(shard->mActionQueue.begin(), shard->mActionQueue.end(), std::back_inserter(mActionQueue));
+            shard->mGlobalEvents.clear();
+            shard->mLocalEvents.clear();
+            shard->mActionQueue.clear();
+        }
+    }
+
     void LuaManager::loadPermanentStorage(const std::string& userConfigPath)
     {
         auto globalPath = std::filesystem::path(userConfigPath) / "global_storage.bin";
@@ -136,6 +270,12 @@ namespace MWLua
         mGlobalEvents = std::vector<GlobalEvent>();
         mLocalEvents = std::vector<LocalEvent>();
 
+        // Local scripts of different shards run in parallel, each shard gets its own part of the work.
+        for (const auto& shard : mLocalScriptsShards)
+            shard->mActiveScripts.clear();
+        for (LocalScripts* scripts : mActiveLocalScripts)
+            getLocalScriptsShard(*scripts).mActiveScripts.push_back(scripts);
+
         if (!mWorldView.isPaused())
         {  // Update time and process timers
             double simulationTime = mWorldView.getSimulationTime() + frameDuration;
@@ -143,23 +283,50 @@ namespace MWLua
             double gameTime = mWorldView.getGameTime();
 
             mGlobalScripts.processTimers(simulationTime, gameTime);
-            for (LocalScripts* scripts : mActiveLocalScripts)
-                scripts->processTimers(simulationTime, gameTime);
+            runLocalScripts([&](LocalScriptsShard& shard)
+            {
+                for (LocalScripts* scripts : shard.mActiveScripts)
+                    scripts->processTimers(simulationTime, gameTime);
+            });
         }
 
-        // Receive events
+        // Receive events. Buffers of the delivered events are reused for the events sent during this update. Events
+        // delivered to local scripts can come from any shard, so their buffers are released once all shards are done.
+        const auto eventsStart = std::chrono::steady_clock::now();
+        mEventStats.mCount = globalEvents.size() + localEvents.size();
+        mEventStats.mBytes = 0;
         for (GlobalEvent& e : globalEvents)
+        {
+            mEventStats.mBytes += e.mEventData.size();
             mGlobalScripts.receiveEvent(e.mEventName, e.mEventData);
+            releaseEventData(e);
+        }
         for (LocalEvent& e : localEvents)
         {
+            mEventStats.mBytes += e.mEventData.size();
             LObject obj(e.mDest, objectRegistry);
             LocalScripts* scripts = obj.isValid() ? obj.ptr().getRefData().getLuaScripts() : nullptr;
             if (scripts)
-                scripts->receiveEvent(e.mEventName, e.mEventData);
+                getLocalScriptsShard(*scripts).mEvents.emplace_back(scripts, std::move(e));
             else
+            {
                 Log(Debug::Debug) << "Ignored event " << e.mEventName << " to L" << idToString(e.mDest)
                                   << ". Object not found or has no attached scripts";
+                releaseEventData(e);
+            }
+        }
+        runLocalScripts([](LocalScriptsShard& shard)
+        {
+            for (auto& [scripts, e] : shard.mEvents)
+                scripts->receiveEvent(e.mEventName, e.mEventData);
+        });
+        for (const auto& shard : mLocalScriptsShards)
+        {
+            for (auto& [scripts, e] : shard->mEvents)
+                releaseEventData(e);
+            shard->mEvents.clear();
         }
+        mEventStats.mTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - eventsStart).count();
 
         // Run queued callbacks
         for (CallbackWithData& c : mQueuedCallbacks)
@@ -167,7 +334,7 @@ namespace MWLua
         mQueuedCallbacks.clear();
 
         // Engine handlers in local scripts
-        for (const LocalEngineEvent& e : mLocalEngineEvents)
+        for (LocalEngineEvent& e : mLocalEngineEvents)
         {
             LObject obj(e.mDest, objectRegistry);
             if (!obj.isValid())
@@ -177,15 +344,22 @@ namespace MWLua
             }
             LocalScripts* scripts = obj.ptr().getRefData().getLuaScripts();
             if (scripts)
-                scripts->receiveEngineEvent(e.mEvent);
+                getLocalScriptsShard(*scripts).mEngineEvents.emplace_back(scripts, std::move(e.mEvent));
         }
         mLocalEngineEvents.clear();
 
-        if (!mWorldView.isPaused())
+        const bool paused = mWorldView.isPaused();
+        runLocalScripts([&](LocalScriptsShard& shard)
         {
-            for (LocalScripts* scripts : mActiveLocalScripts)
-                scripts->update(frameDuration);
-        }
+            for (const auto& [scripts, event] : shard.mEngineEvents)
+                scripts->receiveEngineEvent(event);
+            shard.mEngineEvents.clear();
+            if (!paused)
+            {
+                for (LocalScripts* scripts : shard.mActiveScripts)
+                    scripts->update(frameDuration);
+            }
+        });
 
         // Engine handlers in global scripts
         if (mPlayerChanged)
@@ -213,11 +387,22 @@ namespace MWLua
             mGlobalScripts.update(frameDuration);
     }
 
+    void LuaManager::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute(frameNumber, "Lua Events", mEventStats.mCount);
+        stats.setAttribute(frameNumber, "Lua Event Bytes", mEventStats.mBytes);
+        stats.setAttribute(frameNumber, "Lua Event Time", mEventStats.mTime * 1000.0);
+    }
+
     void LuaManager::synchronizedUpdate()
     {
         if (mPlayer.isEmpty())
             return;  // The game is not started yet.
 
+        // Everything sent by the local scripts during the last `update` is passed on in the same order regardless of
+        // which thread ran them.
+        mergeLocalScriptsShards();
+
         // We apply input events in `synchronizedUpdate` rather than in `update` in order to reduce input latency.
         PlayerScripts* playerScripts = dynamic_cast<PlayerScripts*>(mPlayer.getRefData().getLuaScripts());
         if (playerScripts && !MWBase::Environment::get().getWindowManager()->containsMode(MWGui::GM_MainMenu))
@@ -243,10 +428,27 @@ namespace MWLua
         mTeleportPlayerAction.reset();
     }
 
+    void LuaManager::addAction(std::unique_ptr<Action>&& action)
+    {
+        if (currentShardActionQueue)
+            currentShardActionQueue->push_back(std::move(action));
+        else
+            mActionQueue.push_back(std::move(action));
+    }
+
     void LuaManager::clear()
     {
         LuaUi::clearUserInterface();
         mActiveLocalScripts.clear();
+        for (const auto& shard : mLocalScriptsShards)
+        {
+            shard->mActiveScripts.clear();
+            shard->mEvents.clear();
+            shard->mEngineEvents.clear();
+            shard->mGlobalEvents.clear();
+            shard->mLocalEvents.clear();
+            shard->mActionQueue.clear();
+        }
         mLocalEvents.clear();
         mGlobalEvents.clear();
         mInputEvents.clear();
@@ -383,6 +585,7 @@ namespace MWLua
         assert(mInitialized);
         assert(flag != ESM::LuaScriptCfg::sGlobal);
         std::shared_ptr<LocalScripts> scripts;
+        LocalScriptsShard& shard = selectLocalScriptsShard(ptr, flag);
         if (flag == ESM::LuaScriptCfg::sPlayer)
         {
             assert(ptr.getCellRef().getRefId() == "player");
@@ -395,11 +598,11 @@ namespace MWLua
         }
         else
         {
-            scripts = std::make_shared<LocalScripts>(&mLua, LObject(getId(ptr), mWorldView.getObjectRegistry()), flag);
-            scripts->addPackage("openmw.settings", mLocalSettingsPackage);
-            scripts->addPackage("openmw.storage", mLocalStoragePackage);
+            scripts = std::make_shared<LocalScripts>(shard.mLua, LObject(getId(ptr), mWorldView.getObjectRegistry()), flag);
+            scripts->addPackage("openmw.settings", shard.mSettingsPackage);
+            scripts->addPackage("openmw.storage", shard.mStoragePackage);
         }
-        scripts->addPackage("openmw.nearby", mNearbyPackage);
+        scripts->addPackage("openmw.nearby", shard.mNearbyPackage);
         scripts->setSerializer(mLocalSerializer.get());
 
         MWWorld::RefData& refData = ptr.getRefData();
@@ -415,6 +618,7 @@ namespace MWLua
         ESM::LuaScripts globalScripts;
         mGlobalScripts.save(globalScripts);
         globalScripts.save(writer);
+        mergeLocalScriptsShards();
         saveEvents(writer, mGlobalEvents, mLocalEvents);
 
         writer.endRecord(ESM::REC_LUAM);
@@ -469,7 +673,8 @@ namespace MWLua
         Log(Debug::Info) << "Reload Lua";
 
         LuaUi::clearUserInterface(); 
-        mLua.dropScriptCache();
+        for (const auto& shard : mLocalScriptsShards)
+            shard->mLua->dropScriptCache();
         initConfiguration();
 
         {  // Reload global scripts
@@ -7,6 +7,7 @@
 #include <components/lua/i18n.hpp>
 #include <components/lua/luastate.hpp>
 #include <components/lua/storage.hpp>
+#include <components/misc/threadpool.hpp>
 
 #include "../mwbase/luamanager.hpp"
 
@@ -18,6 +19,11 @@
 #include "playerscripts.hpp"
 #include "worldview.hpp"
 
+namespace osg
+{
+    class Stats;
+}
+
 namespace MWLua
 {
 
@@ -39,6 +45,9 @@ namespace MWLua
         // Called by engine.cpp from the main thread. Can use scene graph.
         void synchronizedUpdate();
 
+        // Called by engine.cpp after `update`, from the same thread.
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
         // Available everywhere through the MWBase::LuaManager interface.
         // LuaManager queues these events and propagates to scripts on the next `update` call.
         void newGameStarted() override;
@@ -58,7 +67,7 @@ namespace MWLua
 
         // Used only in Lua bindings
         void addCustomLocalScript(const MWWorld::Ptr&, int scriptId);
-        void addAction(std::unique_ptr<Action>&& action) { mActionQueue.push_back(std::move(action)); }
+        void addAction(std::unique_ptr<Action>&& action);
         void addTeleportPlayerAction(std::unique_ptr<TeleportAction>&& action) { mTeleportPlayerAction = std::move(action); }
         void addUIMessage(std::string_view message) { mUIMessages.emplace_back(message); }
 
@@ -93,6 +102,8 @@ namespace MWLua
         void initConfiguration();
         LocalScripts* createLocalScripts(const MWWorld::Ptr& ptr, ESM::LuaScriptCfg::Flags);
 
+        const VFS::Manager* mVFS;
+        const std::string mLibsDir;
         bool mInitialized = false;
         bool mGlobalScriptsStarted = false;
         LuaUtil::ScriptsConfiguration mConfiguration;
@@ -117,6 +128,16 @@ namespace MWLua
 
         GlobalEventQueue mGlobalEvents;
         LocalEventQueue mLocalEvents;
+        EventDataPool mEventDataPool;
+
+        // Delivery of the events in the last `update`
+        struct EventStats
+        {
+            std::size_t mCount = 0;
+            std::size_t mBytes = 0;
+            double mTime = 0;
+        };
+        EventStats mEventStats;
 
         std::unique_ptr<LuaUtil::UserdataSerializer> mGlobalSerializer;
         std::unique_ptr<LuaUtil::UserdataSerializer> mLocalSerializer;
@@ -142,6 +163,41 @@ namespace MWLua
         };
         std::vector<LocalEngineEvent> mLocalEngineEvents;
 
+        // Local scripts of a part of the objects. The first shard uses the main Lua state together with the global
+        // and the player scripts, the others have Lua states of their own and run in parallel with it. Everything the
+        // scripts of a shard send to the rest of the game is queued in the shard and merged in shard order by
+        // `synchronizedUpdate`. While the shards run, bindings of local scripts only read the game world, except for
+        // the object registry and the cells (see ObjectRegistry::ShardGuard and WorldView::findCell) and custom data
+        // of objects (see WorldView::lockObjectData), which are guarded.
+        struct LocalScriptsShard
+        {
+            std::unique_ptr<LuaUtil::LuaState> mOwnLua;
+            std::unique_ptr<LuaUtil::I18nManager> mOwnI18n;
+            EventDataPool mOwnEventDataPool;
+            LuaUtil::LuaState* mLua;
+            EventDataPool* mEventDataPool;
+            sol::table mNearbyPackage;
+            sol::table mSettingsPackage;
+            sol::table mStoragePackage;
+
+            // Work for the current frame
+            std::vector<LocalScripts*> mActiveScripts;
+            std::vector<std::pair<LocalScripts*, LocalEvent>> mEvents;
+            std::vector<std::pair<LocalScripts*, LocalScripts::EngineEvent>> mEngineEvents;
+
+            GlobalEventQueue mGlobalEvents;
+            LocalEventQueue mLocalEvents;
+            std::vector<std::unique_ptr<Action>> mActionQueue;
+        };
+        std::vector<std::unique_ptr<LocalScriptsShard>> mLocalScriptsShards;
+        std::unique_ptr<Misc::ThreadPool> mLocalScriptsThreadPool;
+
+        std::unique_ptr<LocalScriptsShard> createLocalScriptsShard();
+        LocalScriptsShard& selectLocalScriptsShard(const MWWorld::Ptr& ptr, ESM::LuaScriptCfg::Flags flag);
+        LocalScriptsShard& getLocalScriptsShard(LocalScripts& scripts);
+        void runLocalScripts(const std::function<void(LocalScriptsShard&)>& fn);
+        void mergeLocalScriptsShards();
+
         // Queued actions that should be done in main thread. Processed by applyQueuedChanges().
         std::vector<std::unique_ptr<Action>> mActionQueue;
         std::unique_ptr<TeleportAction> mTeleportPlayerAction;
@@ -1,5 +1,7 @@
 #include "object.hpp"
 
+#include <algorithm>
+#include <cassert>
 #include <unordered_map>
 
 namespace MWLua
@@ -128,6 +130,7 @@ namespace MWLua
     void ObjectRegistry::clear()
     {
         mObjectMapping.clear();
+        mAliases.clear();
         mChanged = false;
         mUpdateCounter = 0;
         mLastAssignedId.unset();
@@ -136,9 +139,19 @@ namespace MWLua
     MWWorld::Ptr ObjectRegistry::getPtr(ObjectId id, bool local)
     {
         MWWorld::Ptr ptr;
-        auto it = mObjectMapping.find(id);
-        if (it != mObjectMapping.end())
-            ptr = it->second;
+        if (sCurrentShard != nullptr)
+        {
+            auto it = sCurrentShard->mObjectMapping.find(id);
+            if (it != sCurrentShard->mObjectMapping.end())
+                ptr = it->second;
+        }
+        if (ptr.isEmpty())
+        {
+            auto alias = mAliases.find(id);
+            auto it = mObjectMapping.find(alias != mAliases.end() ? alias->second : id);
+            if (it != mObjectMapping.end())
+                ptr = it->second;
+        }
         if (local)
         {
             // TODO: Return ptr only if it is active or was active in the previous frame, otherwise return empty.
@@ -153,12 +166,95 @@ namespace MWLua
 
     ObjectId ObjectRegistry::registerPtr(const MWWorld::Ptr& ptr)
     {
+        if (sCurrentShard != nullptr)
+            return registerPtr(*sCurrentShard, ptr);
         ObjectId id = ptr.getCellRef().getOrAssignRefNum(mLastAssignedId);
         mChanged = true;
         mObjectMapping[id] = ptr;
         return id;
     }
 
+    ObjectId ObjectRegistry::registerPtr(Shard& shard, const MWWorld::Ptr& ptr)
+    {
+        // Other shards can register the same object at the same time, so neither the object nor the registry
+        // are changed here.
+        ObjectId id;
+        if (ptr.getCellRef().getRefNum().isSet())
+        {
+            id = ptr.getCellRef().getRefNum();
+            auto it = mObjectMapping.find(id);
+            if (it != mObjectMapping.end() && it->second.getBase() == ptr.getBase())
+                return id;
+        }
+        else
+        {
+            auto [generated, inserted] = shard.mGeneratedIds.emplace(ptr.getBase(), ObjectId());
+            if (inserted)
+                generated->second = shard.mIdGenerator.next();
+            id = generated->second;
+        }
+        auto it = shard.mObjectMapping.find(id);
+        if (it != shard.mObjectMapping.end() && it->second.getBase() == ptr.getBase())
+            return id;
+        shard.mObjectMapping[id] = ptr;
+        shard.mRegistered.emplace_back(id, ptr);
+        return id;
+    }
+
+    ObjectId ObjectRegistry::getRegisteredId(const MWWorld::Ptr& ptr) const
+    {
+        if (sCurrentShard != nullptr && !ptr.getCellRef().getRefNum().isSet())
+        {
+            auto it = sCurrentShard->mGeneratedIds.find(ptr.getBase());
+            if (it != sCurrentShard->mGeneratedIds.end())
+                return it->second;
+        }
+        return getId(ptr);
+    }
+
+    void ObjectRegistry::splitIntoShards(std::size_t count)
+    {
+        assert(mShards.empty());
+        mShards.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+            mShards.push_back(Shard {ShardIdGenerator(mLastAssignedId, i, count), {}, {}, {}});
+    }
+
+    void ObjectRegistry::mergeShards()
+    {
+        std::uint32_t maxGenerated = 0;
+        for (Shard& shard : mShards)
+        {
+            for (const auto& [id, ptr] : shard.mRegistered)
+            {
+                MWWorld::CellRef& cellRef = ptr.getCellRef();
+                if (!cellRef.getRefNum().isSet())
+                    cellRef.setRefNum(id);
+                if (cellRef.getRefNum() == id)
+                    mObjectMapping[id] = ptr;
+                else  // An earlier shard generated an id for the same object
+                    mAliases[id] = cellRef.getRefNum();
+                mChanged = true;
+            }
+            maxGenerated = std::max(maxGenerated, shard.mIdGenerator.getCount());
+        }
+        mLastAssignedId = ShardIdGenerator::getLastAssigned(mLastAssignedId, mShards.size(), maxGenerated);
+        mShards.clear();
+    }
+
+    thread_local ObjectRegistry::Shard* ObjectRegistry::sCurrentShard = nullptr;
+
+    ObjectRegistry::ShardGuard::ShardGuard(ObjectRegistry& registry, std::size_t index)
+    {
+        if (!registry.mShards.empty())
+            sCurrentShard = &registry.mShards[index];
+    }
+
+    ObjectRegistry::ShardGuard::~ShardGuard()
+    {
+        sCurrentShard = nullptr;
+    }
+
     ObjectId ObjectRegistry::deregisterPtr(const MWWorld::Ptr& ptr)
     {
         ObjectId id = getId(ptr);
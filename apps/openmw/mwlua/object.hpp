@@ -1,7 +1,9 @@
 #ifndef MWLUA_OBJECT_H
 #define MWLUA_OBJECT_H
 
+#include <map>
 #include <typeindex>
+#include <vector>
 
 #include <components/esm3/cellref.hpp>
 #include <components/esm/defs.hpp>
@@ -12,6 +14,8 @@
 
 #include "../mwworld/ptr.hpp"
 
+#include "shardidgenerator.hpp"
+
 namespace MWLua
 {
     namespace ObjectTypeName
@@ -65,6 +69,9 @@ namespace MWLua
         ObjectId registerPtr(const MWWorld::Ptr& ptr);
         ObjectId deregisterPtr(const MWWorld::Ptr& ptr);
 
+        // Id of a registered object. Unlike `getId(ptr)` it includes ids generated by the current shard.
+        ObjectId getRegisteredId(const MWWorld::Ptr& ptr) const;
+
         // Returns Ptr by id. If object is not found, returns empty Ptr.
         // If local = true, returns non-empty ptr only if it can be used in local scripts
         // (i.e. is active or was active in the previous frame).
@@ -74,14 +81,46 @@ namespace MWLua
         const ObjectId& getLastAssignedId() const { return mLastAssignedId; }
         void setLastAssignedId(ObjectId id) { mLastAssignedId = id; }
 
+        // Used while local scripts run in several shards at once. Until `mergeShards` is called, `registerPtr` and
+        // `getPtr` called in a shard (see `ShardGuard`) don't modify anything shared: a shard sees the registry as it
+        // was before plus the objects it registered itself, and takes new ids from its own ShardIdGenerator.
+        // `mergeShards` applies the registrations in shard order.
+        void splitIntoShards(std::size_t count);
+        void mergeShards();
+
+        // Makes `registerPtr` and `getPtr` on the current thread use the given shard, if the registry is split.
+        class ShardGuard
+        {
+        public:
+            ShardGuard(ObjectRegistry& registry, std::size_t index);
+            ~ShardGuard();
+        };
+
     private:
         friend class Object;
         friend class LuaManager;
 
+        struct Shard
+        {
+            ShardIdGenerator mIdGenerator;
+            std::vector<std::pair<ObjectId, MWWorld::Ptr>> mRegistered;
+            std::map<ObjectId, MWWorld::Ptr> mObjectMapping;
+            std::map<const MWWorld::LiveCellRefBase*, ObjectId> mGeneratedIds;
+        };
+
+        ObjectId registerPtr(Shard& shard, const MWWorld::Ptr& ptr);
+
+        static thread_local Shard* sCurrentShard;
+
         bool mChanged = false;
         int64_t mUpdateCounter = 0;
         std::map<ObjectId, MWWorld::Ptr> mObjectMapping;
         ObjectId mLastAssignedId;
+        std::vector<Shard> mShards;
+
+        // Ids generated for the same object by several shards in the same frame. All but the one of the first
+        // shard refer to it through this mapping.
+        std::map<ObjectId, ObjectId> mAliases;
     };
 
     // Lua scripts can't use MWWorld::Ptr directly, because lifetime of a script can be longer than lifetime of Ptr.
@@ -119,21 +119,26 @@ namespace MWLua
         objectT[sol::meta_function::to_string] = &ObjectT::toString;
         objectT["sendEvent"] = [context](const ObjectT& dest, std::string eventName, const sol::object& eventData)
         {
-            context.mLocalEventQueue->push_back({dest.id(), std::move(eventName), LuaUtil::serialize(eventData, context.mSerializer)});
+            std::string data = context.mEventDataPool->take();
+            LuaUtil::serialize(data, eventData, context.mSerializer);
+            context.mLocalEventQueue->push_back({dest.id(), std::move(eventName), std::move(data), context.mEventDataPool});
         };
 
-        objectT["canMove"] = [](const ObjectT& o)
+        objectT["canMove"] = [worldView=context.mWorldView](const ObjectT& o)
         {
+            const auto lock = worldView->lockObjectData();
             const MWWorld::Class& cls = o.ptr().getClass();
             return cls.getMaxSpeed(o.ptr()) > 0;
         };
-        objectT["getRunSpeed"] = [](const ObjectT& o)
+        objectT["getRunSpeed"] = [worldView=context.mWorldView](const ObjectT& o)
         {
+            const auto lock = worldView->lockObjectData();
             const MWWorld::Class& cls = o.ptr().getClass();
             return cls.getRunSpeed(o.ptr());
         };
-        objectT["getWalkSpeed"] = [](const ObjectT& o)
+        objectT["getWalkSpeed"] = [worldView=context.mWorldView](const ObjectT& o)
         {
+            const auto lock = worldView->lockObjectData();
             const MWWorld::Class& cls = o.ptr().getClass();
             return cls.getWalkSpeed(o.ptr());
         };
@@ -201,26 +206,31 @@ namespace MWLua
         }
         else
         {  // Only for local scripts
-            objectT["isOnGround"] = [](const ObjectT& o)
+            objectT["isOnGround"] = [worldView=context.mWorldView](const ObjectT& o)
             {
+                const auto lock = worldView->lockObjectData();
                 return MWBase::Environment::get().getWorld()->isOnGround(o.ptr());
             };
-            objectT["isSwimming"] = [](const ObjectT& o)
+            objectT["isSwimming"] = [worldView=context.mWorldView](const ObjectT& o)
             {
+                const auto lock = worldView->lockObjectData();
                 return MWBase::Environment::get().getWorld()->isSwimming(o.ptr());
             };
-            objectT["isInWeaponStance"] = [](const ObjectT& o)
+            objectT["isInWeaponStance"] = [worldView=context.mWorldView](const ObjectT& o)
             {
+                const auto lock = worldView->lockObjectData();
                 const MWWorld::Class& cls = o.ptr().getClass();
                 return cls.isActor() && cls.getCreatureStats(o.ptr()).getDrawState() == MWMechanics::DrawState_Weapon;
             };
-            objectT["isInMagicStance"] = [](const ObjectT& o)
+            objectT["isInMagicStance"] = [worldView=context.mWorldView](const ObjectT& o)
             {
+                const auto lock = worldView->lockObjectData();
                 const MWWorld::Class& cls = o.ptr().getClass();
                 return cls.isActor() && cls.getCreatureStats(o.ptr()).getDrawState() == MWMechanics::DrawState_Spell;
             };
-            objectT["getCurrentSpeed"] = [](const ObjectT& o)
+            objectT["getCurrentSpeed"] = [worldView=context.mWorldView](const ObjectT& o)
             {
+                const auto lock = worldView->lockObjectData();
                 const MWWorld::Class& cls = o.ptr().getClass();
                 return cls.getCurrentSpeed(o.ptr());
             };
@@ -285,22 +295,24 @@ namespace MWLua
             if (!ptr.getClass().hasInventoryStore(ptr))
                 return equipment;
 
+            const auto lock = context.mWorldView->lockObjectData();
             MWWorld::InventoryStore& store = ptr.getClass().getInventoryStore(ptr);
             for (int slot = 0; slot < MWWorld::InventoryStore::Slots; ++slot)
             {
                 auto it = store.getSlot(slot);
                 if (it == store.end())
                     continue;
-                context.mWorldView->getObjectRegistry()->registerPtr(*it);
-                equipment[slot] = ObjectT(getId(*it), context.mWorldView->getObjectRegistry());
+                ObjectRegistry* registry = context.mWorldView->getObjectRegistry();
+                equipment[slot] = ObjectT(registry->registerPtr(*it), registry);
             }
             return equipment;
         };
-        objectT["isEquipped"] = [](const ObjectT& actor, const ObjectT& item)
+        objectT["isEquipped"] = [worldView=context.mWorldView](const ObjectT& actor, const ObjectT& item)
         {
             const MWWorld::Ptr& ptr = actor.ptr();
             if (!ptr.getClass().hasInventoryStore(ptr))
                 return false;
+            const auto lock = worldView->lockObjectData();
             MWWorld::InventoryStore& store = ptr.getClass().getInventoryStore(ptr);
             return store.isEquipped(item.ptr());
         };
@@ -342,21 +354,22 @@ namespace MWLua
                 throw std::runtime_error(std::string("inventory:getAll doesn't support type " + std::string(*type)));
 
             const MWWorld::Ptr& ptr = inventory.mObj.ptr();
+            const auto lock = worldView->lockObjectData();
             MWWorld::ContainerStore& store = ptr.getClass().getContainerStore(ptr);
             ObjectIdList list = std::make_shared<std::vector<ObjectId>>();
             auto it = store.begin(mask);
             while (it.getType() != -1)
             {
                 const MWWorld::Ptr& item = *(it++);
-                worldView->getObjectRegistry()->registerPtr(item);
-                list->push_back(getId(item));
+                list->push_back(worldView->getObjectRegistry()->registerPtr(item));
             }
             return ObjectList<ObjectT>{list};
         };
 
-        inventoryT["countOf"] = [](const InventoryT& inventory, const std::string& recordId)
+        inventoryT["countOf"] = [worldView=context.mWorldView](const InventoryT& inventory, const std::string& recordId)
         {
             const MWWorld::Ptr& ptr = inventory.mObj.ptr();
+            const auto lock = worldView->lockObjectData();
             MWWorld::ContainerStore& store = ptr.getClass().getContainerStore(ptr);
             return store.count(recordId);
         };
@@ -1,5 +1,11 @@
 #include "query.hpp"
 
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
 #include <sol/sol.hpp>
 
 #include <components/lua/luastate.hpp>
@@ -48,122 +54,322 @@ namespace MWLua
         return fieldGroups;
     }
 
-    bool checkQueryConditions(const Queries::Query& query, const ObjectId& id, const Context& context)
+namespace
+{
+    // Called for each candidate object, so fields are read from the Ptr directly instead of through the Lua bindings
+    using QueryPredicate = std::function<bool(const MWWorld::Ptr&, const Context&)>;
+
+    template <class Getter, class T>
+    QueryPredicate makeQueryComparison(Getter getter, T value, Queries::Condition::Type type)
     {
-        auto compareFn = [](auto&& a, auto&& b, Queries::Condition::Type t)
+        auto make = [&](auto compare) -> QueryPredicate
         {
-            switch (t)
+            return [getter, value, compare](const MWWorld::Ptr& ptr, const Context& context)
             {
-                case Queries::Condition::EQUAL: return a == b;
-                case Queries::Condition::NOT_EQUAL: return a != b;
-                case Queries::Condition::GREATER: return a > b;
-                case Queries::Condition::GREATER_OR_EQUAL: return a >= b;
-                case Queries::Condition::LESSER: return a < b;
-                case Queries::Condition::LESSER_OR_EQUAL: return a <= b;
-                default:
-                    throw std::runtime_error("Unsupported condition type");
-            }
+                const auto fieldValue = getter(ptr, context);
+                return fieldValue.has_value() && compare(*fieldValue, value);
+            };
         };
-        sol::object obj;
-        MWWorld::Ptr ptr;
-        if (context.mIsGlobal)
+        switch (type)
         {
-            GObject g(id, context.mWorldView->getObjectRegistry());
-            if (!g.isValid())
-                return false;
-            ptr = g.ptr();
-            obj = sol::make_object(context.mLua->sol(), g);
+            case Queries::Condition::EQUAL: return make(std::equal_to<>());
+            case Queries::Condition::NOT_EQUAL: return make(std::not_equal_to<>());
+            case Queries::Condition::GREATER: return make(std::greater<>());
+            case Queries::Condition::GREATER_OR_EQUAL: return make(std::greater_equal<>());
+            case Queries::Condition::LESSER: return make(std::less<>());
+            case Queries::Condition::LESSER_OR_EQUAL: return make(std::less_equal<>());
+            default:
+                throw std::runtime_error("Unsupported condition type");
         }
-        else
+    }
+
+    MWWorld::CellStore* getDoorDestCell(const MWWorld::Ptr& ptr, const Context& context)
+    {
+        if (ptr.getType() != ESM::REC_DOOR || !ptr.getCellRef().getTeleport())
+            return nullptr;
+        const MWWorld::CellRef& cellRef = ptr.getCellRef();
+        return context.mWorldView->findCell(cellRef.getDestCell(), cellRef.getDoorDest().asVec3());
+    }
+
+    template <class GetCell>
+    QueryPredicate makeQueryCellComparison(GetCell getCell, std::string_view field, const Queries::Condition& cond)
+    {
+        if (field == "name")
+            return makeQueryComparison([getCell](const MWWorld::Ptr& ptr, const Context& context)
+            {
+                const MWWorld::CellStore* cell = getCell(ptr, context);
+                return cell ? std::optional<std::string_view>(cell->getCell()->mName) : std::nullopt;
+            }, std::get<std::string>(cond.mValue), cond.mType);
+        if (field == "region")
+            return makeQueryComparison([getCell](const MWWorld::Ptr& ptr, const Context& context)
+            {
+                const MWWorld::CellStore* cell = getCell(ptr, context);
+                return cell ? std::optional<std::string_view>(cell->getCell()->mRegion) : std::nullopt;
+            }, std::get<std::string>(cond.mValue), cond.mType);
+        if (field == "isExterior")
+            return makeQueryComparison([getCell](const MWWorld::Ptr& ptr, const Context& context)
+            {
+                const MWWorld::CellStore* cell = getCell(ptr, context);
+                return cell ? std::optional<bool>(cell->isExterior()) : std::nullopt;
+            }, std::get<bool>(cond.mValue), cond.mType);
+        return nullptr;
+    }
+
+    // Fields registered in getBasicQueryFieldGroups, mirroring the object bindings. Returns nullptr for other fields.
+    QueryPredicate makeNativeQueryCondition(const Queries::Condition& cond)
+    {
+        const std::vector<std::string>& path = cond.mField->path();
+        if (path.size() == 1)
         {
-            LObject l(id, context.mWorldView->getObjectRegistry());
-            if (!l.isValid())
-                return false;
-            ptr = l.ptr();
-            obj = sol::make_object(context.mLua->sol(), l);
+            if (path[0] == "type")
+                return makeQueryComparison([](const MWWorld::Ptr& ptr, const Context&)
+                {
+                    return std::optional<std::string_view>(getLuaObjectTypeName(ptr));
+                }, std::get<std::string>(cond.mValue), cond.mType);
+            if (path[0] == "recordId")
+                return makeQueryComparison([](const MWWorld::Ptr& ptr, const Context&)
+                {
+                    return std::optional<std::string_view>(ptr.getCellRef().getRefId());
+                }, std::get<std::string>(cond.mValue), cond.mType);
+            if (path[0] == "count")
+                return makeQueryComparison([](const MWWorld::Ptr& ptr, const Context&)
+                {
+                    return std::optional<int32_t>(ptr.getRefData().getCount());
+                }, std::get<int32_t>(cond.mValue), cond.mType);
+            if (path[0] == "isTeleport")
+                return makeQueryComparison([](const MWWorld::Ptr& ptr, const Context&)
+                {
+                    if (ptr.getType() != ESM::REC_DOOR)
+                        return std::optional<bool>();
+                    return std::optional<bool>(ptr.getCellRef().getTeleport());
+                }, std::get<bool>(cond.mValue), cond.mType);
         }
-        if (ptr.getRefData().getCount() == 0)
-            return false;
-
-        // It is important to exclude all markers before checking what class it is.
-        // For example "prisonmarker" has class "Door" despite that it is only an invisible marker.
-        if (isMarker(ptr))
-            return false;
-
-        const MWWorld::Class& cls = ptr.getClass();
-        if (cls.isActivator() != (query.mQueryType == ObjectQueryTypes::ACTIVATORS))
-            return false;
-        if (cls.isActor() != (query.mQueryType == ObjectQueryTypes::ACTORS))
-            return false;
-        if (cls.isDoor() != (query.mQueryType == ObjectQueryTypes::DOORS))
-            return false;
-        if ((typeid(cls) == typeid(MWClass::Container)) != (query.mQueryType == ObjectQueryTypes::CONTAINERS))
-            return false;
-
-        std::vector<char> condStack;
-        for (const Queries::Operation& op : query.mFilter.mOperations)
+        else if (path.size() == 2 && path[0] == "cell")
         {
-            switch(op.mType)
+            return makeQueryCellComparison([](const MWWorld::Ptr& ptr, const Context&)
             {
-                case Queries::Operation::PUSH:
-                {
-                    const Queries::Condition& cond = query.mFilter.mConditions[op.mConditionIndex];
-                    sol::object fieldObj = obj;
-                    for (const std::string& field : cond.mField->path())
-                        fieldObj = LuaUtil::getFieldOrNil(fieldObj, field);
-                    bool c;
-                    if (fieldObj == sol::nil)
-                        c = false;
-                    else if (cond.mField->type() == typeid(std::string))
-                        c = compareFn(fieldObj.as<std::string_view>(), std::get<std::string>(cond.mValue), cond.mType);
-                    else if (cond.mField->type() == typeid(float))
-                        c = compareFn(fieldObj.as<float>(), std::get<float>(cond.mValue), cond.mType);
-                    else if (cond.mField->type() == typeid(double))
-                        c = compareFn(fieldObj.as<double>(), std::get<double>(cond.mValue), cond.mType);
-                    else if (cond.mField->type() == typeid(bool))
-                        c = compareFn(fieldObj.as<bool>(), std::get<bool>(cond.mValue), cond.mType);
-                    else if (cond.mField->type() == typeid(int32_t))
-                        c = compareFn(fieldObj.as<int32_t>(), std::get<int32_t>(cond.mValue), cond.mType);
-                    else if (cond.mField->type() == typeid(int64_t))
-                        c = compareFn(fieldObj.as<int64_t>(), std::get<int64_t>(cond.mValue), cond.mType);
-                    else
-                        throw std::runtime_error("Unknown field type");
-                    condStack.push_back(c);
-                    break;
-                }
-                case Queries::Operation::NOT:
-                    condStack.back() = !condStack.back();
-                    break;
-                case Queries::Operation::AND:
-                {
-                    bool v = condStack.back();
-                    condStack.pop_back();
-                    condStack.back() = condStack.back() && v;
-                    break;
-                }
-                case Queries::Operation::OR:
+                return ptr.isInCell() ? ptr.getCell() : nullptr;
+            }, path[1], cond);
+        }
+        else if (path.size() == 2 && path[0] == "destCell")
+            return makeQueryCellComparison(&getDoorDestCell, path[1], cond);
+        return nullptr;
+    }
+
+    // Other fields are read through the Lua bindings, like a script would do it
+    QueryPredicate makeLuaQueryCondition(const Queries::Condition& cond)
+    {
+        auto readField = [field = cond.mField](const MWWorld::Ptr& ptr, const Context& context)
+        {
+            sol::object fieldObj;
+            ObjectRegistry* registry = context.mWorldView->getObjectRegistry();
+            if (context.mIsGlobal)
+                fieldObj = sol::make_object(context.mLua->sol(), GObject(registry->getRegisteredId(ptr), registry));
+            else
+                fieldObj = sol::make_object(context.mLua->sol(), LObject(registry->getRegisteredId(ptr), registry));
+            for (const std::string& name : field->path())
+                fieldObj = LuaUtil::getFieldOrNil(fieldObj, name);
+            return fieldObj;
+        };
+        auto makeGetter = [&](auto type)
+        {
+            using T = decltype(type);
+            return [readField](const MWWorld::Ptr& ptr, const Context& context) -> std::optional<T>
+            {
+                const sol::object fieldObj = readField(ptr, context);
+                if (fieldObj == sol::nil)
+                    return std::nullopt;
+                return fieldObj.as<T>();
+            };
+        };
+        const std::type_index type = cond.mField->type();
+        if (type == typeid(std::string))
+            return makeQueryComparison(makeGetter(std::string()), std::get<std::string>(cond.mValue), cond.mType);
+        else if (type == typeid(float))
+            return makeQueryComparison(makeGetter(float()), std::get<float>(cond.mValue), cond.mType);
+        else if (type == typeid(double))
+            return makeQueryComparison(makeGetter(double()), std::get<double>(cond.mValue), cond.mType);
+        else if (type == typeid(bool))
+            return makeQueryComparison(makeGetter(bool()), std::get<bool>(cond.mValue), cond.mType);
+        else if (type == typeid(int32_t))
+            return makeQueryComparison(makeGetter(int32_t()), std::get<int32_t>(cond.mValue), cond.mType);
+        else if (type == typeid(int64_t))
+            return makeQueryComparison(makeGetter(int64_t()), std::get<int64_t>(cond.mValue), cond.mType);
+        else
+            throw std::runtime_error("Unknown field type");
+    }
+
+    bool isSameQueryCondition(const Queries::Condition& a, const Queries::Condition& b)
+    {
+        return a.mField == b.mField && a.mType == b.mType && a.mValue == b.mValue;
+    }
+
+    // A query compiled into a single predicate. The operations in reverse polish notation become nested closures
+    // that short circuit, so no stack is needed to evaluate them.
+    class QueryPlan
+    {
+    public:
+        explicit QueryPlan(const Queries::Query& query)
+            : mQueryType(query.mQueryType)
+            , mFilter(query.mFilter)
+            , mActivators(query.mQueryType == ObjectQueryTypes::ACTIVATORS)
+            , mActors(query.mQueryType == ObjectQueryTypes::ACTORS)
+            , mContainers(query.mQueryType == ObjectQueryTypes::CONTAINERS)
+            , mDoors(query.mQueryType == ObjectQueryTypes::DOORS)
+        {
+            std::vector<QueryPredicate> stack;
+            for (const Queries::Operation& op : mFilter.mOperations)
+            {
+                switch (op.mType)
                 {
-                    bool v = condStack.back();
-                    condStack.pop_back();
-                    condStack.back() = condStack.back() || v;
-                    break;
+                    case Queries::Operation::PUSH:
+                    {
+                        const Queries::Condition& cond = mFilter.mConditions[op.mConditionIndex];
+                        QueryPredicate predicate = makeNativeQueryCondition(cond);
+                        stack.push_back(predicate != nullptr ? std::move(predicate) : makeLuaQueryCondition(cond));
+                        break;
+                    }
+                    case Queries::Operation::NOT:
+                        stack.back() = [a = std::move(stack.back())](const MWWorld::Ptr& ptr, const Context& context)
+                        {
+                            return !a(ptr, context);
+                        };
+                        break;
+                    case Queries::Operation::AND:
+                    case Queries::Operation::OR:
+                    {
+                        QueryPredicate b = std::move(stack.back());
+                        stack.pop_back();
+                        QueryPredicate a = std::move(stack.back());
+                        if (op.mType == Queries::Operation::AND)
+                            stack.back() = [a = std::move(a), b = std::move(b)](const MWWorld::Ptr& ptr, const Context& context)
+                            {
+                                return a(ptr, context) && b(ptr, context);
+                            };
+                        else
+                            stack.back() = [a = std::move(a), b = std::move(b)](const MWWorld::Ptr& ptr, const Context& context)
+                            {
+                                return a(ptr, context) || b(ptr, context);
+                            };
+                        break;
+                    }
                 }
             }
+            if (!stack.empty())
+                mPredicate = std::move(stack.back());
+        }
+
+        // Whether the plan was compiled from a query with the same type and filter
+        bool isCompiledFrom(const Queries::Query& query) const
+        {
+            const Queries::Filter& filter = query.mFilter;
+            return mQueryType == query.mQueryType
+                && std::equal(mFilter.mOperations.begin(), mFilter.mOperations.end(),
+                    filter.mOperations.begin(), filter.mOperations.end(),
+                    [](const Queries::Operation& a, const Queries::Operation& b)
+                    {
+                        return a.mType == b.mType && a.mConditionIndex == b.mConditionIndex;
+                    })
+                && std::equal(mFilter.mConditions.begin(), mFilter.mConditions.end(),
+                    filter.mConditions.begin(), filter.mConditions.end(), isSameQueryCondition);
+        }
+
+        bool check(const MWWorld::Ptr& ptr, const Context& context) const
+        {
+            if (ptr.isEmpty() || ptr.getRefData().getCount() == 0)
+                return false;
+
+            // It is important to exclude all markers before checking what class it is.
+            // For example "prisonmarker" has class "Door" despite that it is only an invisible marker.
+            if (isMarker(ptr))
+                return false;
+
+            const MWWorld::Class& cls = ptr.getClass();
+            if (cls.isActivator() != mActivators)
+                return false;
+            if (cls.isActor() != mActors)
+                return false;
+            if (cls.isDoor() != mDoors)
+                return false;
+            if ((typeid(cls) == typeid(MWClass::Container)) != mContainers)
+                return false;
+
+            return mPredicate == nullptr || mPredicate(ptr, context);
+        }
+
+    private:
+        const std::string mQueryType;
+        const Queries::Filter mFilter;
+        const bool mActivators;
+        const bool mActors;
+        const bool mContainers;
+        const bool mDoors;
+        QueryPredicate mPredicate;
+    };
+
+    std::size_t hashQueryStructure(const Queries::Query& query)
+    {
+        std::size_t result = std::hash<std::string>()(query.mQueryType);
+        const auto combine = [&](std::size_t value) { result ^= value + 0x9e3779b9 + (result << 6) + (result >> 2); };
+        for (const Queries::Operation& op : query.mFilter.mOperations)
+        {
+            combine(static_cast<std::size_t>(op.mType));
+            combine(op.mConditionIndex);
+        }
+        for (const Queries::Condition& cond : query.mFilter.mConditions)
+        {
+            combine(std::hash<const Queries::Field*>()(cond.mField));
+            combine(static_cast<std::size_t>(cond.mType));
+            combine(std::hash<Queries::FieldValue>()(cond.mValue));
+        }
+        return result;
+    }
+
+    // Scripts run the same queries over and over again, often every frame
+    class QueryPlanCache
+    {
+    public:
+        std::shared_ptr<const QueryPlan> get(const Queries::Query& query)
+        {
+            const std::size_t hash = hashQueryStructure(query);
+            const std::lock_guard<std::mutex> lock(mMutex);
+            const auto [begin, end] = mPlans.equal_range(hash);
+            for (auto it = begin; it != end; ++it)
+                if (it->second->isCompiledFrom(query))
+                    return it->second;
+            // Queries built with ever changing values would fill the cache otherwise
+            if (mPlans.size() >= sMaxSize)
+                mPlans.clear();
+            return mPlans.emplace(hash, std::make_shared<const QueryPlan>(query))->second;
         }
-        return condStack.empty() || condStack.back() != 0;
+
+    private:
+        static constexpr std::size_t sMaxSize = 1024;
+
+        std::mutex mMutex;
+        std::unordered_multimap<std::size_t, std::shared_ptr<const QueryPlan>> mPlans;
+    };
+
+    std::shared_ptr<const QueryPlan> getQueryPlan(const Queries::Query& query)
+    {
+        static QueryPlanCache cache;
+        return cache.get(query);
     }
+}
 
     ObjectIdList selectObjectsFromList(const Queries::Query& query, const ObjectIdList& list, const Context& context)
     {
         if (!query.mOrderBy.empty() || !query.mGroupBy.empty() || query.mOffset > 0)
             throw std::runtime_error("OrderBy, GroupBy, and Offset are not supported");
 
+        const std::shared_ptr<const QueryPlan> plan = getQueryPlan(query);
+        ObjectRegistry* registry = context.mWorldView->getObjectRegistry();
         ObjectIdList res = std::make_shared<std::vector<ObjectId>>();
         for (const ObjectId& id : *list)
         {
             if (static_cast<int64_t>(res->size()) == query.mLimit)
                 break;
-            if (checkQueryConditions(query, id, context))
+            if (plan->check(registry->getPtr(id, !context.mIsGlobal), context))
                 res->push_back(id);
         }
         return res;
@@ -174,14 +380,15 @@ namespace MWLua
         if (!query.mOrderBy.empty() || !query.mGroupBy.empty() || query.mOffset > 0)
             throw std::runtime_error("OrderBy, GroupBy, and Offset are not supported");
 
+        const std::shared_ptr<const QueryPlan> plan = getQueryPlan(query);
         ObjectIdList res = std::make_shared<std::vector<ObjectId>>();
         auto visitor = [&](const MWWorld::Ptr& ptr)
         {
             if (static_cast<int64_t>(res->size()) == query.mLimit)
                 return false;
-            context.mWorldView->getObjectRegistry()->registerPtr(ptr);
-            if (checkQueryConditions(query, getId(ptr), context))
-                res->push_back(getId(ptr));
+            const ObjectId id = context.mWorldView->getObjectRegistry()->registerPtr(ptr);
+            if (plan->check(ptr, context))
+                res->push_back(id);
             return static_cast<int64_t>(res->size()) != query.mLimit;
         };
         store->forEach(std::move(visitor));  // TODO: maybe use store->forEachType<TYPE> depending on query.mType
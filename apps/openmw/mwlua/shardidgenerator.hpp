@@ -0,0 +1,59 @@
+#ifndef MWLUA_SHARDIDGENERATOR_H
+#define MWLUA_SHARDIDGENERATOR_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <components/esm3/cellref.hpp>
+
+namespace MWLua
+{
+
+    // Generates RefNums for new objects in one of several shards of local scripts that run in parallel.
+    // The shards take turns in the sequence that CellRef::getOrAssignRefNum follows: after `lastAssigned`,
+    // the n-th RefNum of shard k of N is the (n * N + k + 1)-th one. So the generated RefNums depend only
+    // on what each shard does, not on how the threads are scheduled.
+    class ShardIdGenerator
+    {
+    public:
+        ShardIdGenerator(ESM::RefNum lastAssigned, std::size_t shardIndex, std::size_t shardsCount)
+            : mNext(toPosition(lastAssigned) + shardIndex + 1), mStep(shardsCount) {}
+
+        ESM::RefNum next()
+        {
+            ++mCount;
+            const ESM::RefNum result = fromPosition(mNext);
+            mNext += mStep;
+            return result;
+        }
+
+        // Number of RefNums generated so far.
+        std::uint32_t getCount() const { return mCount; }
+
+        // Where the shared counter continues from once shards that generated at most `maxCount` RefNums each are
+        // merged. Some RefNums in between may be left unused.
+        static ESM::RefNum getLastAssigned(ESM::RefNum lastAssigned, std::size_t shardsCount, std::uint32_t maxCount)
+        {
+            return fromPosition(toPosition(lastAssigned) + static_cast<std::uint64_t>(maxCount) * shardsCount);
+        }
+
+    private:
+        // Generated RefNums have negative mContentFile. It is decremented every time mIndex overflows.
+        static std::uint64_t toPosition(ESM::RefNum refNum)
+        {
+            return (static_cast<std::uint64_t>(-1 - static_cast<std::int64_t>(refNum.mContentFile)) << 32) | refNum.mIndex;
+        }
+
+        static ESM::RefNum fromPosition(std::uint64_t position)
+        {
+            return ESM::RefNum {static_cast<unsigned int>(position), static_cast<int>(-1 - static_cast<std::int64_t>(position >> 32))};
+        }
+
+        std::uint64_t mNext;
+        std::uint64_t mStep;
+        std::uint32_t mCount = 0;
+    };
+
+}
+
+#endif // MWLUA_SHARDIDGENERATOR_H
@@ -121,9 +121,9 @@ namespace MWLua
         group.mChanged = true;
     }
 
-    // TODO: If Lua scripts will use several threads at the same time, then `find*Cell` functions should have critical sections.
     MWWorld::CellStore* WorldView::findCell(const std::string& name, osg::Vec3f position)
     {
+        std::lock_guard<std::mutex> lock(mCellsMutex);
         MWBase::World* world = MWBase::Environment::get().getWorld();
         bool exterior = name.empty() || world->getExterior(name);
         if (exterior)
@@ -138,6 +138,7 @@ namespace MWLua
 
     MWWorld::CellStore* WorldView::findNamedCell(const std::string& name)
     {
+        std::lock_guard<std::mutex> lock(mCellsMutex);
         MWBase::World* world = MWBase::Environment::get().getWorld();
         const ESM::Cell* esmCell = world->getExterior(name);
         if (esmCell)
@@ -148,6 +149,7 @@ namespace MWLua
 
     MWWorld::CellStore* WorldView::findExteriorCell(int x, int y)
     {
+        std::lock_guard<std::mutex> lock(mCellsMutex);
         MWBase::World* world = MWBase::Environment::get().getWorld();
         return world->getExterior(x, y);
     }
@@ -1,6 +1,8 @@
 #ifndef MWLUA_WORLDVIEW_H
 #define MWLUA_WORLDVIEW_H
 
+#include <mutex>
+
 #include "object.hpp"
 
 namespace ESM
@@ -50,10 +52,16 @@ namespace MWLua
         // If onlyActive = true, then search only among the objects that are currently in the scene.
         // TODO: ObjectIdList selectObjects(const Queries::Query& query, bool onlyActive);
 
+        // The `find*Cell` functions can create CellStores, so they are serialized for local scripts running in
+        // parallel shards. The cell found doesn't depend on the order of the calls.
         MWWorld::CellStore* findCell(const std::string& name, osg::Vec3f position);
         MWWorld::CellStore* findNamedCell(const std::string& name);
         MWWorld::CellStore* findExteriorCell(int x, int y);
 
+        // Class methods can create the custom data of an object (container store, creature stats, actor id) on first
+        // use, so bindings of local scripts that run in parallel shards access that data only under this lock.
+        std::unique_lock<std::mutex> lockObjectData() { return std::unique_lock<std::mutex>(mObjectDataMutex); }
+
         void load(ESM::ESMReader& esm);
         void save(ESM::ESMWriter& esm) const;
 
@@ -73,6 +81,8 @@ namespace MWLua
         void removeFromGroup(ObjectGroup& group, const MWWorld::Ptr& ptr);
 
         ObjectRegistry mObjectRegistry;
+        std::mutex mCellsMutex;
+        std::mutex mObjectDataMutex;
         ObjectGroup mActivatorsInScene;
         ObjectGroup mActorsInScene;
         ObjectGroup mContainersInScene;
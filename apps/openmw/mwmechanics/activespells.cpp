@@ -215,7 +215,8 @@ namespace MWMechanics
                         continue;
                     if(std::find_if(mSpells.begin(), mSpells.end(), [&] (const ActiveSpellParams& params)
                     {
-                        return params.mSlot == slotIndex && params.mType == ESM::ActiveSpells::Type_Enchantment && params.mId == slot->getCellRef().getRefId();
+                        return params.mSlot == slotIndex && params.mType == ESM::ActiveSpells::Type_Enchantment
+                            && Misc::StringUtils::ciEqual(params.mId, slot->getCellRef().getRefId());
                     }) != mSpells.end())
                         continue;
                     const ActiveSpellParams& params = mSpells.emplace_back(ActiveSpellParams{*slot, enchantment, slotIndex, ptr});
@@ -284,7 +285,7 @@ namespace MWMechanics
             {
                 const auto& store = ptr.getClass().getInventoryStore(ptr);
                 auto slot = store.getSlot(spellIt->mSlot);
-                remove = slot == store.end() || slot->getCellRef().getRefId() != spellIt->mId;
+                remove = slot == store.end() || !Misc::StringUtils::ciEqual(slot->getCellRef().getRefId(), spellIt->mId);
             }
             if(remove)
             {
@@ -2,6 +2,7 @@
 #define OPENMW_MECHANICS_ACTOR_H
 
 #include <memory>
+#include <vector>
 
 #include "../mwmechanics/actorutil.hpp"
 
@@ -45,12 +46,24 @@ namespace MWMechanics
 
         Misc::TimerStatus updateEngageCombatTimer(float duration)
         {
-            return mEngageCombat.update(duration);
+            mEngageCombatTimerStatus = mEngageCombat.update(duration);
+            return mEngageCombatTimerStatus;
         }
 
+        /// Result of the last updateEngageCombatTimer call.
+        Misc::TimerStatus getEngageCombatTimerStatus() const { return mEngageCombatTimerStatus; }
+
         void setPositionAdjusted(bool adjusted);
         bool getPositionAdjusted() const;
 
+        /// Actors close enough and in front of this one to be its head tracking target, in the Actors order.
+        /// Filled by Actors::prepareAiUpdate for the current head tracking update only.
+        std::vector<MWWorld::Ptr>& getHeadTrackingCandidates() { return mHeadTrackingCandidates; }
+
+        /// Actors close enough to this one to engage it in combat, in the Actors order.
+        /// Filled by Actors::prepareAiUpdate for the current update when the engage combat timer has elapsed.
+        std::vector<MWWorld::Ptr>& getCombatCandidates() { return mCombatCandidates; }
+
     private:
         std::unique_ptr<CharacterController> mCharacterController;
         int mGreetingTimer{0};
@@ -58,7 +71,10 @@ namespace MWMechanics
         GreetingState mGreetingState{Greet_None};
         bool mIsTurningToPlayer{false};
         Misc::DeviatingPeriodicTimer mEngageCombat{1.0f, 0.25f, Misc::Rng::deviate(0, 0.25f)};
+        Misc::TimerStatus mEngageCombatTimerStatus{Misc::TimerStatus::Waiting};
         bool mPositionAdjusted;
+        std::vector<MWWorld::Ptr> mHeadTrackingCandidates;
+        std::vector<MWWorld::Ptr> mCombatCandidates;
     };
 
 }
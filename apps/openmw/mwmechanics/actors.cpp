@@ -1,6 +1,9 @@
 #include "actors.hpp"
 
+#include <algorithm>
 #include <optional>
+#include <string_view>
+#include <tuple>
 
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/esmwriter.hpp>
@@ -169,13 +172,12 @@ void soulTrap(const MWWorld::Ptr& creature)
             MWWorld::ContainerStore& container = caster.getClass().getContainerStore(caster);
             MWWorld::ContainerStoreIterator gem = container.end();
             float gemCapacity = std::numeric_limits<float>::max();
-            std::string soulgemFilter = "misc_soulgem"; // no other way to check for soulgems? :/
+            constexpr std::string_view soulgemFilter = "misc_soulgem"; // no other way to check for soulgems? :/
             for (MWWorld::ContainerStoreIterator it = container.begin(MWWorld::ContainerStore::Type_Miscellaneous);
                  it != container.end(); ++it)
             {
-                const std::string& id = it->getCellRef().getRefId();
-                if (id.size() >= soulgemFilter.size()
-                        && id.substr(0,soulgemFilter.size()) == soulgemFilter)
+                const std::string_view id = it->getCellRef().getRefId();
+                if (id.substr(0, soulgemFilter.size()) == soulgemFilter)
                 {
                     float thisGemCapacity = it->get<ESM::Miscellaneous>()->mBase->mData.mValue * fSoulgemMult;
                     if (thisGemCapacity >= creatureSoulValue && thisGemCapacity < gemCapacity
@@ -229,11 +231,83 @@ namespace MWMechanics
 
     namespace
     {
+        // Large enough for a typical query radius to cover few grid cells
+        constexpr float actorsGridCellSize = 1024.f;
+
+        float getMaxHeadTrackDistance(const MWWorld::Ptr& actor)
+        {
+            static const float fMaxHeadTrackDistance = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>()
+                    .find("fMaxHeadTrackDistance")->mValue.getFloat();
+            static const float fInteriorHeadTrackMult = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>()
+                    .find("fInteriorHeadTrackMult")->mValue.getFloat();
+            float maxDistance = fMaxHeadTrackDistance;
+            const ESM::Cell* currentCell = actor.getCell()->getCell();
+            if (!currentCell->isExterior() && !(currentCell->mData.mFlags & ESM::Cell::QuasiEx))
+                maxDistance *= fInteriorHeadTrackMult;
+            return maxDistance;
+        }
+
         float getTimeToDestination(const AiPackage& package, const osg::Vec3f& position, float speed, float duration, const osg::Vec3f& halfExtents)
         {
             const auto distanceToNextPathPoint = (package.getNextPathPoint(package.getDestination()) - position).length();
             return (distanceToNextPathPoint - package.getNextPathPointTolerance(speed, duration, halfExtents)) / speed;
         }
+
+        // What the workers of Actors::prepareAiUpdate know about an actor. They read only these and the actors grid,
+        // which nothing changes while they run.
+        struct AiSnapshot
+        {
+            MWWorld::Ptr mPtr;
+            Actor* mActor = nullptr;
+            osg::Vec3f mPosition;
+            osg::Vec3f mDirection;
+            float mMaxHeadTrackDistance = 0;
+            bool mIsDead = false;
+            bool mFindHeadTrackTargets = false;
+            bool mFindCombatTargets = false;
+        };
+
+        // The same for Actors::predictAndAvoidCollisions, taken after the AI has set the movement of all actors.
+        struct CollisionSnapshot
+        {
+            MWWorld::Ptr mPtr;
+            osg::Vec3f mPosition;
+            float mRotZ = 0;
+            osg::Vec3f mHalfExtents;
+            osg::Vec3f mMovement;
+            float mMaxSpeed = 0;
+            bool mIsDead = false;
+        };
+
+        struct PredictedCollision
+        {
+            float mTime;
+            std::size_t mOther;
+            float mAngle;
+            osg::Vec2f mMovementCorrection;
+        };
+
+        struct CollisionAvoidance
+        {
+            std::size_t mIndex;
+            bool mIsMoving;
+            bool mShouldTurnToApproachingActor;
+            MWWorld::Ptr mCurrentTarget;
+            float mMaxDistToCheck;
+            float mTimeToCheck;
+            std::vector<PredictedCollision> mCollisions;
+        };
+
+        // Snapshots are taken in the Actors order, which is the order of Ptrs
+        template <class Snapshot>
+        const Snapshot* findInSnapshot(const std::vector<Snapshot>& snapshot, const MWWorld::Ptr& ptr)
+        {
+            const auto it = std::lower_bound(snapshot.begin(), snapshot.end(), ptr,
+                [] (const Snapshot& value, const MWWorld::Ptr& key) { return value.mPtr < key; });
+            if (it == snapshot.end() || it->mPtr != ptr)
+                return nullptr;
+            return &*it;
+        }
     }
 
     void Actors::updateActor (const MWWorld::Ptr& ptr, float duration)
@@ -255,14 +329,7 @@ namespace MWMechanics
         if (targetActor.getClass().getCreatureStats(targetActor).isDead())
             return;
 
-        static const float fMaxHeadTrackDistance = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>()
-                .find("fMaxHeadTrackDistance")->mValue.getFloat();
-        static const float fInteriorHeadTrackMult = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>()
-                .find("fInteriorHeadTrackMult")->mValue.getFloat();
-        float maxDistance = fMaxHeadTrackDistance;
-        const ESM::Cell* currentCell = actor.getCell()->getCell();
-        if (!currentCell->isExterior() && !(currentCell->mData.mFlags & ESM::Cell::QuasiEx))
-            maxDistance *= fInteriorHeadTrackMult;
+        const float maxDistance = getMaxHeadTrackDistance(actor);
 
         const osg::Vec3f actor1Pos(actor.getRefData().getPosition().asVec3());
         const osg::Vec3f actor2Pos(targetActor.getRefData().getPosition().asVec3());
@@ -285,6 +352,80 @@ namespace MWMechanics
         }
     }
 
+    void Actors::prepareAiUpdate(float duration, bool aiActive, bool updateHeadTracking)
+    {
+        const MWWorld::Ptr player = getPlayer();
+        const osg::Vec3f playerPos = player.getRefData().getPosition().asVec3();
+        const float sqrProcessingRange = mActorsProcessingRange * mActorsProcessingRange;
+
+        // Collect everything the workers need, so they don't touch the world
+        std::vector<AiSnapshot> snapshot;
+        snapshot.reserve(mActors.size());
+        for (const auto& [ptr, actor] : mActors)
+        {
+            const bool engageCombat = actor->updateEngageCombatTimer(duration) == Misc::TimerStatus::Elapsed;
+            actor->getCombatCandidates().clear();
+            if (!aiActive)
+                continue;
+
+            AiSnapshot& value = snapshot.emplace_back();
+            value.mPtr = ptr;
+            value.mActor = actor;
+            value.mPosition = ptr.getRefData().getPosition().asVec3();
+            value.mIsDead = ptr.getClass().getCreatureStats(ptr).isDead();
+            value.mFindCombatTargets = engageCombat && ptr != player && !value.mIsDead
+                && (playerPos - value.mPosition).length2() <= sqrProcessingRange;
+            if (!updateHeadTracking)
+                continue;
+            actor->getHeadTrackingCandidates().clear();
+            if (const SceneUtil::PositionAttitudeTransform* baseNode = ptr.getRefData().getBaseNode(); baseNode != nullptr && !value.mIsDead)
+            {
+                value.mFindHeadTrackTargets = true;
+                value.mDirection = baseNode->getAttitude() * osg::Vec3f(0, 1, 0);
+                value.mDirection.z() = 0;
+                value.mMaxHeadTrackDistance = getMaxHeadTrackDistance(ptr);
+            }
+        }
+
+        mThreadPool.run(snapshot.size(), [&] (std::size_t index)
+        {
+            const AiSnapshot& actor = snapshot[index];
+            const auto findTargets = [&] (float radius, std::vector<MWWorld::Ptr>& out, auto&& isCandidate)
+            {
+                mActorsGrid.forEachInRadius(actor.mPosition, radius, [&] (const MWWorld::Ptr& ptr, const osg::Vec3f& /*position*/)
+                {
+                    const AiSnapshot* target = findInSnapshot(snapshot, ptr);
+                    if (target != nullptr && target != &actor && !target->mIsDead && isCandidate(*target))
+                        out.push_back(ptr);
+                    return true;
+                });
+                // Sorted the same way as mActors, so the targets are checked in the usual order
+                std::sort(out.begin(), out.end());
+            };
+
+            if (actor.mFindCombatTargets)
+            {
+                findTargets(mActorsProcessingRange, actor.mActor->getCombatCandidates(), [&] (const AiSnapshot& target)
+                {
+                    return (target.mPosition - actor.mPosition).length2() <= sqrProcessingRange;
+                });
+            }
+
+            if (actor.mFindHeadTrackTargets)
+            {
+                const float sqrMaxDistance = actor.mMaxHeadTrackDistance * actor.mMaxHeadTrackDistance;
+                findTargets(actor.mMaxHeadTrackDistance, actor.mActor->getHeadTrackingCandidates(), [&] (const AiSnapshot& target)
+                {
+                    osg::Vec3f targetDirection = target.mPosition - actor.mPosition;
+                    if (targetDirection.length2() > sqrMaxDistance)
+                        return false;
+                    targetDirection.z() = 0;
+                    return actor.mDirection * targetDirection > 0;
+                });
+            }
+        });
+    }
+
     void Actors::playIdleDialogue(const MWWorld::Ptr& actor)
     {
         if (!actor.getClass().isActor() || actor == getPlayer() || MWBase::Environment::get().getSoundManager()->sayActive(actor))
@@ -1010,7 +1151,10 @@ namespace MWMechanics
         }
     }
 
-    Actors::Actors() : mSmoothMovement(Settings::Manager::getBool("smooth movement", "Game"))
+    Actors::Actors()
+        : mActorsGrid(actorsGridCellSize)
+        , mThreadPool(static_cast<std::size_t>(std::max(0, Settings::Manager::getInt("actors update threads", "Game"))))
+        , mSmoothMovement(Settings::Manager::getBool("smooth movement", "Game"))
     {
         mTimerDisposeSummonsCorpses = 0.2f; // We should add a delay between summoned creature death and its corpse despawning
 
@@ -1044,6 +1188,7 @@ namespace MWMechanics
         if (!anim)
             return;
         mActors.emplace(ptr, new Actor(ptr, anim));
+        mActorsGrid.update(ptr, ptr.getRefData().getPosition().asVec3());
 
         CharacterController* ctrl = mActors[ptr]->getCharacterController();
         if (updateImmediately)
@@ -1095,6 +1240,7 @@ namespace MWMechanics
                 removeTemporaryEffects(iter->first);
             delete iter->second;
             mActors.erase(iter);
+            mActorsGrid.erase(ptr);
         }
     }
 
@@ -1147,6 +1293,8 @@ namespace MWMechanics
 
             actor->updatePtr(ptr);
             mActors.insert(std::make_pair(ptr, actor));
+            mActorsGrid.erase(old);
+            mActorsGrid.update(ptr, ptr.getRefData().getPosition().asVec3());
         }
     }
 
@@ -1159,6 +1307,7 @@ namespace MWMechanics
             {
                 removeTemporaryEffects(iter->first);
                 delete iter->second;
+                mActorsGrid.erase(iter->first);
                 mActors.erase(iter++);
             }
             else
@@ -1166,6 +1315,12 @@ namespace MWMechanics
         }
     }
 
+    void Actors::updatePosition(const MWWorld::Ptr& ptr)
+    {
+        if (mActors.find(ptr) != mActors.end())
+            mActorsGrid.update(ptr, ptr.getRefData().getPosition().asVec3());
+    }
+
     void Actors::updateCombatMusic ()
     {
         MWWorld::Ptr player = getPlayer();
@@ -1222,20 +1377,34 @@ namespace MWMechanics
 
         MWWorld::Ptr player = getPlayer();
         MWBase::World* world = MWBase::Environment::get().getWorld();
-        for(PtrActorMap::iterator iter(mActors.begin()); iter != mActors.end(); ++iter)
+
+        // Collect everything the workers need, so they don't touch the world
+        std::vector<CollisionSnapshot> snapshot;
+        snapshot.reserve(mActors.size());
+        for (const auto& [ptr, actor] : mActors)
+        {
+            CollisionSnapshot& value = snapshot.emplace_back();
+            value.mPtr = ptr;
+            value.mPosition = ptr.getRefData().getPosition().asVec3();
+            value.mRotZ = ptr.getRefData().getPosition().rot[2];
+            value.mHalfExtents = world->getHalfExtents(ptr);
+            value.mMovement = ptr.getClass().getMovementSettings(ptr).asVec3();
+            value.mMaxSpeed = ptr.getClass().getMaxSpeed(ptr);
+            value.mIsDead = ptr.getClass().getCreatureStats(ptr).isDead();
+        }
+
+        std::vector<CollisionAvoidance> avoidances;
+        for (std::size_t index = 0; index < snapshot.size(); ++index)
         {
-            const MWWorld::Ptr& ptr = iter->first;
-            if (ptr == player)
+            const CollisionSnapshot& actor = snapshot[index];
+            if (actor.mPtr == player)
                 continue; // Don't interfere with player controls.
 
-            float maxSpeed = ptr.getClass().getMaxSpeed(ptr);
-            if (maxSpeed == 0.0)
+            if (actor.mMaxSpeed == 0.0)
                 continue; // Can't move, so there is no sense to predict collisions.
 
-            Movement& movement = ptr.getClass().getMovementSettings(ptr);
-            osg::Vec2f origMovement(movement.mPosition[0], movement.mPosition[1]);
-            bool isMoving = origMovement.length2() > 0.01;
-            if (movement.mPosition[1] < 0)
+            bool isMoving = osg::Vec2f(actor.mMovement.x(), actor.mMovement.y()).length2() > 0.01;
+            if (actor.mMovement.y() < 0)
                 continue; // Actors can not see others when move backward.
 
             // Moving NPCs always should avoid collisions.
@@ -1245,7 +1414,7 @@ namespace MWMechanics
             bool shouldGiveWay = false;
             bool shouldTurnToApproachingActor = !isMoving;
             MWWorld::Ptr currentTarget; // Combat or pursue target (NPCs should not avoid collision with their targets).
-            const auto& aiSequence = ptr.getClass().getCreatureStats(ptr).getAiSequence();
+            const auto& aiSequence = actor.mPtr.getClass().getCreatureStats(actor.mPtr).getAiSequence();
             for (const auto& package : aiSequence)
             {
                 if (package->getTypeId() == AiPackageTypeId::Follow)
@@ -1266,46 +1435,44 @@ namespace MWMechanics
             if (!shouldAvoidCollision && !shouldGiveWay)
                 continue;
 
-            osg::Vec2f baseSpeed = origMovement * maxSpeed;
-            osg::Vec3f basePos = ptr.getRefData().getPosition().asVec3();
-            float baseRotZ = ptr.getRefData().getPosition().rot[2];
-            const osg::Vec3f halfExtents = world->getHalfExtents(ptr);
-            float maxDistToCheck = isMoving ? maxDistForPartialAvoiding : maxDistForStrictAvoiding;
-
             float timeToCheck = maxTimeToCheck;
             if (!shouldGiveWay && !aiSequence.isEmpty())
-                timeToCheck = std::min(timeToCheck, getTimeToDestination(**aiSequence.begin(), basePos, maxSpeed, duration, halfExtents));
+                timeToCheck = std::min(timeToCheck, getTimeToDestination(**aiSequence.begin(), actor.mPosition, actor.mMaxSpeed, duration, actor.mHalfExtents));
 
-            float timeToCollision = timeToCheck;
-            osg::Vec2f movementCorrection(0, 0);
-            float angleToApproachingActor = 0;
+            const float maxDistToCheck = isMoving ? maxDistForPartialAvoiding : maxDistForStrictAvoiding;
+            avoidances.push_back(CollisionAvoidance {index, isMoving, shouldTurnToApproachingActor, currentTarget, maxDistToCheck, timeToCheck, {}});
+        }
+
+        // Predict collisions with other actors close enough in parallel
+        mThreadPool.run(avoidances.size(), [&] (std::size_t avoidanceIndex)
+        {
+            CollisionAvoidance& avoidance = avoidances[avoidanceIndex];
+            const CollisionSnapshot& actor = snapshot[avoidance.mIndex];
+            const osg::Vec2f baseSpeed = osg::Vec2f(actor.mMovement.x(), actor.mMovement.y()) * actor.mMaxSpeed;
+            const float maxDistToCheck = avoidance.mMaxDistToCheck;
 
-            // Iterate through all other actors and predict collisions.
-            for(PtrActorMap::iterator otherIter(mActors.begin()); otherIter != mActors.end(); ++otherIter)
+            mActorsGrid.forEachInRadius(actor.mPosition, maxDistToCheck, [&] (const MWWorld::Ptr& otherPtr, const osg::Vec3f& /*position*/)
             {
-                const MWWorld::Ptr& otherPtr = otherIter->first;
-                if (otherPtr == ptr || otherPtr == currentTarget)
-                    continue;
+                const CollisionSnapshot* other = findInSnapshot(snapshot, otherPtr);
+                if (other == nullptr || other == &actor || otherPtr == avoidance.mCurrentTarget)
+                    return true;
 
-                const osg::Vec3f otherHalfExtents = world->getHalfExtents(otherPtr);
-                osg::Vec3f deltaPos = otherPtr.getRefData().getPosition().asVec3() - basePos;
-                osg::Vec2f relPos = Misc::rotateVec2f(osg::Vec2f(deltaPos.x(), deltaPos.y()), baseRotZ);
+                osg::Vec3f deltaPos = other->mPosition - actor.mPosition;
+                osg::Vec2f relPos = Misc::rotateVec2f(osg::Vec2f(deltaPos.x(), deltaPos.y()), actor.mRotZ);
                 float dist = deltaPos.length();
 
                 // Ignore actors which are not close enough or come from behind.
                 if (dist > maxDistToCheck || relPos.y() < 0)
-                    continue;
+                    return true;
 
                 // Don't check for a collision if vertical distance is greater then the actor's height.
-                if (deltaPos.z() > halfExtents.z() * 2 || deltaPos.z() < -otherHalfExtents.z() * 2)
-                    continue;
+                if (deltaPos.z() > actor.mHalfExtents.z() * 2 || deltaPos.z() < -other->mHalfExtents.z() * 2)
+                    return true;
 
-                osg::Vec3f speed = otherPtr.getClass().getMovementSettings(otherPtr).asVec3() *
-                                   otherPtr.getClass().getMaxSpeed(otherPtr);
-                float rotZ = otherPtr.getRefData().getPosition().rot[2];
-                osg::Vec2f relSpeed = Misc::rotateVec2f(osg::Vec2f(speed.x(), speed.y()), baseRotZ - rotZ) - baseSpeed;
+                osg::Vec3f speed = other->mMovement * other->mMaxSpeed;
+                osg::Vec2f relSpeed = Misc::rotateVec2f(osg::Vec2f(speed.x(), speed.y()), actor.mRotZ - other->mRotZ) - baseSpeed;
 
-                float collisionDist = minGap + halfExtents.x() + otherHalfExtents.x();
+                float collisionDist = minGap + actor.mHalfExtents.x() + other->mHalfExtents.x();
                 collisionDist = std::min(collisionDist, relPos.length());
 
                 // Find the earliest `t` when |relPos + relSpeed * t| == collisionDist.
@@ -1313,43 +1480,59 @@ namespace MWMechanics
                 float v2 = relSpeed.length2();
                 float Dh = vr * vr - v2 * (relPos.length2() - collisionDist * collisionDist);
                 if (Dh <= 0 || v2 == 0)
-                    continue; // No solution; distance is always >= collisionDist.
+                    return true; // No solution; distance is always >= collisionDist.
                 float t = (-vr - std::sqrt(Dh)) / v2;
 
-                if (t < 0 || t > timeToCollision)
-                    continue;
-
-                // Check visibility and awareness last as it's expensive.
-                if (!MWBase::Environment::get().getWorld()->getLOS(otherPtr, ptr))
-                    continue;
-                if (!MWBase::Environment::get().getMechanicsManager()->awarenessCheck(otherPtr, ptr))
-                    continue;
+                if (t < 0 || t >= avoidance.mTimeToCheck)
+                    return true;
 
-                timeToCollision = t;
-                angleToApproachingActor = std::atan2(deltaPos.x(), deltaPos.y());
                 osg::Vec2f posAtT = relPos + relSpeed * t;
-                float coef = (posAtT.x() * relSpeed.x() + posAtT.y() * relSpeed.y()) / (collisionDist * collisionDist * maxSpeed);
+                float coef = (posAtT.x() * relSpeed.x() + posAtT.y() * relSpeed.y()) / (collisionDist * collisionDist * actor.mMaxSpeed);
                 coef *= std::clamp((maxDistForPartialAvoiding - dist) / (maxDistForPartialAvoiding - maxDistForStrictAvoiding), 0.f, 1.f);
-                movementCorrection = posAtT * coef;
-                if (otherPtr.getClass().getCreatureStats(otherPtr).isDead())
+                osg::Vec2f movementCorrection = posAtT * coef;
+                if (other->mIsDead)
                     // In case of dead body still try to go around (it looks natural), but reduce the correction twice.
                     movementCorrection.y() *= 0.5f;
-            }
 
-            if (timeToCollision < timeToCheck)
+                avoidance.mCollisions.push_back(PredictedCollision {t, static_cast<std::size_t>(other - snapshot.data()),
+                    std::atan2(deltaPos.x(), deltaPos.y()), movementCorrection});
+                return true;
+            });
+
+            // The order doesn't depend on the grid layout, so the checks below are done deterministically
+            std::sort(avoidance.mCollisions.begin(), avoidance.mCollisions.end(), [] (const PredictedCollision& l, const PredictedCollision& r)
             {
-                // Try to evade the nearest collision.
-                osg::Vec2f newMovement = origMovement + movementCorrection;
-                // Step to the side rather than backward. Otherwise player will be able to push the NPC far away from it's original location.
-                newMovement.y() = std::max(newMovement.y(), 0.f);
-                newMovement.normalize();
-                if (isMoving)
-                    newMovement *= origMovement.length(); // Keep the original speed.
-                movement.mPosition[0] = newMovement.x();
-                movement.mPosition[1] = newMovement.y();
-                if (shouldTurnToApproachingActor)
-                    zTurn(ptr, angleToApproachingActor);
-            }
+                return std::tie(l.mTime, l.mOther) < std::tie(r.mTime, r.mOther);
+            });
+        });
+
+        for (const CollisionAvoidance& avoidance : avoidances)
+        {
+            const MWWorld::Ptr& ptr = snapshot[avoidance.mIndex].mPtr;
+
+            // Try to evade the nearest collision with an actor this one is aware of.
+            // Check visibility and awareness last as it's expensive.
+            const auto collision = std::find_if(avoidance.mCollisions.begin(), avoidance.mCollisions.end(), [&] (const PredictedCollision& value)
+            {
+                const MWWorld::Ptr& otherPtr = snapshot[value.mOther].mPtr;
+                return world->getLOS(otherPtr, ptr)
+                    && MWBase::Environment::get().getMechanicsManager()->awarenessCheck(otherPtr, ptr);
+            });
+            if (collision == avoidance.mCollisions.end())
+                continue;
+
+            Movement& movement = ptr.getClass().getMovementSettings(ptr);
+            osg::Vec2f origMovement(movement.mPosition[0], movement.mPosition[1]);
+            osg::Vec2f newMovement = origMovement + collision->mMovementCorrection;
+            // Step to the side rather than backward. Otherwise player will be able to push the NPC far away from it's original location.
+            newMovement.y() = std::max(newMovement.y(), 0.f);
+            newMovement.normalize();
+            if (avoidance.mIsMoving)
+                newMovement *= origMovement.length(); // Keep the original speed.
+            movement.mPosition[0] = newMovement.x();
+            movement.mPosition[1] = newMovement.y();
+            if (avoidance.mShouldTurnToApproachingActor)
+                zTurn(ptr, collision->mAngle);
         }
     }
 
@@ -1389,6 +1572,10 @@ namespace MWMechanics
             }
             bool godmode = MWBase::Environment::get().getWorld()->getGodModeState();
 
+            // Read-mostly part of the AI update, done for all actors in parallel against a snapshot of them.
+            // Its results are applied below in the Actors order, together with everything changing the world.
+            prepareAiUpdate(duration, aiActive, timerUpdateHeadTrack == 0);
+
              // AI and magic effects update
             for(PtrActorMap::iterator iter(mActors.begin()); iter != mActors.end(); ++iter)
             {
@@ -1411,7 +1598,7 @@ namespace MWMechanics
                         player.getClass().getCreatureStats(player).setHitAttemptActorId(-1);
                 }
 
-                const Misc::TimerStatus engageCombatTimerStatus = iter->second->updateEngageCombatTimer(duration);
+                const Misc::TimerStatus engageCombatTimerStatus = iter->second->getEngageCombatTimerStatus();
 
                 // For dead actors we need to update looping spell particles
                 if (iter->first.getClass().getCreatureStats(iter->first).isDead())
@@ -1446,12 +1633,11 @@ namespace MWMechanics
                             if (!isPlayer)
                                 adjustCommandedActor(iter->first);
 
-                            for(PtrActorMap::iterator it(mActors.begin()); it != mActors.end(); ++it)
-                            {
-                                if (it->first == iter->first || isPlayer) // player is not AI-controlled
-                                    continue;
-                                engageCombat(iter->first, it->first, cachedAllies, it->first == player);
-                            }
+                            // Candidates were found before the loop, actors may have been removed since then.
+                            // There are none for the player, as the player is not AI-controlled.
+                            for (const MWWorld::Ptr& candidate : iter->second->getCombatCandidates())
+                                if (mActors.find(candidate) != mActors.end())
+                                    engageCombat(iter->first, candidate, cachedAllies, candidate == player);
                         }
                         if (timerUpdateHeadTrack == 0)
                         {
@@ -1469,17 +1655,17 @@ namespace MWMechanics
                             if (!stats.getKnockedDown() && !firstPersonPlayer)
                             {
                                 if (inCombatOrPursue)
+                                {
                                     activePackageTarget = stats.getAiSequence().getActivePackage().getTarget();
-
-                                for (PtrActorMap::iterator it(mActors.begin()); it != mActors.end(); ++it)
+                                    if (activePackageTarget != iter->first && mActors.find(activePackageTarget) != mActors.end())
+                                        updateHeadTracking(iter->first, activePackageTarget, headTrackTarget, sqrHeadTrackDistance, true);
+                                }
+                                else
                                 {
-                                    if (it->first == iter->first)
-                                        continue;
-
-                                    if (inCombatOrPursue && it->first != activePackageTarget)
-                                        continue;
-
-                                    updateHeadTracking(iter->first, it->first, headTrackTarget, sqrHeadTrackDistance, inCombatOrPursue);
+                                    // Candidates were found before the loop, actors may have been removed since then
+                                    for (const MWWorld::Ptr& candidate : iter->second->getHeadTrackingCandidates())
+                                        if (mActors.find(candidate) != mActors.end())
+                                            updateHeadTracking(iter->first, candidate, headTrackTarget, sqrHeadTrackDistance, false);
                                 }
                             }
 
@@ -1653,7 +1839,7 @@ namespace MWMechanics
     {
         actor.getClass().getCreatureStats(actor).notifyDied();
 
-        ++mDeathCount[Misc::StringUtils::lowerCase(actor.getCellRef().getRefId())];
+        ++mDeathCount[actor.getCellRef().getRefId()];
     }
 
     void Actors::resurrect(const MWWorld::Ptr &ptr)
@@ -1954,22 +2140,20 @@ namespace MWMechanics
 
     void Actors::getObjectsInRange(const osg::Vec3f& position, float radius, std::vector<MWWorld::Ptr>& out)
     {
-        for (PtrActorMap::iterator iter = mActors.begin(); iter != mActors.end(); ++iter)
+        const std::size_t size = out.size();
+        mActorsGrid.forEachInRadius(position, radius, [&] (const MWWorld::Ptr& ptr, const osg::Vec3f& /*position*/)
         {
-            if ((iter->first.getRefData().getPosition().asVec3() - position).length2() <= radius*radius)
-                out.push_back(iter->first);
-        }
+            out.push_back(ptr);
+            return true;
+        });
+        // Keep the order independent from the grid layout, so the callers behave deterministically
+        std::sort(out.begin() + size, out.end());
     }
 
     bool Actors::isAnyObjectInRange(const osg::Vec3f& position, float radius)
     {
-        for (PtrActorMap::iterator iter = mActors.begin(); iter != mActors.end(); ++iter)
-        {
-            if ((iter->first.getRefData().getPosition().asVec3() - position).length2() <= radius*radius)
-                return true;
-        }
-
-        return false;
+        return !mActorsGrid.forEachInRadius(position, radius,
+            [] (const MWWorld::Ptr& /*ptr*/, const osg::Vec3f& /*position*/) { return false; });
     }
 
     std::list<MWWorld::Ptr> Actors::getActorsSidingWith(const MWWorld::Ptr& actor)
@@ -2175,6 +2359,7 @@ namespace MWMechanics
             it->second = nullptr;
         }
         mActors.clear();
+        mActorsGrid.clear();
         mDeathCount.clear();
     }
 
@@ -7,6 +7,9 @@
 #include <list>
 #include <map>
 
+#include <components/misc/spatialgrid.hpp>
+#include <components/misc/threadpool.hpp>
+
 #include "../mwmechanics/actorutil.hpp"
 
 namespace ESM
@@ -56,6 +59,12 @@ namespace MWMechanics
             void purgeSpellEffects (int casterActorId);
 
             void predictAndAvoidCollisions(float duration);
+            ///< Predict collisions of all actors in parallel, then apply the avoidance in the Actors order.
+
+            void prepareAiUpdate(float duration, bool aiActive, bool updateHeadTracking);
+            ///< Update the engage combat timers and find possible combat and head tracking targets of all actors in
+            /// parallel. Only the cheap geometric checks are done here, engageCombat and updateHeadTracking still have
+            /// to be called for each candidate in order.
 
         public:
 
@@ -101,6 +110,9 @@ namespace MWMechanics
             void dropActors (const MWWorld::CellStore *cellStore, const MWWorld::Ptr& ignore);
             ///< Deregister all actors (except for \a ignore) in the given cell.
 
+            void updatePosition(const MWWorld::Ptr& ptr);
+            ///< Update the actor's position in the spatial index, called when the actor was moved
+
             void updateCombatMusic();
             ///< Update combat music state
 
@@ -204,6 +216,8 @@ namespace MWMechanics
         void updateVisibility (const MWWorld::Ptr& ptr, CharacterController* ctrl);
 
         PtrActorMap mActors;
+        Misc::SpatialGrid<MWWorld::Ptr> mActorsGrid;
+        Misc::ThreadPool mThreadPool;
         float mTimerDisposeSummonsCorpses;
         float mActorsProcessingRange;
 
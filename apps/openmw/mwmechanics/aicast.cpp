@@ -1,6 +1,7 @@
 #include "aicast.hpp"
 
 #include <components/misc/constants.hpp>
+#include <components/misc/stringops.hpp>
 
 #include "../mwbase/environment.hpp"
 #include "../mwbase/mechanicsmanager.hpp"
@@ -33,7 +34,7 @@ MWMechanics::AiCast::AiCast(const std::string& targetId, const std::string& spel
 bool MWMechanics::AiCast::execute(const MWWorld::Ptr& actor, MWMechanics::CharacterController& characterController, MWMechanics::AiState& state, float duration)
 {
     MWWorld::Ptr target;
-    if (actor.getCellRef().getRefId() == mTargetId)
+    if (Misc::StringUtils::ciEqual(actor.getCellRef().getRefId(), mTargetId))
     {
         // If the target has the same ID as caster, consider that actor casts spell with Self range.
         target = actor;
@@ -261,9 +261,9 @@ namespace MWMechanics
 
         // If actor uses custom destination it has to try to rebuild path because environment can change
         // (door is opened between actor and target) or target position has changed and current custom destination
-        // is not good enough to attack target.
+        // is not good enough to attack target. A path requested by pathTo is waited for.
         if (storage.mCurrentAction->isAttackingOrSpell()
-            && ((!storage.mReadyToAttack && !mPathFinder.isPathConstructed())
+            && ((!storage.mReadyToAttack && !mPathFinder.isPathConstructed() && !mPathFinder.isPathRequested())
                 || (storage.mUseCustomDestination && (storage.mCustomDestination - vTargetPos).length() > rangeAttack)))
         {
             const MWBase::World* world = MWBase::Environment::get().getWorld();
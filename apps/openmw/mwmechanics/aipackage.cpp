@@ -47,6 +47,7 @@ MWMechanics::AiPackage::AiPackage(AiPackageTypeId typeId, const Options& options
     mTargetActorRefId(""),
     mTargetActorId(-1),
     mRotateOnTheRunChecks(0),
+    mDestInLOS(false),
     mIsShortcutting(false),
     mShortcutProhibited(false),
     mShortcutFailPos()
@@ -85,6 +86,7 @@ void MWMechanics::AiPackage::reset()
 {
     // reset all members
     mReaction.reset();
+    mDestInLOS = false;
     mIsShortcutting = false;
     mShortcutProhibited = false;
     mShortcutFailPos = osg::Vec3f();
@@ -135,26 +137,13 @@ bool MWMechanics::AiPackage::pathTo(const MWWorld::Ptr& actor, const osg::Vec3f&
 
         if (!mIsShortcutting)
         {
-            if (wasShortcutting || doesPathNeedRecalc(dest, actor)) // if need to rebuild path
+            // if need to rebuild path, the new one is taken from the navigator in one of the next frames
+            if (wasShortcutting || (!mPathFinder.isPathRequested() && doesPathNeedRecalc(dest, actor)))
             {
                 const auto pathfindingHalfExtents = world->getPathfindingHalfExtents(actor);
-                mPathFinder.buildLimitedPath(actor, position, dest, actor.getCell(), getPathGridGraph(actor.getCell()),
-                    pathfindingHalfExtents, getNavigatorFlags(actor), getAreaCosts(actor), endTolerance, pathType);
-                mRotateOnTheRunChecks = 3;
-
-                // give priority to go directly on target if there is minimal opportunity
-                if (destInLOS && mPathFinder.getPath().size() > 1)
-                {
-                    // get point just before dest
-                    auto pPointBeforeDest = mPathFinder.getPath().rbegin() + 1;
-
-                    // if start point is closer to the target then last point of path (excluding target itself) then go straight on the target
-                    if (distance(position, dest) <= distance(dest, *pPointBeforeDest))
-                    {
-                        mPathFinder.clearPath();
-                        mPathFinder.addPointToPath(dest);
-                    }
-                }
+                mPathFinder.requestLimitedPath(actor, position, dest, actor.getCell(), pathfindingHalfExtents,
+                    getNavigatorFlags(actor), getAreaCosts(actor), endTolerance, pathType);
+                mDestInLOS = destInLOS;
             }
 
             if (!mPathFinder.getPath().empty()) //Path has points in it
@@ -167,6 +156,28 @@ bool MWMechanics::AiPackage::pathTo(const MWWorld::Ptr& actor, const osg::Vec3f&
         }
     }
 
+    if (mPathFinder.takeRequestedPath(actor, getPathGridGraph(actor.getCell())))
+    {
+        mRotateOnTheRunChecks = 3;
+
+        // give priority to go directly on target if there is minimal opportunity
+        if (mDestInLOS && mPathFinder.getPath().size() > 1)
+        {
+            // get point just before dest
+            auto pPointBeforeDest = mPathFinder.getPath().rbegin() + 1;
+
+            // if start point is closer to the target then last point of path (excluding target itself) then go straight on the target
+            if (distance(position, dest) <= distance(dest, *pPointBeforeDest))
+            {
+                mPathFinder.clearPath();
+                mPathFinder.addPointToPath(dest);
+            }
+        }
+
+        if (!mPathFinder.getPath().empty() && distance(dest, mPathFinder.getPath().back()) > 100)
+            mPathFinder.addPointToPath(dest);
+    }
+
     const float pointTolerance = getPointTolerance(actor.getClass().getMaxSpeed(actor), duration, halfExtents);
 
     static const bool smoothMovement = Settings::Manager::getBool("smooth movement", "Game");
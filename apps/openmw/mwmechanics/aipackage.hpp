@@ -167,6 +167,7 @@ namespace MWMechanics
             mutable int mTargetActorId;
 
             short mRotateOnTheRunChecks; // attempts to check rotation to the pathpoint on the run possibility
+            bool mDestInLOS; // if destination was in line of sight when the path was requested
 
             bool mIsShortcutting;   // if shortcutting at the moment
             bool mShortcutProhibited; // shortcutting may be prohibited after unsuccessful attempt
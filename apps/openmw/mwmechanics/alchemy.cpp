@@ -435,8 +435,7 @@ int MWMechanics::Alchemy::addIngredient (const MWWorld::Ptr& ingredient)
         return -1;
 
     for (TIngredientsIterator iter (mIngredients.begin()); iter!=mIngredients.end(); ++iter)
-        if (!iter->isEmpty() && Misc::StringUtils::ciEqual(ingredient.getCellRef().getRefId(),
-                                                           iter->getCellRef().getRefId()))
+        if (!iter->isEmpty() && ingredient.getCellRef().getInternedRefId() == iter->getCellRef().getInternedRefId())
             return -1;
 
     mIngredients[slot] = ingredient;
@@ -306,6 +306,12 @@ namespace MWMechanics
             mObjects.updateObject(old, ptr);
     }
 
+    void MechanicsManager::updatePosition(const MWWorld::Ptr& ptr)
+    {
+        if(ptr.getClass().isActor())
+            mActors.updatePosition(ptr);
+    }
+
     void MechanicsManager::drop(const MWWorld::CellStore *cellStore)
     {
         mActors.dropActors(cellStore, getPlayer());
@@ -352,6 +358,9 @@ namespace MWMechanics
 
         mActors.update(duration, paused);
         mObjects.update(duration, paused);
+
+        // Search for the paths requested by AI packages while the rest of the frame is processed
+        MWBase::Environment::get().getWorld()->getNavigator()->processPathRequests();
     }
 
     void MechanicsManager::processChangedSettings(const Settings::CategorySettingVector &changed)
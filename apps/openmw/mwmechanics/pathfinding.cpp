@@ -118,6 +118,29 @@ namespace
             return position.has_value() && std::abs((position.value() - start).length2() - (end - start).length2()) <= 1;
         }
     };
+
+    void logBuildPathError(const MWWorld::ConstPtr& actor, DetourNavigator::Status status, const osg::Vec3f& startPoint,
+        const osg::Vec3f& endPoint, DetourNavigator::Flags flags)
+    {
+        Log(Debug::Debug) << "Build path by navigator error: \"" << DetourNavigator::getMessage(status)
+            << "\" for \"" << actor.getClass().getName(actor) << "\" (" << actor.getBase()
+            << ") from " << startPoint << " to " << endPoint << " with flags ("
+            << DetourNavigator::WriteFlags {flags} << ")";
+    }
+
+    osg::Vec3f getLimitedPathEnd(const DetourNavigator::Navigator& navigator, const osg::Vec3f& startPoint,
+        const osg::Vec3f& endPoint)
+    {
+        const auto maxDistance = std::min(
+            navigator.getMaxNavmeshAreaRealRadius(),
+            static_cast<float>(Constants::CellSizeInUnits)
+        );
+        const auto startToEnd = endPoint - startPoint;
+        const auto distance = startToEnd.length();
+        if (distance <= maxDistance)
+            return endPoint;
+        return startPoint + startToEnd * maxDistance / distance;
+    }
 }
 
 namespace MWMechanics
@@ -153,7 +176,7 @@ namespace MWMechanics
      *
      * NOTE: startPoint & endPoint are in world coordinates
      *
-     * Updates mPath using aStarSearch() or ray test (if shortcut allowed).
+     * Updates mPath using PathgridGraph routes or ray test (if shortcut allowed).
      * mPath consists of pathgrid points, except the last element which is
      * endPoint.  This may be useful where the endPoint is not on a pathgrid
      * point (e.g. combat).  However, if the caller has already chosen a
@@ -220,7 +243,7 @@ namespace MWMechanics
         // AiWander has logic that depends on whether a path was created,
         // deleting allowed nodes if not.  Hence a path needs to be created
         // even if the start and the end points are the same.
-        // NOTE: aStarSearch will return an empty path if the start and end
+        // NOTE: getNextPoint will return no route if the start and end
         //       nodes are the same
         if(startNode == endNode.first)
         {
@@ -230,20 +253,20 @@ namespace MWMechanics
         }
         else
         {
-            auto path = pathgridGraph.aStarSearch(startNode, endNode.first);
+            const int secondNode = pathgridGraph.getNextPoint(startNode, endNode.first);
 
             // If nearest path node is in opposite direction from second, remove it from path.
             // Especially useful for wandering actors, if the nearest node is blocked for some reason.
-            if (path.size() > 1)
+            int firstNode = startNode;
+            if (secondNode != -1)
             {
-                ESM::Pathgrid::Point secondNode = *(++path.begin());
                 osg::Vec3f firstNodeVec3f = makeOsgVec3(pathgrid->mPoints[startNode]);
-                osg::Vec3f secondNodeVec3f = makeOsgVec3(secondNode);
+                osg::Vec3f secondNodeVec3f = makeOsgVec3(pathgrid->mPoints[secondNode]);
                 osg::Vec3f toSecondNodeVec3f = secondNodeVec3f - firstNodeVec3f;
                 osg::Vec3f toStartPointVec3f = startPointInLocalCoords - firstNodeVec3f;
                 if (toSecondNodeVec3f * toStartPointVec3f > 0)
                 {
-                    ESM::Pathgrid::Point temp(secondNode);
+                    ESM::Pathgrid::Point temp(pathgrid->mPoints[secondNode]);
                     converter.toWorld(temp);
                     // Add Z offset since path node can overlap with other objects.
                     // Also ignore doors in raytesting.
@@ -251,17 +274,17 @@ namespace MWMechanics
                     bool isPathClear = !MWBase::Environment::get().getWorld()->castRay(
                         startPoint.x(), startPoint.y(), startPoint.z() + 16, temp.mX, temp.mY, temp.mZ + 16, mask);
                     if (isPathClear)
-                        path.pop_front();
+                        firstNode = secondNode;
                 }
-            }
 
-            // convert supplied path to world coordinates
-            std::transform(path.begin(), path.end(), out,
-                [&] (ESM::Pathgrid::Point& point)
+                // walk the route converting it to world coordinates
+                for (int node = firstNode; node != -1; node = pathgridGraph.getNextPoint(node, endNode.first))
                 {
+                    ESM::Pathgrid::Point point(pathgrid->mPoints[node]);
                     converter.toWorld(point);
-                    return makeOsgVec3(point);
-                });
+                    *out++ = makeOsgVec3(point);
+                }
+            }
         }
 
         // If endNode found is NOT the closest PathGrid point to the endPoint,
@@ -358,6 +381,7 @@ namespace MWMechanics
 
     void PathFinder::buildStraightPath(const osg::Vec3f& endPoint)
     {
+        mRequestedPath.reset();
         mPath.clear();
         mPath.push_back(endPoint);
         mConstructed = true;
@@ -366,6 +390,7 @@ namespace MWMechanics
     void PathFinder::buildPathByPathgrid(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
         const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph)
     {
+        mRequestedPath.reset();
         mPath.clear();
         mCell = cell;
 
@@ -379,6 +404,7 @@ namespace MWMechanics
         const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType)
     {
         mPath.clear();
+        mRequestedPath.reset();
 
         // If it's not possible to build path over navmesh due to disabled navmesh generation fallback to straight path
         DetourNavigator::Status status = buildPathByNavigatorImpl(actor, startPoint, endPoint, halfExtents, flags,
@@ -400,6 +426,7 @@ namespace MWMechanics
     {
         mPath.clear();
         mCell = cell;
+        mRequestedPath.reset();
 
         DetourNavigator::Status status = DetourNavigator::Status::NavMeshNotFound;
 
@@ -443,12 +470,7 @@ namespace MWMechanics
             return DetourNavigator::Status::Success;
 
         if (status != DetourNavigator::Status::Success)
-        {
-            Log(Debug::Debug) << "Build path by navigator error: \"" << DetourNavigator::getMessage(status)
-                << "\" for \"" << actor.getClass().getName(actor) << "\" (" << actor.getBase()
-                << ") from " << startPoint << " to " << endPoint << " with flags ("
-                << DetourNavigator::WriteFlags {flags} << ")";
-        }
+            logBuildPathError(actor, status, startPoint, endPoint, flags);
 
         return status;
     }
@@ -477,10 +499,7 @@ namespace MWMechanics
 
         if (status != DetourNavigator::Status::Success)
         {
-            Log(Debug::Debug) << "Build path by navigator error: \"" << DetourNavigator::getMessage(status)
-                << "\" for \"" << actor.getClass().getName(actor) << "\" (" << actor.getBase()
-                << ") from " << startPoint << " to " << mPath.front() << " with flags ("
-                << DetourNavigator::WriteFlags {flags} << ")";
+            logBuildPathError(actor, status, startPoint, mPath.front(), flags);
             return;
         }
 
@@ -499,16 +518,83 @@ namespace MWMechanics
         PathType pathType)
     {
         const auto navigator = MWBase::Environment::get().getWorld()->getNavigator();
-        const auto maxDistance = std::min(
-            navigator->getMaxNavmeshAreaRealRadius(),
-            static_cast<float>(Constants::CellSizeInUnits)
-        );
-        const auto startToEnd = endPoint - startPoint;
-        const auto distance = startToEnd.length();
-        if (distance <= maxDistance)
-            return buildPath(actor, startPoint, endPoint, cell, pathgridGraph, halfExtents, flags, areaCosts,
-                             endTolerance, pathType);
-        const auto end = startPoint + startToEnd * maxDistance / distance;
+        const auto end = getLimitedPathEnd(*navigator, startPoint, endPoint);
         buildPath(actor, startPoint, end, cell, pathgridGraph, halfExtents, flags, areaCosts, endTolerance, pathType);
     }
+
+    void PathFinder::requestLimitedPath(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
+        const MWWorld::CellStore* cell, const osg::Vec3f& halfExtents, const DetourNavigator::Flags flags,
+        const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType)
+    {
+        const auto navigator = MWBase::Environment::get().getWorld()->getNavigator();
+
+        DetourNavigator::PathRequest request;
+        request.mAgentHalfExtents = halfExtents;
+        request.mStepSize = getPathStepSize(actor);
+        request.mStart = startPoint;
+        request.mEnd = getLimitedPathEnd(*navigator, startPoint, endPoint);
+        request.mIncludeFlags = flags;
+        request.mAreaCosts = areaCosts;
+        request.mEndTolerance = endTolerance;
+
+        // Pure water and flying creatures don't use navmesh, their path is completed by takeRequestedPath right away
+        const bool useNavMesh = !actor.getClass().isPureWaterCreature(actor) && !actor.getClass().isPureFlyingCreature(actor);
+        DetourNavigator::PendingPath pendingPath = useNavMesh
+            ? navigator->requestPath(request)
+            : DetourNavigator::makeProcessedPath(DetourNavigator::PathResult {});
+
+        mRequestedPath = RequestedPath {std::move(pendingPath), request, cell, pathType, useNavMesh};
+    }
+
+    bool PathFinder::takeRequestedPath(const MWWorld::ConstPtr& actor, const PathgridGraph& pathgridGraph)
+    {
+        if (!mRequestedPath.has_value())
+            return false;
+
+        if (actor.getCell() != mRequestedPath->mCell)
+        {
+            mRequestedPath.reset();
+            return false;
+        }
+
+        if (!mRequestedPath->mPendingPath.isProcessed())
+            return false;
+
+        const DetourNavigator::PathRequest request = mRequestedPath->mRequest;
+        const DetourNavigator::PathResult& result = mRequestedPath->mPendingPath.get();
+
+        DetourNavigator::Status status = result.mStatus;
+        if (mRequestedPath->mPathType == PathType::Partial && status == DetourNavigator::Status::PartialPath)
+            status = DetourNavigator::Status::Success;
+
+        if (status != DetourNavigator::Status::Success && mRequestedPath->mUseNavMesh)
+            logBuildPathError(actor, status, request.mStart, request.mEnd, request.mIncludeFlags);
+
+        // Same fallbacks as buildPath: try to use the pathgrid areas of navmesh, then the pathgrid itself
+        if (status != DetourNavigator::Status::Success && status != DetourNavigator::Status::NavMeshNotFound
+                && (request.mIncludeFlags & DetourNavigator::Flag_usePathgrid) == 0)
+        {
+            DetourNavigator::PathRequest retry = request;
+            retry.mIncludeFlags |= DetourNavigator::Flag_usePathgrid;
+            mRequestedPath->mPendingPath = MWBase::Environment::get().getWorld()->getNavigator()->requestPath(retry);
+            mRequestedPath->mRequest = retry;
+            return false;
+        }
+
+        mPath.clear();
+        mCell = mRequestedPath->mCell;
+
+        if (status == DetourNavigator::Status::Success)
+            mPath.insert(mPath.end(), result.mPath.begin(), result.mPath.end());
+
+        if (mPath.empty())
+            buildPathByPathgridImpl(request.mStart, request.mEnd, pathgridGraph, std::back_inserter(mPath));
+
+        if (status == DetourNavigator::Status::NavMeshNotFound && mPath.empty())
+            mPath.push_back(request.mEnd);
+
+        mConstructed = !mPath.empty();
+        mRequestedPath.reset();
+        return true;
+    }
 }
@@ -4,7 +4,9 @@
 #include <deque>
 #include <cassert>
 #include <iterator>
+#include <optional>
 
+#include <components/detournavigator/asyncpathfinder.hpp>
 #include <components/detournavigator/flags.hpp>
 #include <components/detournavigator/areatype.hpp>
 #include <components/detournavigator/status.hpp>
@@ -90,6 +92,7 @@ namespace MWMechanics
                 mConstructed = false;
                 mPath.clear();
                 mCell = nullptr;
+                mRequestedPath.reset();
             }
 
             void buildStraightPath(const osg::Vec3f& endPoint);
@@ -114,6 +117,23 @@ namespace MWMechanics
                 const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
                 PathType pathType);
 
+            /// Like buildLimitedPath, but the navmesh search is done in the navigator background threads together with
+            /// other requests of the frame. The current path is kept until takeRequestedPath replaces it. Building
+            /// another path cancels the request.
+            void requestLimitedPath(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
+                const MWWorld::CellStore* cell, const osg::Vec3f& halfExtents, const DetourNavigator::Flags flags,
+                const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType);
+
+            bool isPathRequested() const
+            {
+                return mRequestedPath.has_value();
+            }
+
+            /// Replace the path by the requested one if it's found, falling back to the pathgrid like buildPath.
+            /// The request is dropped when the actor is not in the cell it was made for anymore.
+            /// @return true if the path is replaced
+            bool takeRequestedPath(const MWWorld::ConstPtr& actor, const PathgridGraph& pathgridGraph);
+
             /// Remove front point if exist and within tolerance
             void update(const osg::Vec3f& position, float pointTolerance, float destinationTolerance,
                         bool shortenIfAlmostStraight, bool canMoveByZ, const osg::Vec3f& halfExtents,
@@ -210,10 +230,20 @@ namespace MWMechanics
             }
 
         private:
+            struct RequestedPath
+            {
+                DetourNavigator::PendingPath mPendingPath;
+                DetourNavigator::PathRequest mRequest;
+                const MWWorld::CellStore* mCell;
+                PathType mPathType;
+                bool mUseNavMesh;
+            };
+
             bool mConstructed;
             std::deque<osg::Vec3f> mPath;
 
             const MWWorld::CellStore* mCell;
+            std::optional<RequestedPath> mRequestedPath;
 
             void buildPathByPathgridImpl(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
                 const PathgridGraph& pathgridGraph, std::back_insert_iterator<std::deque<osg::Vec3f>> out);
@@ -1,5 +1,9 @@
 #include "pathgrid.hpp"
 
+#include <functional>
+#include <limits>
+#include <queue>
+
 #include "../mwbase/world.hpp"
 #include "../mwbase/environment.hpp"
 
@@ -119,12 +123,16 @@ namespace MWMechanics
             // forward path of the edge
             neighbour.index = mPathgrid->mEdges[i].mV1;
             mGraph[mPathgrid->mEdges[i].mV0].edges.push_back(neighbour);
+            // the same edge as seen from its destination, used to route towards a goal
+            neighbour.index = mPathgrid->mEdges[i].mV0;
+            mGraph[mPathgrid->mEdges[i].mV1].incomingEdges.push_back(neighbour);
             // reverse path of the edge
             // NOTE: These are redundant, ESM already contains the required reverse paths
             //neighbour.index = mPathgrid->mEdges[i].mV0;
             //mGraph[mPathgrid->mEdges[i].mV1].edges.push_back(neighbour);
         }
         buildConnectedPoints();
+        mNextPoints.resize(mGraph.size());
         mIsGraphConstructed = true;
         return true;
     }
@@ -229,112 +237,62 @@ namespace MWMechanics
     }
 
     /*
-     * NOTE: Based on buildPath2(), please check git history if interested
-     *       Should consider using a 3rd party library version (e.g. boost)
-     *
-     * Find the shortest path to the target goal using a well known algorithm.
-     * Uses mGraph which has pre-computed costs for allowed edges.  It is assumed
-     * that mGraph is already constructed.
-     *
-     * Should be possible to make this MT safe.
-     *
-     * Returns path which may be empty.  path contains pathgrid points in local
-     * cell coordinates (indoors) or world coordinates (external).
+     * Find the shortest paths from all points to the goal at once, using
+     * Dijkstra's algorithm over the edges reversed, and remember only the
+     * next point of each path. Uses mGraph which has pre-computed costs for
+     * allowed edges. It is assumed that mGraph is already constructed.
      *
-     * Input params:
-     *   start, goal - pathgrid point indexes (for this cell)
+     * This costs about as much as a single A* search, but the result serves
+     * every following request to the same goal. Wandering and travelling
+     * actors tend to pick their destinations from the same few points, so
+     * most requests are served from the cache.
      *
      * Variables:
-     *   openset - point indexes to be traversed, lowest cost at the front
-     *   closedset - point indexes already traversed
-     *   gScore - past accumulated costs vector indexed by point index
-     *   fScore - future estimated costs vector indexed by point index
-     *
-     * TODO: An intersting exercise might be to cache the paths created for a
-     *       start/goal pair.  To cache the results the paths need to be in
-     *       pathgrid points form (currently they are converted to world
-     *       coordinates).  Essentially trading speed w/ memory.
+     *   openset - point indexes to be traversed, lowest cost at the top
+     *   cost - accumulated cost to the goal indexed by point index
      */
-    std::deque<ESM::Pathgrid::Point> PathgridGraph::aStarSearch(const int start, const int goal) const
+    void PathgridGraph::buildNextPoints(int goal) const
     {
-        std::deque<ESM::Pathgrid::Point> path;
-        if(!isPointConnected(start, goal))
-        {
-            return path; // there is no path, return an empty path
-        }
+        std::vector<int>& nextPoints = mNextPoints[goal];
+        nextPoints.assign(mGraph.size(), -1);
 
-        int graphSize = static_cast<int> (mGraph.size());
-        std::vector<float> gScore (graphSize, -1);
-        std::vector<float> fScore (graphSize, -1);
-        std::vector<int> graphParent (graphSize, -1);
+        std::vector<float> cost(mGraph.size(), std::numeric_limits<float>::max());
+        cost[goal] = 0;
 
-        // gScore & fScore keep costs for each pathgrid point in mPoints
-        gScore[start] = 0;
-        fScore[start] = costAStar(mPathgrid->mPoints[start], mPathgrid->mPoints[goal]);
+        typedef std::pair<float, int> QueueItem; // cost, point index
+        std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> openset;
+        openset.emplace(0.f, goal);
 
-        std::list<int> openset;
-        std::list<int> closedset;
-        openset.push_back(start);
-
-        int current = -1;
-
-        while(!openset.empty())
+        while (!openset.empty())
         {
-            current = openset.front(); // front has the lowest cost
-            openset.pop_front();
+            const auto [currentCost, current] = openset.top();
+            openset.pop();
 
-            if(current == goal)
-                break;
+            if (currentCost > cost[current])
+                continue; // already reached with a lower cost
 
-            closedset.push_back(current); // remember we've been here
-
-            // check all edges for the current point index
-            for(int j = 0; j < static_cast<int> (mGraph[current].edges.size()); j++)
+            for (const ConnectedPoint& edge : mGraph[current].incomingEdges)
             {
-                if(std::find(closedset.begin(), closedset.end(), mGraph[current].edges[j].index) ==
-                   closedset.end())
+                const float tentative = currentCost + edge.cost;
+                if (tentative < cost[edge.index])
                 {
-                    // not in closedset - i.e. have not traversed this edge destination
-                    int dest = mGraph[current].edges[j].index;
-                    float tentative_g = gScore[current] + mGraph[current].edges[j].cost;
-                    bool isInOpenSet = std::find(openset.begin(), openset.end(), dest) != openset.end();
-                    if(!isInOpenSet
-                        || tentative_g < gScore[dest])
-                    {
-                        graphParent[dest] = current;
-                        gScore[dest] = tentative_g;
-                        fScore[dest] = tentative_g + costAStar(mPathgrid->mPoints[dest],
-                                                               mPathgrid->mPoints[goal]);
-                        if(!isInOpenSet)
-                        {
-                            // add this edge to openset, lowest cost goes to the front
-                            // TODO: if this causes performance problems a hash table may help
-                            std::list<int>::iterator it = openset.begin();
-                            for(it = openset.begin(); it!= openset.end(); ++it)
-                            {
-                                if(fScore[*it] > fScore[dest])
-                                    break;
-                            }
-                            openset.insert(it, dest);
-                        }
-                    }
-                } // if in closedset, i.e. traversed this edge already, try the next edge
+                    cost[edge.index] = tentative;
+                    nextPoints[edge.index] = current;
+                    openset.emplace(tentative, edge.index);
+                }
             }
         }
+    }
 
-        if(current != goal)
-            return path; // for some reason couldn't build a path
+    int PathgridGraph::getNextPoint(const int current, const int goal) const
+    {
+        if (current == goal || !isPointConnected(current, goal))
+            return -1;
 
-        // reconstruct path to return, using local coordinates
-        while(graphParent[current] != -1)
-        {
-            path.push_front(mPathgrid->mPoints[current]);
-            current = graphParent[current];
-        }
+        if (mNextPoints[goal].empty())
+            buildNextPoints(goal);
 
-        // add first node to path explicitly
-        path.push_front(mPathgrid->mPoints[start]);
-        return path;
+        return mNextPoints[goal][current];
     }
 }
 
@@ -1,7 +1,7 @@
 #ifndef GAME_MWMECHANICS_PATHGRID_H
 #define GAME_MWMECHANICS_PATHGRID_H
 
-#include <deque>
+#include <vector>
 
 #include <components/esm3/loadpgrd.hpp>
 
@@ -33,12 +33,14 @@ namespace MWMechanics
             // get neighbouring nodes for index node and put them to "nodes" vector
             void getNeighbouringPoints(const int index, ESM::Pathgrid::PointList &nodes) const;
 
-            // the input parameters are pathgrid point indexes
-            // the output list is in local (internal cells) or world (external
-            // cells) coordinates
+            // returns the pathgrid point index following current on the
+            // shortest path to goal, goal itself if they are neighbours, or -1
+            // if goal is not reachable or equals current
             //
-            // NOTE: if start equals end an empty path is returned
-            std::deque<ESM::Pathgrid::Point> aStarSearch(const int start, const int end) const;
+            // The path is walked by calling it until goal is returned. Routes
+            // to a goal are computed once on the first request and cached, so
+            // each step is a table lookup. Not thread safe.
+            int getNextPoint(const int current, const int goal) const;
 
         private:
 
@@ -55,6 +57,7 @@ namespace MWMechanics
             {
                 int componentId;
                 std::vector<ConnectedPoint> edges; // neighbours
+                std::vector<ConnectedPoint> incomingEdges; // points having this one as a neighbour
             };
 
             // componentId is an integer indicating the groups of connected
@@ -69,6 +72,11 @@ namespace MWMechanics
             std::vector<Node> mGraph;
             bool mIsGraphConstructed;
 
+            // mNextPoints[goal][v] is the point following v on the shortest
+            // path to goal, the vector is empty until a path to goal is requested
+            mutable std::vector<std::vector<int>> mNextPoints;
+            void buildNextPoints(int goal) const;
+
             // variables used to calculate connected components
             int mSCCId;
             int mSCCIndex;
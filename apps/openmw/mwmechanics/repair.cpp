@@ -92,7 +92,7 @@ void Repair::repair(const MWWorld::Ptr &itemToRepair)
         for (MWWorld::ContainerStoreIterator iter (store.begin());
              iter!=store.end(); ++iter)
         {
-            if (Misc::StringUtils::ciEqual(iter->getCellRef().getRefId(), mTool.getCellRef().getRefId()))
+            if (iter->getCellRef().getInternedRefId() == mTool.getCellRef().getInternedRefId())
             {
                 mTool = *iter;
 
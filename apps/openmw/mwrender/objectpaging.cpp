@@ -842,6 +842,11 @@ namespace MWRender
     void ObjectPaging::reportStats(unsigned int frameNumber, osg::Stats *stats) const
     {
         stats->setAttribute(frameNumber, "Object Chunk", mCache->getCacheSize());
+
+        const auto cacheStats = mCache->takeStats();
+        stats->setAttribute(frameNumber, "Object Chunk Hits", cacheStats.mHits);
+        stats->setAttribute(frameNumber, "Object Chunk Misses", cacheStats.mMisses);
+        stats->setAttribute(frameNumber, "Object Chunk Contentions", cacheStats.mContentions);
     }
 
 }
@@ -11,6 +11,8 @@
 #include <components/interpreter/runtime.hpp>
 #include <components/interpreter/opcodes.hpp>
 
+#include <components/misc/stringops.hpp>
+
 #include "../mwworld/class.hpp"
 #include "../mwworld/esmstore.hpp"
 
@@ -475,7 +477,7 @@ namespace MWScript
                         MWWorld::Ptr targetPtr;
                         if (creatureStats.getAiSequence().getCombatTarget(targetPtr))
                         {
-                            if (!targetPtr.isEmpty() && targetPtr.getCellRef().getRefId() == testedTargetId)
+                            if (!targetPtr.isEmpty() && Misc::StringUtils::ciEqual(targetPtr.getCellRef().getRefId(), testedTargetId))
                                 targetsAreEqual = true;
                         }
                         else if (testedTargetId == "player") // Currently the player ID is hardcoded
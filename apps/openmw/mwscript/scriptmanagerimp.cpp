@@ -4,16 +4,20 @@
 #include <sstream>
 #include <exception>
 #include <algorithm>
+#include <mutex>
+#include <thread>
 
 #include <components/debug/debuglog.hpp>
 
 #include <components/esm3/loadscpt.hpp>
 
 #include <components/misc/stringops.hpp>
+#include <components/misc/threadpool.hpp>
 
 #include <components/compiler/scanner.hpp>
 #include <components/compiler/context.hpp>
 #include <components/compiler/exception.hpp>
+#include <components/compiler/fileparser.hpp>
 #include <components/compiler/quickfileparser.hpp>
 
 #include "../mwworld/esmstore.hpp"
@@ -23,11 +27,52 @@
 
 namespace MWScript
 {
+namespace
+{
+    /// Lets several threads compile scripts with the same context. The lookups read the world and parse the locals
+    /// of other scripts, so only one of them is done at a time.
+    class SynchronizedCompilerContext : public Compiler::Context
+    {
+            const Compiler::Context& mContext;
+            mutable std::mutex mMutex;
+
+        public:
+
+            explicit SynchronizedCompilerContext (const Compiler::Context& context) : mContext (context)
+            {
+                setExtensions (context.getExtensions());
+            }
+
+            bool canDeclareLocals() const override
+            {
+                return mContext.canDeclareLocals();
+            }
+
+            char getGlobalType (const std::string& name) const override
+            {
+                const std::lock_guard<std::mutex> lock (mMutex);
+                return mContext.getGlobalType (name);
+            }
+
+            std::pair<char, bool> getMemberType (const std::string& name, const std::string& id) const override
+            {
+                const std::lock_guard<std::mutex> lock (mMutex);
+                return mContext.getMemberType (name, id);
+            }
+
+            bool isId (const std::string& name) const override
+            {
+                const std::lock_guard<std::mutex> lock (mMutex);
+                return mContext.isId (name);
+            }
+    };
+}
+
     ScriptManager::ScriptManager (const MWWorld::ESMStore& store,
         Compiler::Context& compilerContext, int warningsMode,
-        const std::vector<std::string>& scriptBlacklist)
+        const std::vector<std::string>& scriptBlacklist, Compiler::ScriptCache* scriptCache)
     : mErrorHandler(), mStore (store),
-      mCompilerContext (compilerContext), mParser (mErrorHandler, mCompilerContext),
+      mCompilerContext (compilerContext), mWarningsMode (warningsMode), mScriptCache (scriptCache),
       mOpcodesInstalled (false), mGlobalScripts (store)
     {
         mErrorHandler.setWarningsMode (warningsMode);
@@ -39,48 +84,70 @@ namespace MWScript
         std::sort (mScriptBlacklist.begin(), mScriptBlacklist.end());
     }
 
-    bool ScriptManager::compile (const std::string& name)
+    std::optional<Compiler::CompiledScript> ScriptManager::compile (const ESM::Script& script,
+        Compiler::Context& compilerContext) const
     {
-        mParser.reset();
-        mErrorHandler.reset();
+        Compiler::StreamErrorHandler errorHandler;
+        errorHandler.setWarningsMode (mWarningsMode);
+        errorHandler.setContext (script.mId);
 
-        if (const ESM::Script *script = mStore.get<ESM::Script>().find (name))
-        {
-            mErrorHandler.setContext(name);
+        Compiler::FileParser parser (errorHandler, compilerContext);
 
-            bool Success = true;
-            try
-            {
-                std::istringstream input (script->mScriptText);
+        bool Success = true;
+        try
+        {
+            std::istringstream input (script.mScriptText);
 
-                Compiler::Scanner scanner (mErrorHandler, input, mCompilerContext.getExtensions());
+            Compiler::Scanner scanner (errorHandler, input, compilerContext.getExtensions());
 
-                scanner.scan (mParser);
+            scanner.scan (parser);
 
-                if (!mErrorHandler.isGood())
-                    Success = false;
-            }
-            catch (const Compiler::SourceException&)
-            {
-                // error has already been reported via error handler
-                Success = false;
-            }
-            catch (const std::exception& error)
-            {
-                Log(Debug::Error) << "Error: An exception has been thrown: " << error.what();
+            if (!errorHandler.isGood())
                 Success = false;
-            }
+        }
+        catch (const Compiler::SourceException&)
+        {
+            // error has already been reported via error handler
+            Success = false;
+        }
+        catch (const std::exception& error)
+        {
+            Log(Debug::Error) << "Error: An exception has been thrown: " << error.what();
+            Success = false;
+        }
+
+        if (!Success)
+        {
+            Log(Debug::Error) << "Error: script compiling failed: " << script.mId;
+            return {};
+        }
 
-            if (!Success)
+        Compiler::CompiledScript result;
+        parser.getCode (result.mByteCode);
+        result.mLocals = parser.getLocals();
+        return result;
+    }
+
+    bool ScriptManager::compile (const std::string& name)
+    {
+        if (const ESM::Script *script = mStore.get<ESM::Script>().find (name))
+        {
+            std::optional<Compiler::CompiledScript> compiled;
+
+            if (mScriptCache)
+                compiled = mScriptCache->get (script->mId, script->mScriptText);
+
+            if (!compiled)
             {
-                Log(Debug::Error) << "Error: script compiling failed: " << name;
+                compiled = compile (*script, mCompilerContext);
+
+                if (compiled && mScriptCache)
+                    mScriptCache->set (script->mId, script->mScriptText, *compiled);
             }
 
-            if (Success)
+            if (compiled)
             {
-                std::vector<Interpreter::Type_Code> code;
-                mParser.getCode(code);
-                mScripts.emplace(name, CompiledScript(code, mParser.getLocals()));
+                mScripts.emplace(name, CompiledScript(compiled->mByteCode, compiled->mLocals));
 
                 return true;
             }
@@ -119,7 +186,14 @@ namespace MWScript
                     mOpcodesInstalled = true;
                 }
 
-                mInterpreter.run (&iter->second.mByteCode[0], iter->second.mByteCode.size(), interpreterContext);
+                CompiledScript& script = iter->second;
+                if (!script.mDecoded)
+                {
+                    script.mInstructions = mInterpreter.decode (&script.mByteCode[0], script.mByteCode.size());
+                    script.mDecoded = true;
+                }
+
+                mInterpreter.run (&script.mByteCode[0], script.mByteCode.size(), script.mInstructions, interpreterContext);
                 return true;
             }
             catch (const MissingImplicitRefError& e)
@@ -150,6 +224,8 @@ namespace MWScript
         int count = 0;
         int success = 0;
 
+        std::vector<const ESM::Script*> pending;
+
         for (auto& script : mStore.get<ESM::Script>())
         {
             if (!std::binary_search (mScriptBlacklist.begin(), mScriptBlacklist.end(),
@@ -157,11 +233,45 @@ namespace MWScript
             {
                 ++count;
 
-                if (compile(script.mId))
+                std::optional<Compiler::CompiledScript> compiled;
+
+                if (mScriptCache)
+                    compiled = mScriptCache->get (script.mId, script.mScriptText);
+
+                if (compiled)
+                {
+                    mScripts.emplace(script.mId, CompiledScript(compiled->mByteCode, compiled->mLocals));
                     ++success;
+                }
+                else
+                    pending.push_back (&script);
             }
         }
 
+        // Compiled scripts are added to the collection only after all threads are done, the compiler context reads
+        // it when looking up locals of other scripts
+        std::vector<std::optional<Compiler::CompiledScript>> compiled (pending.size());
+        {
+            SynchronizedCompilerContext compilerContext (mCompilerContext);
+            Misc::ThreadPool threadPool (std::max (1u, std::thread::hardware_concurrency()) - 1);
+            threadPool.run (pending.size(), [&] (std::size_t i)
+            {
+                compiled[i] = compile (*pending[i], compilerContext);
+            });
+        }
+
+        for (std::size_t i = 0; i < pending.size(); ++i)
+        {
+            if (!compiled[i])
+                continue;
+
+            if (mScriptCache)
+                mScriptCache->set (pending[i]->mId, pending[i]->mScriptText, *compiled[i]);
+
+            mScripts.emplace(pending[i]->mId, CompiledScript(compiled[i]->mByteCode, compiled[i]->mLocals));
+            ++success;
+        }
+
         return std::make_pair (count, success);
     }
 
@@ -2,11 +2,12 @@
 #define GAME_SCRIPT_SCRIPTMANAGER_H
 
 #include <map>
+#include <optional>
 #include <set>
 #include <string>
 
 #include <components/compiler/streamerrorhandler.hpp>
-#include <components/compiler/fileparser.hpp>
+#include <components/compiler/scriptcache.hpp>
 
 #include <components/interpreter/interpreter.hpp>
 #include <components/interpreter/types.hpp>
@@ -20,6 +21,11 @@ namespace MWWorld
     class ESMStore;
 }
 
+namespace ESM
+{
+    struct Script;
+}
+
 namespace Compiler
 {
     class Context;
@@ -38,18 +44,21 @@ namespace MWScript
             Compiler::StreamErrorHandler mErrorHandler;
             const MWWorld::ESMStore& mStore;
             Compiler::Context& mCompilerContext;
-            Compiler::FileParser mParser;
+            int mWarningsMode;
+            Compiler::ScriptCache* mScriptCache;
             Interpreter::Interpreter mInterpreter;
             bool mOpcodesInstalled;
 
             struct CompiledScript
             {
                 std::vector<Interpreter::Type_Code> mByteCode;
+                std::vector<Interpreter::Instruction> mInstructions; ///< decoded on the first run
+                bool mDecoded;
                 Compiler::Locals mLocals;
                 std::set<std::string> mInactive;
 
                 CompiledScript(const std::vector<Interpreter::Type_Code>& code, const Compiler::Locals& locals):
-                    mByteCode(code), mLocals(locals)
+                    mByteCode(code), mDecoded(false), mLocals(locals)
                 {}
             };
 
@@ -60,11 +69,16 @@ namespace MWScript
             std::map<std::string, Compiler::Locals> mOtherLocals;
             std::vector<std::string> mScriptBlacklist;
 
+            std::optional<Compiler::CompiledScript> compile (const ESM::Script& script,
+                Compiler::Context& compilerContext) const;
+            ///< Compile \a script, reporting errors through a separate error handler.
+
         public:
 
             ScriptManager (const MWWorld::ESMStore& store,
                 Compiler::Context& compilerContext, int warningsMode,
-                const std::vector<std::string>& scriptBlacklist);
+                const std::vector<std::string>& scriptBlacklist, Compiler::ScriptCache* scriptCache = nullptr);
+            ///< \param scriptCache Compiled scripts are taken from and added to it, if not null.
 
             void clear() override;
 
@@ -76,7 +90,7 @@ namespace MWScript
             /// \return Success?
 
             std::pair<int, int> compileAll() override;
-            ///< Compile all scripts
+            ///< Compile all scripts, the ones not found in the script cache in parallel
             /// \return count, success
 
             const Compiler::Locals& getLocals (const std::string& name) override;
@@ -86,6 +86,10 @@ namespace MWWorld
 
             ListModelsVisitor visitor (mMeshes);
             cell->forEach(visitor);
+
+            // Correct the paths before they are prefetched, so that the prefetched files are the ones loaded later
+            for (std::string& mesh : mMeshes)
+                mesh = Misc::ResourceHelpers::correctActorModelPath(mesh, mSceneManager->getVFS());
         }
 
         void abort() override
@@ -93,6 +97,11 @@ namespace MWWorld
             mAbort = true;
         }
 
+        const std::vector<std::string>& getMeshes() const
+        {
+            return mMeshes;
+        }
+
         /// Preload work to be called from the worker thread.
         void doWork() override
         {
@@ -115,8 +124,6 @@ namespace MWWorld
 
                 try
                 {
-                    mesh = Misc::ResourceHelpers::correctActorModelPath(mesh, mSceneManager->getVFS());
-
                     size_t slashpos = mesh.find_last_of("/\\");
                     if (slashpos != std::string::npos && slashpos != mesh.size()-1)
                     {
@@ -311,6 +318,8 @@ namespace MWWorld
         }
 
         osg::ref_ptr<PreloadItem> item (new PreloadItem(cell, mResourceSystem->getSceneManager(), mBulletShapeManager, mResourceSystem->getKeyframeManager(), mTerrain, mLandManager, mPreloadInstances));
+        // Queue decompressing the meshes ahead of the preload item, so that the preloading threads share that work
+        mResourceSystem->prefetchFiles(item->getMeshes(), *mWorkQueue);
         mWorkQueue->addWorkItem(item);
 
         mPreloadCells[cell] = PreloadEntry(timestamp, item);
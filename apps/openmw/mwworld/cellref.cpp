@@ -33,6 +33,12 @@ namespace MWWorld
         mCellRef.mRefNum.unset();
     }
 
+    void CellRef::setRefNum(const ESM::RefNum& refNum)
+    {
+        mCellRef.mRefNum = refNum;
+        mChanged = true;
+    }
+
     void CellRef::setScale(float scale)
     {
         if (scale != mCellRef.mScale)
@@ -197,6 +203,7 @@ namespace MWWorld
     void CellRef::writeState(ESM::ObjectState &state) const
     {
         state.mRef = mCellRef;
+        state.mRef.mRefID = mRefId.getString();
     }
 
 }
@@ -1,6 +1,7 @@
 #ifndef OPENMW_MWWORLD_CELLREF_H
 #define OPENMW_MWWORLD_CELLREF_H
 
+#include <components/esm/refid.hpp>
 #include <components/esm3/cellref.hpp>
 
 namespace ESM
@@ -18,8 +19,11 @@ namespace MWWorld
 
         CellRef (const ESM::CellRef& ref)
             : mCellRef(ref)
+            , mRefId(ESM::RefId::intern(ref.mRefID))
         {
             mChanged = false;
+            // The interned ID is the only copy kept, see getRefId and writeState
+            std::string().swap(mCellRef.mRefID);
         }
 
         // Note: Currently unused for items in containers
@@ -32,11 +36,17 @@ namespace MWWorld
         // Set RefNum to its default state.
         void unsetRefNum();
 
+        // Set RefNum to one generated elsewhere, such as by a shard of local Lua scripts.
+        void setRefNum(const ESM::RefNum& refNum);
+
         /// Does the RefNum have a content file?
         bool hasContentFile() const { return mCellRef.mRefNum.hasContentFile(); }
 
-        // Id of object being referenced
-        const std::string& getRefId() const { return mCellRef.mRefID; }
+        // Id of object being referenced, lower-cased
+        const std::string& getRefId() const { return mRefId.getString(); }
+
+        // Interned id of object being referenced, for comparisons ignoring case
+        ESM::RefId getInternedRefId() const { return mRefId; }
 
         // For doors - true if this door teleports to somewhere else, false
         // if it should open through animation.
@@ -122,7 +132,8 @@ namespace MWWorld
 
     private:
         bool mChanged;
-        ESM::CellRef mCellRef;
+        ESM::CellRef mCellRef; ///< mRefID is left empty, mRefId holds it
+        ESM::RefId mRefId;
     };
 
 }
@@ -1,18 +1,18 @@
 #ifndef GAME_MWWORLD_CELLREFLIST_H
 #define GAME_MWWORLD_CELLREFLIST_H
 
-#include <list>
-
 #include "livecellref.hpp"
+#include "stablelist.hpp"
 
 namespace MWWorld
 {
     /// \brief Collection of references of one type
+    /// \note References are stored contiguously and never move, so Ptrs to them stay valid until they are removed.
     template <typename X>
     struct CellRefList
     {
         typedef LiveCellRef<X> LiveRef;
-        typedef std::list<LiveRef> List;
+        typedef StableList<LiveRef> List;
         List mList;
 
         /// Search for the given reference in the given reclist from
@@ -26,8 +26,7 @@ namespace MWWorld
 
         LiveRef &insert (const LiveRef &item)
         {
-            mList.push_back(item);
-            return mList.back();
+            return *mList.insert(item);
         }
 
         /// Remove all references with the given refNum from this list.
@@ -19,7 +19,7 @@
 namespace
 {
     template<class Visitor, class Key>
-    bool forEachInStore(const std::string& id, Visitor&& visitor, std::map<Key, MWWorld::CellStore>& cellStore)
+    bool forEachInStore(ESM::RefId id, Visitor&& visitor, std::map<Key, MWWorld::CellStore>& cellStore)
     {
         for(auto& cell : cellStore)
         {
@@ -36,7 +36,7 @@ namespace
             }
             bool cont = cell.second.forEach([&] (MWWorld::Ptr ptr)
             {
-                if (ptr.getCellRef().getRefId() == id)
+                if (ptr.getCellRef().getInternedRefId() == id)
                 {
                     return visitor(ptr);
                 }
@@ -377,9 +377,12 @@ void MWWorld::Cells::getInteriorPtrs(const std::string &name, std::vector<MWWorl
 
 std::vector<MWWorld::Ptr> MWWorld::Cells::getAll(const std::string& id)
 {
+    const std::optional<ESM::RefId> refId = ESM::RefId::search(id);
+    if (!refId.has_value())
+        return {};
     PtrCollector visitor;
-    if(forEachInStore(id, visitor, mInteriors))
-        forEachInStore(id, visitor, mExteriors);
+    if(forEachInStore(*refId, visitor, mInteriors))
+        forEachInStore(*refId, visitor, mExteriors);
     return visitor.mPtrs;
 }
 
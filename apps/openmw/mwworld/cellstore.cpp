@@ -190,7 +190,7 @@ namespace
         {
             for (typename MWWorld::CellRefList<T>::List::iterator iter (collection.mList.begin());
                 iter!=collection.mList.end(); ++iter)
-                if (iter->mRef.getRefNum()==state.mRef.mRefNum && iter->mRef.getRefId() == state.mRef.mRefID)
+                if (iter->mRef.getRefNum()==state.mRef.mRefNum && Misc::StringUtils::ciEqual(iter->mRef.getRefId(), state.mRef.mRefID))
                 {
                     // overwrite existing reference
                     float oldscale = iter->mRef.getScale();
@@ -217,9 +217,7 @@ namespace
         // new reference
         MWWorld::LiveCellRef<T> ref (record);
         ref.load (state);
-        collection.mList.push_back (ref);
-
-        MWWorld::LiveCellRefBase* base = &collection.mList.back();
+        MWWorld::LiveCellRefBase* base = &*collection.mList.insert (ref);
         MWBase::Environment::get().getLuaManager()->registerObject(MWWorld::Ptr(base, cellstore));
     }
 }
@@ -234,7 +232,7 @@ namespace MWWorld
 
         if (const X *ptr = store.search (ref.mRefID))
         {
-            typename std::list<LiveRef>::iterator iter =
+            typename List::iterator iter =
                 std::find(mList.begin(), mList.end(), ref.mRefNum);
 
             LiveRef liveCellRef (ref, ptr);
@@ -245,7 +243,7 @@ namespace MWWorld
             if (iter != mList.end())
                 *iter = liveCellRef;
             else
-                mList.push_back (liveCellRef);
+                mList.insert (liveCellRef);
         }
         else
         {
@@ -343,7 +341,7 @@ namespace MWWorld
 
         bool operator() (const MWWorld::Ptr& ptr)
         {
-            if (mMovedToAnotherCell.find(ptr.getBase()) != mMovedToAnotherCell.end())
+            if (!mMovedToAnotherCell.empty() && mMovedToAnotherCell.find(ptr.getBase()) != mMovedToAnotherCell.end())
                 return true;
             mMergeTo.push_back(ptr.getBase());
             return true;
@@ -398,7 +396,7 @@ namespace MWWorld
         return mState;
     }
 
-    const std::vector<std::string> &CellStore::getPreloadedIds() const
+    const std::vector<ESM::RefId> &CellStore::getPreloadedIds() const
     {
         return mIds;
     }
@@ -408,7 +406,7 @@ namespace MWWorld
         return mHasState;
     }
 
-    bool CellStore::hasId (const std::string& id) const
+    bool CellStore::hasId (ESM::RefId id) const
     {
         if (mState==State_Unloaded)
             return false;
@@ -419,14 +417,21 @@ namespace MWWorld
         return searchConst (id).isEmpty();
     }
 
+    bool CellStore::hasId (std::string_view id) const
+    {
+        // Every reference interns its ID, so an ID that was never interned can't be in this cell
+        const std::optional<ESM::RefId> refId = ESM::RefId::search (id);
+        return refId.has_value() && hasId (*refId);
+    }
+
     template <typename PtrType>
     struct SearchVisitor
     {
         PtrType mFound;
-        const std::string *mIdToFind;
+        ESM::RefId mIdToFind;
         bool operator()(const PtrType& ptr)
         {
-            if (ptr.getCellRef().getRefId() == *mIdToFind)
+            if (ptr.getCellRef().getInternedRefId() == mIdToFind)
             {
                 mFound = ptr;
                 return false;
@@ -435,22 +440,36 @@ namespace MWWorld
         }
     };
 
-    Ptr CellStore::search (const std::string& id)
+    Ptr CellStore::search (ESM::RefId id)
     {
         SearchVisitor<MWWorld::Ptr> searchVisitor;
-        searchVisitor.mIdToFind = &id;
+        searchVisitor.mIdToFind = id;
         forEach(searchVisitor);
         return searchVisitor.mFound;
     }
 
-    ConstPtr CellStore::searchConst (const std::string& id) const
+    Ptr CellStore::search (std::string_view id)
+    {
+        if (const std::optional<ESM::RefId> refId = ESM::RefId::search (id))
+            return search (*refId);
+        return Ptr();
+    }
+
+    ConstPtr CellStore::searchConst (ESM::RefId id) const
     {
         SearchVisitor<MWWorld::ConstPtr> searchVisitor;
-        searchVisitor.mIdToFind = &id;
+        searchVisitor.mIdToFind = id;
         forEachConst(searchVisitor);
         return searchVisitor.mFound;
     }
 
+    ConstPtr CellStore::searchConst (std::string_view id) const
+    {
+        if (const std::optional<ESM::RefId> refId = ESM::RefId::search (id))
+            return searchConst (*refId);
+        return ConstPtr();
+    }
+
     Ptr CellStore::searchViaActorId (int id)
     {
         if (Ptr ptr = ::searchViaActorId (mNpcs, id, this, mMovedToAnotherCell))
@@ -575,8 +594,7 @@ namespace MWWorld
                         continue;
                     }
 
-                    Misc::StringUtils::lowerCaseInPlace(ref.mRefID);
-                    mIds.push_back(std::move(ref.mRefID));
+                    mIds.push_back(ESM::RefId::intern(ref.mRefID));
                 }
             }
             catch (std::exception& e)
@@ -589,7 +607,7 @@ namespace MWWorld
         for (const auto& [ref, deleted]: mCell->mLeasedRefs)
         {
             if (!deleted)
-                mIds.push_back(Misc::StringUtils::lowerCase(ref.mRefID));
+                mIds.push_back(ESM::RefId::intern(ref.mRefID));
         }
 
         std::sort (mIds.begin(), mIds.end());
@@ -604,7 +622,7 @@ namespace MWWorld
         if (mCell->mContextList.empty())
             return; // this is a dynamically generated cell -> skipping.
 
-        std::map<ESM::RefNum, std::string> refNumToID; // used to detect refID modifications
+        std::map<ESM::RefNum, ESM::RefId> refNumToID; // used to detect refID modifications
 
         // Load references from all plugins that do something with this cell.
         for (size_t i = 0; i < mCell->mContextList.size(); i++)
@@ -681,16 +699,17 @@ namespace MWWorld
         return Ptr();
     }
 
-    void CellStore::loadRef (ESM::CellRef& ref, bool deleted, std::map<ESM::RefNum, std::string>& refNumToID)
+    void CellStore::loadRef (ESM::CellRef& ref, bool deleted, std::map<ESM::RefNum, ESM::RefId>& refNumToID)
     {
         Misc::StringUtils::lowerCaseInPlace (ref.mRefID);
+        const ESM::RefId refId = ESM::RefId::intern (ref.mRefID);
 
         const MWWorld::ESMStore& store = mStore;
 
-        std::map<ESM::RefNum, std::string>::iterator it = refNumToID.find(ref.mRefNum);
+        std::map<ESM::RefNum, ESM::RefId>::iterator it = refNumToID.find(ref.mRefNum);
         if (it != refNumToID.end())
         {
-            if (it->second != ref.mRefID)
+            if (it->second != refId)
             {
                 // refID was modified, make sure we don't end up with duplicated refs
                 switch (store.find(it->second))
@@ -722,7 +741,7 @@ namespace MWWorld
             }
         }
 
-        switch (store.find (ref.mRefID))
+        switch (store.find (refId))
         {
             case ESM::REC_ACTI: mActivators.load(ref, deleted, store); break;
             case ESM::REC_ALCH: mPotions.load(ref, deleted,store); break;
@@ -753,7 +772,7 @@ namespace MWWorld
                 return;
         }
 
-        refNumToID[ref.mRefNum] = ref.mRefID;
+        refNumToID[ref.mRefNum] = refId;
     }
 
     void CellStore::loadState (const ESM::CellState& state)
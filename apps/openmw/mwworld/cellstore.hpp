@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <typeinfo>
 #include <map>
 #include <memory>
@@ -11,6 +12,8 @@
 #include "livecellref.hpp"
 #include "cellreflist.hpp"
 
+#include <components/esm/refid.hpp>
+
 #include <components/esm3/loadacti.hpp>
 #include <components/esm3/loadalch.hpp>
 #include <components/esm3/loadappa.hpp>
@@ -71,7 +74,7 @@ namespace MWWorld
             const ESM::Cell *mCell;
             State mState;
             bool mHasState;
-            std::vector<std::string> mIds;
+            std::vector<ESM::RefId> mIds;
             float mWaterLevel;
 
             MWWorld::TimeStamp mLastRespawn;
@@ -219,27 +222,33 @@ namespace MWWorld
 
             State getState() const;
 
-            const std::vector<std::string>& getPreloadedIds() const;
+            const std::vector<ESM::RefId>& getPreloadedIds() const;
             ///< Get Ids of objects in this cell, only valid in State_Preloaded
 
             bool hasState() const;
             ///< Does this cell have state that needs to be stored in a saved game file?
 
-            bool hasId (const std::string& id) const;
+            bool hasId (ESM::RefId id) const;
             ///< May return true for deleted IDs when in preload state. Will return false, if cell is
             /// unloaded.
             /// @note Will not account for moved references which may exist in Loaded state. Use search() instead if the cell is loaded.
 
-            Ptr search (const std::string& id);
+            bool hasId (std::string_view id) const;
+
+            Ptr search (ESM::RefId id);
             ///< Will return an empty Ptr if cell is not loaded. Does not check references in
             /// containers.
             /// @note Triggers CellStore hasState flag.
 
-            ConstPtr searchConst (const std::string& id) const;
+            Ptr search (std::string_view id);
+
+            ConstPtr searchConst (ESM::RefId id) const;
             ///< Will return an empty Ptr if cell is not loaded. Does not check references in
             /// containers.
             /// @note Does not trigger CellStore hasState flag.
 
+            ConstPtr searchConst (std::string_view id) const;
+
             Ptr searchViaActorId (int id);
             ///< Will return an empty Ptr if cell is not loaded.
 
@@ -340,7 +349,7 @@ namespace MWWorld
                 for (typename CellRefList<T>::List::iterator it (list.mList.begin()); it!=list.mList.end(); ++it)
                 {
                     LiveCellRefBase* base = &*it;
-                    if (mMovedToAnotherCell.find(base) != mMovedToAnotherCell.end())
+                    if (!mMovedToAnotherCell.empty() && mMovedToAnotherCell.find(base) != mMovedToAnotherCell.end())
                         continue;
                     if (!isAccessible(base->mData, base->mRef))
                         continue;
@@ -406,7 +415,7 @@ namespace MWWorld
 
             void loadRefs();
 
-            void loadRef (ESM::CellRef& ref, bool deleted, std::map<ESM::RefNum, std::string>& refNumToID);
+            void loadRef (ESM::CellRef& ref, bool deleted, std::map<ESM::RefNum, ESM::RefId>& refNumToID);
             ///< Make case-adjustments to \a ref and insert it into the respective container.
             ///
             /// Invalid \a ref objects are silently dropped.
@@ -99,9 +99,7 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::getState (CellRefList<T
 
     LiveCellRef<T> ref (record);
     ref.load (state);
-    collection.mList.push_back (ref);
-
-    return ContainerStoreIterator (this, --collection.mList.end());
+    return ContainerStoreIterator (this, collection.mList.insert (ref));
 }
 
 void MWWorld::ContainerStore::storeEquipmentState(const MWWorld::LiveCellRefBase &ref, int index, ESM::InventoryState &inventory) const
@@ -397,18 +395,18 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::addNewStack (const Cons
 
     switch (getType(ptr))
     {
-        case Type_Potion: potions.mList.push_back (*ptr.get<ESM::Potion>()); it = ContainerStoreIterator(this, --potions.mList.end()); break;
-        case Type_Apparatus: appas.mList.push_back (*ptr.get<ESM::Apparatus>()); it = ContainerStoreIterator(this, --appas.mList.end()); break;
-        case Type_Armor: armors.mList.push_back (*ptr.get<ESM::Armor>()); it = ContainerStoreIterator(this, --armors.mList.end()); break;
-        case Type_Book: books.mList.push_back (*ptr.get<ESM::Book>()); it = ContainerStoreIterator(this, --books.mList.end()); break;
-        case Type_Clothing: clothes.mList.push_back (*ptr.get<ESM::Clothing>()); it = ContainerStoreIterator(this, --clothes.mList.end()); break;
-        case Type_Ingredient: ingreds.mList.push_back (*ptr.get<ESM::Ingredient>()); it = ContainerStoreIterator(this, --ingreds.mList.end()); break;
-        case Type_Light: lights.mList.push_back (*ptr.get<ESM::Light>()); it = ContainerStoreIterator(this, --lights.mList.end()); break;
-        case Type_Lockpick: lockpicks.mList.push_back (*ptr.get<ESM::Lockpick>()); it = ContainerStoreIterator(this, --lockpicks.mList.end()); break;
-        case Type_Miscellaneous: miscItems.mList.push_back (*ptr.get<ESM::Miscellaneous>()); it = ContainerStoreIterator(this, --miscItems.mList.end()); break;
-        case Type_Probe: probes.mList.push_back (*ptr.get<ESM::Probe>()); it = ContainerStoreIterator(this, --probes.mList.end()); break;
-        case Type_Repair: repairs.mList.push_back (*ptr.get<ESM::Repair>()); it = ContainerStoreIterator(this, --repairs.mList.end()); break;
-        case Type_Weapon: weapons.mList.push_back (*ptr.get<ESM::Weapon>()); it = ContainerStoreIterator(this, --weapons.mList.end()); break;
+        case Type_Potion: it = ContainerStoreIterator(this, potions.mList.insert(*ptr.get<ESM::Potion>())); break;
+        case Type_Apparatus: it = ContainerStoreIterator(this, appas.mList.insert(*ptr.get<ESM::Apparatus>())); break;
+        case Type_Armor: it = ContainerStoreIterator(this, armors.mList.insert(*ptr.get<ESM::Armor>())); break;
+        case Type_Book: it = ContainerStoreIterator(this, books.mList.insert(*ptr.get<ESM::Book>())); break;
+        case Type_Clothing: it = ContainerStoreIterator(this, clothes.mList.insert(*ptr.get<ESM::Clothing>())); break;
+        case Type_Ingredient: it = ContainerStoreIterator(this, ingreds.mList.insert(*ptr.get<ESM::Ingredient>())); break;
+        case Type_Light: it = ContainerStoreIterator(this, lights.mList.insert(*ptr.get<ESM::Light>())); break;
+        case Type_Lockpick: it = ContainerStoreIterator(this, lockpicks.mList.insert(*ptr.get<ESM::Lockpick>())); break;
+        case Type_Miscellaneous: it = ContainerStoreIterator(this, miscItems.mList.insert(*ptr.get<ESM::Miscellaneous>())); break;
+        case Type_Probe: it = ContainerStoreIterator(this, probes.mList.insert(*ptr.get<ESM::Probe>())); break;
+        case Type_Repair: it = ContainerStoreIterator(this, repairs.mList.insert(*ptr.get<ESM::Repair>())); break;
+        case Type_Weapon: it = ContainerStoreIterator(this, weapons.mList.insert(*ptr.get<ESM::Weapon>())); break;
     }
 
     it->getRefData().setCount(count);
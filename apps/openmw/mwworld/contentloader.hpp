@@ -15,6 +15,9 @@ struct ContentLoader
 {
     virtual ~ContentLoader() = default;
 
+    /// Called for every content file in the load order before the first load(), so the files can be read ahead.
+    virtual void prepare(const boost::filesystem::path& filepath, int index) {}
+
     virtual void load(const boost::filesystem::path& filepath, int& index, Loading::Listener* listener) = 0;
 };
 
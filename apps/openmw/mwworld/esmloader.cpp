@@ -1,11 +1,25 @@
 #include "esmloader.hpp"
 #include "esmstore.hpp"
 
+#include <algorithm>
+#include <exception>
+#include <future>
+#include <optional>
+
 #include <components/esm3/esmreader.hpp>
+#include <components/to_utf8/to_utf8.hpp>
 
 namespace MWWorld
 {
 
+struct EsmLoader::PreparedFile
+{
+    int mIndex;
+    ESMStore::ParsedFile mParsed;
+    std::promise<void> mParsedPromise;
+    std::future<void> mParsedFuture = mParsedPromise.get_future();
+};
+
 EsmLoader::EsmLoader(MWWorld::ESMStore& store, std::vector<ESM::ESMReader>& readers,
     ToUTF8::Utf8Encoder* encoder)
     : mEsm(readers)
@@ -14,7 +28,44 @@ EsmLoader::EsmLoader(MWWorld::ESMStore& store, std::vector<ESM::ESMReader>& read
 {
 }
 
+EsmLoader::~EsmLoader()
+{
+    // Don't start parsing the remaining files if loading was aborted
+    mNextParsed = mPrepared.size();
+    for (std::thread& thread : mThreads)
+        thread.join();
+}
+
+void EsmLoader::prepare(const boost::filesystem::path& filepath, int index)
+{
+    open(filepath, index);
+    auto& file = mPrepared.emplace_back(std::make_unique<PreparedFile>());
+    file->mIndex = index;
+}
+
 void EsmLoader::load(const boost::filesystem::path& filepath, int& index, Loading::Listener* listener)
+{
+    if (mNextLoaded == mPrepared.size() || mPrepared[mNextLoaded]->mIndex != index)
+    {
+        open(filepath, index);
+        mStore.load(mEsm[index], listener);
+        return;
+    }
+
+    if (mThreads.empty())
+    {
+        // The main thread merges the parsed files meanwhile, so it doesn't count
+        const std::size_t threadsCount = std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), mPrepared.size());
+        for (std::size_t i = 0; i < threadsCount; ++i)
+            mThreads.emplace_back([this] { parseFiles(); });
+    }
+
+    PreparedFile& file = *mPrepared[mNextLoaded++];
+    file.mParsedFuture.get();
+    mStore.load(mEsm[index], file.mParsed, listener);
+}
+
+void EsmLoader::open(const boost::filesystem::path& filepath, int index)
 {
     ESM::ESMReader lEsm;
     lEsm.setEncoder(mEncoder);
@@ -22,7 +73,33 @@ void EsmLoader::load(const boost::filesystem::path& filepath, int& index, Loadin
     lEsm.open(filepath.string());
     lEsm.resolveParentFileIndices(mEsm);
     mEsm[index] = lEsm;
-    mStore.load(mEsm[index], listener);
+}
+
+void EsmLoader::parseFiles()
+{
+    // Utf8Encoder converts through an internal buffer, so each thread needs its own
+    std::optional<ToUTF8::Utf8Encoder> encoder;
+    if (mEncoder != nullptr)
+        encoder.emplace(*mEncoder);
+
+    // Files are taken in the load order, so the one loaded next is parsed first
+    for (std::size_t i = mNextParsed++; i < mPrepared.size(); i = mNextParsed++)
+    {
+        PreparedFile& file = *mPrepared[i];
+        ESM::ESMReader& reader = mEsm[file.mIndex];
+        reader.setEncoder(encoder.has_value() ? &*encoder : nullptr);
+        try
+        {
+            mStore.parse(reader, file.mParsed);
+            reader.setEncoder(mEncoder);
+            file.mParsedPromise.set_value();
+        }
+        catch (...)
+        {
+            reader.setEncoder(mEncoder);
+            file.mParsedPromise.set_exception(std::current_exception());
+        }
+    }
 }
 
 } /* namespace MWWorld */
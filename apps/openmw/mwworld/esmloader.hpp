@@ -1,6 +1,9 @@
 #ifndef ESMLOADER_HPP
 #define ESMLOADER_HPP
 
+#include <atomic>
+#include <memory>
+#include <thread>
 #include <vector>
 
 #include "contentloader.hpp"
@@ -25,12 +28,29 @@ struct EsmLoader : public ContentLoader
     EsmLoader(MWWorld::ESMStore& store, std::vector<ESM::ESMReader>& readers,
         ToUTF8::Utf8Encoder* encoder);
 
+    ~EsmLoader() override;
+
+    /// Open the file. Prepared files are parsed in parallel on worker threads, started by the first load().
+    void prepare(const boost::filesystem::path& filepath, int index) override;
+
+    /// Add the records of the file to the store, after waiting for it to be parsed if it was prepared.
     void load(const boost::filesystem::path& filepath, int& index, Loading::Listener* listener) override;
 
     private:
+        struct PreparedFile;
+
         std::vector<ESM::ESMReader>& mEsm;
         MWWorld::ESMStore& mStore;
         ToUTF8::Utf8Encoder* mEncoder;
+        /// In the load order
+        std::vector<std::unique_ptr<PreparedFile>> mPrepared;
+        std::size_t mNextLoaded = 0;
+        std::atomic_size_t mNextParsed {0};
+        std::vector<std::thread> mThreads;
+
+        void open(const boost::filesystem::path& filepath, int index);
+
+        void parseFiles();
 };
 
 } /* namespace MWWorld */
@@ -24,6 +24,10 @@ namespace
 
     constexpr std::size_t deletedRefID = std::numeric_limits<std::size_t>::max();
 
+    // Records only found in snapshots
+    constexpr std::uint32_t recLuaScriptsFile = ESM::FourCC<'L','U','A','F'>::value;
+    constexpr std::uint32_t recRefCount = ESM::FourCC<'R','C','N','T'>::value;
+
     void readRefs(const ESM::Cell& cell, std::vector<Ref>& refs, std::vector<std::string>& refIDs, std::vector<ESM::ESMReader>& readers)
     {
         // TODO: we have many similar copies of this code.
@@ -159,56 +163,125 @@ void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener)
     {
         ESM::NAME n = esm.getRecName();
         esm.getRecHeader();
+        loadRecord(esm, n, dialogue);
+        listener->setProgress(static_cast<size_t>(esm.getFileOffset() / (float)esm.getFileSize() * 1000));
+    }
+}
 
-        // Look up the record type.
-        std::map<int, StoreBase *>::iterator it = mStores.find(n.toInt());
+void ESMStore::parse(ESM::ESMReader &esm, ParsedFile& parsed) const
+{
+    while (esm.hasMoreRecs())
+    {
+        const std::size_t offset = esm.getFileOffset();
+        const ESM::NAME n = esm.getRecName();
+        esm.getRecHeader();
 
-        if (it == mStores.end()) {
-            if (n.toInt() == ESM::REC_INFO) {
-                if (dialogue)
-                {
-                    dialogue->readInfo(esm, esm.getIndex() != 0);
-                }
-                else
-                {
-                    Log(Debug::Error) << "Error: info record without dialog";
-                    esm.skipRecord();
-                }
-            } else if (n.toInt() == ESM::REC_MGEF) {
-                mMagicEffects.load (esm);
-            } else if (n.toInt() == ESM::REC_SKIL) {
-                mSkills.load (esm);
-            }
-            else if (n.toInt() == ESM::REC_FILT || n.toInt() == ESM::REC_DBGP)
-            {
-                // ignore project file only records
-                esm.skipRecord();
-            }
-            else if (n.toInt() == ESM::REC_LUAL)
+        const auto it = mStores.find(n.toInt());
+        if (it != mStores.end() && it->second->isParseable())
+        {
+            std::unique_ptr<StoreBase::ParsedRecords>& records = parsed.mRecords[it->second];
+            parsed.mEntries.push_back({it->second, it->second->parse(esm, records)});
+        }
+        else
+        {
+            // Reading the record depends on the records before it, so it's read again when loading
+            parsed.mEntries.push_back({nullptr, offset});
+            esm.skipRecord();
+        }
+    }
+}
+
+void ESMStore::load(ESM::ESMReader &esm, ParsedFile& parsed, Loading::Listener* listener)
+{
+    listener->setProgressRange(1000);
+
+    ESM::Dialogue *dialogue = nullptr;
+
+    mLandTextures.resize(esm.getIndex()+1);
+
+    // parse() left the reader at the end of the file
+    const ESM::ESM_Context end = esm.getContext();
+    ESM::ESM_Context context = end;
+    context.leftRec = 0;
+    context.subCached = false;
+
+    for (std::size_t i = 0; i < parsed.mEntries.size(); ++i)
+    {
+        const ParsedFile::Entry& entry = parsed.mEntries[i];
+        if (entry.mStore != nullptr)
+        {
+            onRecordLoaded(*entry.mStore, entry.mStore->loadParsed(*parsed.mRecords[entry.mStore], entry.mIndex), dialogue);
+        }
+        else
+        {
+            context.filePos = entry.mIndex;
+            context.leftFile = esm.getFileSize() - entry.mIndex;
+            esm.restoreContext(context);
+            ESM::NAME n = esm.getRecName();
+            esm.getRecHeader();
+            loadRecord(esm, n, dialogue);
+        }
+        listener->setProgress((i + 1) * 1000 / parsed.mEntries.size());
+    }
+
+    esm.restoreContext(end);
+    parsed = ParsedFile {};
+}
+
+void ESMStore::loadRecord(ESM::ESMReader &esm, ESM::NAME name, ESM::Dialogue*& dialogue)
+{
+    // Look up the record type.
+    std::map<int, StoreBase *>::iterator it = mStores.find(name.toInt());
+
+    if (it == mStores.end()) {
+        if (name.toInt() == ESM::REC_INFO) {
+            if (dialogue)
             {
-                ESM::LuaScriptsCfg cfg;
-                cfg.load(esm);
-                // TODO: update refnums in cfg.mScripts[].mInitializationData according to load order
-                mLuaContent.push_back(std::move(cfg));
+                dialogue->readInfo(esm, esm.getIndex() != 0);
             }
-            else {
-                throw std::runtime_error("Unknown record: " + n.toString());
-            }
-        } else {
-            RecordId id = it->second->load(esm);
-            if (id.mIsDeleted)
+            else
             {
-                it->second->eraseStatic(id.mId);
-                continue;
-            }
-
-            if (n.toInt() == ESM::REC_DIAL) {
-                dialogue = const_cast<ESM::Dialogue*>(mDialogs.find(id.mId));
-            } else {
-                dialogue = nullptr;
+                Log(Debug::Error) << "Error: info record without dialog";
+                esm.skipRecord();
             }
+        } else if (name.toInt() == ESM::REC_MGEF) {
+            mMagicEffects.load (esm);
+        } else if (name.toInt() == ESM::REC_SKIL) {
+            mSkills.load (esm);
         }
-        listener->setProgress(static_cast<size_t>(esm.getFileOffset() / (float)esm.getFileSize() * 1000));
+        else if (name.toInt() == ESM::REC_FILT || name.toInt() == ESM::REC_DBGP)
+        {
+            // ignore project file only records
+            esm.skipRecord();
+        }
+        else if (name.toInt() == ESM::REC_LUAL)
+        {
+            ESM::LuaScriptsCfg cfg;
+            cfg.load(esm);
+            // TODO: update refnums in cfg.mScripts[].mInitializationData according to load order
+            mLuaContent.push_back(std::move(cfg));
+        }
+        else {
+            throw std::runtime_error("Unknown record: " + name.toString());
+        }
+    } else {
+        onRecordLoaded(*it->second, it->second->load(esm), dialogue);
+    }
+}
+
+void ESMStore::onRecordLoaded(StoreBase& store, const RecordId& id, ESM::Dialogue*& dialogue)
+{
+    if (id.mIsDeleted)
+    {
+        // A deleted record doesn't end the current dialogue
+        store.eraseStatic(id.mId);
+        return;
+    }
+
+    if (&store == &mDialogs) {
+        dialogue = const_cast<ESM::Dialogue*>(mDialogs.find(id.mId));
+    } else {
+        dialogue = nullptr;
     }
 }
 
@@ -491,6 +564,86 @@ void ESMStore::removeMissingObjects(Store<T>& store)
         }
     }
 
+    void ESMStore::writeSnapshot(ESM::ESMWriter& writer) const
+    {
+        for (const auto& [_, store] : mStores)
+            store->writeSnapshot(writer);
+
+        for (const auto& [_, effect] : mMagicEffects)
+        {
+            writer.startRecord(ESM::REC_MGEF, effect.mRecordFlags);
+            effect.save(writer);
+            writer.endRecord(ESM::REC_MGEF);
+        }
+
+        for (const auto& [_, skill] : mSkills)
+        {
+            writer.startRecord(ESM::REC_SKIL, skill.mRecordFlags);
+            skill.save(writer);
+            writer.endRecord(ESM::REC_SKIL);
+        }
+
+        for (const LuaContent& content : mLuaContent)
+        {
+            if (const std::string* path = std::get_if<std::string>(&content))
+            {
+                writer.startRecord(recLuaScriptsFile);
+                writer.writeHNString("NAME", *path);
+                writer.endRecord(recLuaScriptsFile);
+            }
+            else
+            {
+                writer.startRecord(ESM::REC_LUAL);
+                std::get<ESM::LuaScriptsCfg>(content).save(writer);
+                writer.endRecord(ESM::REC_LUAL);
+            }
+        }
+
+        writer.startRecord(recRefCount);
+        for (const auto& [id, count] : mRefCount)
+        {
+            writer.writeHNString("NAME", id);
+            writer.writeHNT("INTV", count);
+        }
+        writer.endRecord(recRefCount);
+    }
+
+    void ESMStore::readSnapshot(ESM::ESMReader& reader, Loading::Listener* listener)
+    {
+        listener->setProgressRange(1000);
+
+        ESM::Dialogue *dialogue = nullptr;
+
+        while (reader.hasMoreRecs())
+        {
+            const ESM::NAME n = reader.getRecName();
+            reader.getRecHeader();
+
+            if (n.toInt() == recLuaScriptsFile)
+            {
+                mLuaContent.push_back(reader.getHNString("NAME"));
+            }
+            else if (n.toInt() == recRefCount)
+            {
+                while (reader.hasMoreSubs())
+                {
+                    int& count = mRefCount[reader.getHNString("NAME")];
+                    reader.getHNT(count, "INTV");
+                }
+            }
+            else if (const auto it = mStores.find(n.toInt()); it != mStores.end())
+            {
+                onRecordLoaded(*it->second, it->second->readSnapshot(reader), dialogue);
+            }
+            else
+            {
+                loadRecord(reader, n, dialogue);
+            }
+
+            listener->setProgress(static_cast<size_t>(reader.getFileOffset() / (float)reader.getFileSize() * 1000));
+        }
+    }
+
     void ESMStore::checkPlayer()
     {
         setUp();
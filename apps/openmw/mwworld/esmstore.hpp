@@ -8,6 +8,7 @@
 
 #include <components/esm/luascripts.hpp>
 #include <components/esm/records.hpp>
+#include <components/esm/refid.hpp>
 #include "store.hpp"
 
 namespace Loading
@@ -95,6 +96,11 @@ namespace MWWorld
         template<class T>
         void removeMissingObjects(Store<T>& store);
 
+        /// Load the record which header was just read
+        void loadRecord(ESM::ESMReader &esm, ESM::NAME name, ESM::Dialogue*& dialogue);
+
+        void onRecordLoaded(StoreBase& store, const RecordId& id, ESM::Dialogue*& dialogue);
+
         using LuaContent = std::variant<
             ESM::LuaScriptsCfg,  // data from an omwaddon
             std::string>;  // path to an omwscripts file
@@ -116,22 +122,25 @@ namespace MWWorld
         }
 
         /// Look up the given ID in 'all'. Returns 0 if not found.
-        int find(const std::string &id) const
+        int find(std::string_view id) const
         {
-            IDMap::const_iterator it = mIds.find(id);
+            IDMap::const_iterator it = Misc::StringUtils::ciFind(mIds, id);
             if (it == mIds.end()) {
                 return 0;
             }
             return it->second;
         }
-        int findStatic(const std::string &id) const
+        int findStatic(std::string_view id) const
         {
-            IDMap::const_iterator it = mStaticIds.find(id);
+            IDMap::const_iterator it = Misc::StringUtils::ciFind(mStaticIds, id);
             if (it == mStaticIds.end()) {
                 return 0;
             }
             return it->second;
         }
+        // The maps are keyed on the record IDs rather than on RefIds, so that records don't keep IDs interned
+        int find(ESM::RefId id) const { return find(std::string_view(id.getString())); }
+        int findStatic(ESM::RefId id) const { return findStatic(std::string_view(id.getString())); }
 
         ESMStore()
           : mDynamicCount(0)
@@ -198,6 +207,29 @@ namespace MWWorld
 
         void load(ESM::ESMReader &esm, Loading::Listener* listener);
 
+        /// Records of a content file read by parse() and waiting to be added by load()
+        struct ParsedFile
+        {
+            struct Entry
+            {
+                /// Store of a parsed record, or nullptr if the record is read again by load()
+                StoreBase* mStore;
+                /// Index of a parsed record, or file offset of a record read again by load()
+                std::size_t mIndex;
+            };
+
+            /// All records in the file order
+            std::vector<Entry> mEntries;
+            std::map<const StoreBase*, std::unique_ptr<StoreBase::ParsedRecords>> mRecords;
+        };
+
+        /// Read records that don't depend on other records ahead of loading. Doesn't modify the store, so it can be
+        /// called concurrently for different readers.
+        void parse(ESM::ESMReader &esm, ParsedFile& parsed) const;
+
+        /// Add records read by parse() from the same reader, with the same result as load(esm, listener).
+        void load(ESM::ESMReader &esm, ParsedFile& parsed, Loading::Listener* listener);
+
         template <class T>
         const Store<T> &get() const {
             throw std::runtime_error("Storage for this type not exist");
@@ -275,6 +307,13 @@ namespace MWWorld
         bool readRecord (ESM::ESMReader& reader, uint32_t type);
         ///< \return Known type?
 
+        /// Write the static records and the state setUp(true) computes from the content files, to be read back by
+        /// readSnapshot() instead of loading the content files again.
+        void writeSnapshot(ESM::ESMWriter& writer) const;
+
+        /// Read the records written by writeSnapshot(). setUp() still needs to be called afterwards.
+        void readSnapshot(ESM::ESMReader& reader, Loading::Listener* listener);
+
         // To be called when we are done with dynamic record loading
         void checkPlayer();
 
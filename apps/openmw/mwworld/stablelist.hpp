@@ -0,0 +1,303 @@
+#ifndef GAME_MWWORLD_STABLELIST_H
+#define GAME_MWWORLD_STABLELIST_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace MWWorld
+{
+    /// @brief Set of elements stored contiguously in chunks.
+    /// Elements never move, so pointers and iterators to them stay valid until they are erased, same as for std::list.
+    /// Chunks grow geometrically from 4 elements up to chunkSize, so short lists stay small.
+    /// Erased elements leave a hole that is skipped by the iteration and filled by the next insertion. So elements are
+    /// iterated in insertion order only as long as none was erased.
+    /// Which slots hold an element is tracked in a dense array, so holes are skipped without touching their memory.
+    template <class T, std::size_t chunkSize = 64>
+    class StableList
+    {
+        struct Slot
+        {
+            alignas(T) unsigned char mStorage[sizeof(T)];
+        };
+
+        static constexpr std::size_t sFirstChunkSize = std::min<std::size_t>(4, chunkSize);
+
+        static constexpr std::size_t sEnd = std::numeric_limits<std::size_t>::max();
+
+        template <class Value, class List>
+        class IteratorBase
+        {
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = std::remove_const_t<Value>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Value*;
+            using reference = Value&;
+
+            IteratorBase() = default;
+
+            IteratorBase(List* list, std::size_t index) : mList(list), mIndex(index) {}
+
+            /// Iterator to const_iterator conversion
+            template <class OtherValue, class OtherList,
+                class = std::enable_if_t<std::is_convertible_v<OtherValue*, Value*>>>
+            IteratorBase(const IteratorBase<OtherValue, OtherList>& other) : mList(other.mList), mIndex(other.mIndex) {}
+
+            reference operator*() const { return *mList->at(mIndex); }
+
+            pointer operator->() const { return mList->at(mIndex); }
+
+            IteratorBase& operator++()
+            {
+                mIndex = mList->next(mIndex);
+                return *this;
+            }
+
+            IteratorBase operator++(int)
+            {
+                IteratorBase result = *this;
+                ++*this;
+                return result;
+            }
+
+            IteratorBase& operator--()
+            {
+                mIndex = mList->previous(mIndex);
+                return *this;
+            }
+
+            IteratorBase operator--(int)
+            {
+                IteratorBase result = *this;
+                --*this;
+                return result;
+            }
+
+            template <class OtherValue, class OtherList>
+            bool operator==(const IteratorBase<OtherValue, OtherList>& other) const
+            {
+                return mList == other.mList && mIndex == other.mIndex;
+            }
+
+            template <class OtherValue, class OtherList>
+            bool operator!=(const IteratorBase<OtherValue, OtherList>& other) const
+            {
+                return !(*this == other);
+            }
+
+        private:
+            List* mList = nullptr;
+            std::size_t mIndex = sEnd;
+
+            template <class, class>
+            friend class IteratorBase;
+
+            friend class StableList;
+        };
+
+    public:
+        using value_type = T;
+        using iterator = IteratorBase<T, const StableList>;
+        using const_iterator = IteratorBase<const T, const StableList>;
+
+        StableList() = default;
+
+        StableList(const StableList& other)
+        {
+            for (const T& value : other)
+                emplace(value);
+        }
+
+        StableList(StableList&& other) noexcept
+            : mChunks(std::move(other.mChunks))
+            , mAlive(std::move(other.mAlive))
+            , mFree(std::move(other.mFree))
+            , mSize(std::exchange(other.mSize, 0))
+            , mCapacity(std::exchange(other.mCapacity, 0))
+        {
+            other.mChunks.clear();
+            other.mAlive.clear();
+            other.mFree.clear();
+        }
+
+        ~StableList() { clear(); }
+
+        StableList& operator=(const StableList& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                for (const T& value : other)
+                    emplace(value);
+            }
+            return *this;
+        }
+
+        StableList& operator=(StableList&& other) noexcept
+        {
+            if (this != &other)
+            {
+                clear();
+                mChunks = std::move(other.mChunks);
+                mAlive = std::move(other.mAlive);
+                mFree = std::move(other.mFree);
+                mSize = std::exchange(other.mSize, 0);
+                mCapacity = std::exchange(other.mCapacity, 0);
+                other.mChunks.clear();
+                other.mAlive.clear();
+                other.mFree.clear();
+            }
+            return *this;
+        }
+
+        iterator begin() { return iterator(this, find(0)); }
+        iterator end() { return iterator(this, sEnd); }
+
+        const_iterator begin() const { return const_iterator(this, find(0)); }
+        const_iterator end() const { return const_iterator(this, sEnd); }
+
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+
+        /// Number of elements, not counting the holes.
+        std::size_t size() const { return mSize; }
+
+        bool empty() const { return mSize == 0; }
+
+        /// Number of elements the allocated chunks can hold.
+        std::size_t capacity() const { return mCapacity; }
+
+        T& front() { return *begin(); }
+        const T& front() const { return *begin(); }
+
+        T& back() { return *--end(); }
+        const T& back() const { return *--end(); }
+
+        /// Construct an element in the first hole left by an erased one or after the last element.
+        /// @return Iterator to the new element.
+        template <class ... Args>
+        iterator emplace(Args&& ... args)
+        {
+            if (!mFree.empty())
+            {
+                const std::size_t index = mFree.back();
+                new (storage(index)) T(std::forward<Args>(args) ...);
+                mFree.pop_back();
+                mAlive[index] = 1;
+                ++mSize;
+                return iterator(this, index);
+            }
+            const std::size_t index = mAlive.size();
+            if (index == mCapacity)
+            {
+                const std::size_t size = getChunkSize(mChunks.size());
+                mChunks.emplace_back(new Slot[size]);
+                mCapacity += size;
+            }
+            new (storage(index)) T(std::forward<Args>(args) ...);
+            mAlive.push_back(1);
+            ++mSize;
+            return iterator(this, index);
+        }
+
+        iterator insert(const T& value) { return emplace(value); }
+
+        iterator insert(T&& value) { return emplace(std::move(value)); }
+
+        /// @return Iterator to the element following the erased one.
+        iterator erase(const_iterator it)
+        {
+            assert(it.mIndex < mAlive.size() && mAlive[it.mIndex]);
+            slot(it.mIndex)->~T();
+            mAlive[it.mIndex] = 0;
+            mFree.push_back(it.mIndex);
+            --mSize;
+            return iterator(this, find(it.mIndex + 1));
+        }
+
+        void clear()
+        {
+            for (std::size_t i = 0; i < mAlive.size(); ++i)
+                if (mAlive[i])
+                    slot(i)->~T();
+            mChunks.clear();
+            mAlive.clear();
+            mFree.clear();
+            mSize = 0;
+            mCapacity = 0;
+        }
+
+    private:
+        std::vector<std::unique_ptr<Slot[]>> mChunks;
+        std::vector<std::uint8_t> mAlive;
+        std::vector<std::size_t> mFree;
+        std::size_t mSize = 0;
+        std::size_t mCapacity = 0;
+
+        static std::size_t getChunkSize(std::size_t chunk)
+        {
+            std::size_t size = sFirstChunkSize;
+            for (; chunk > 0 && size < chunkSize; --chunk)
+                size = std::min(size * 2, chunkSize);
+            return size;
+        }
+
+        void* storage(std::size_t index) const
+        {
+            std::size_t chunk = 0;
+            // Chunks before the first full sized one double in size
+            for (std::size_t size = sFirstChunkSize; size < chunkSize; size = std::min(size * 2, chunkSize))
+            {
+                if (index < size)
+                    return mChunks[chunk][index].mStorage;
+                index -= size;
+                ++chunk;
+            }
+            return mChunks[chunk + index / chunkSize][index % chunkSize].mStorage;
+        }
+
+        T* slot(std::size_t index) const
+        {
+            return std::launder(static_cast<T*>(storage(index)));
+        }
+
+        T* at(std::size_t index) const
+        {
+            assert(index < mAlive.size() && mAlive[index]);
+            return slot(index);
+        }
+
+        /// @return Index of the first element at or after the given index, or sEnd.
+        std::size_t find(std::size_t index) const
+        {
+            for (std::size_t i = index; i < mAlive.size(); ++i)
+                if (mAlive[i])
+                    return i;
+            return sEnd;
+        }
+
+        std::size_t next(std::size_t index) const
+        {
+            return find(index + 1);
+        }
+
+        std::size_t previous(std::size_t index) const
+        {
+            for (std::size_t i = std::min(index, mAlive.size()); i > 0; --i)
+                if (mAlive[i - 1])
+                    return i - 1;
+            return sEnd;
+        }
+    };
+}
+
+#endif
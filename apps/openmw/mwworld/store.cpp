@@ -8,15 +8,80 @@
 #include <components/loadinglistener/loadinglistener.hpp>
 #include <components/misc/rng.hpp>
 
+#include <cstdint>
 #include <iterator>
 #include <stdexcept>
 
+namespace
+{
+    // Contexts are kept in snapshots as is, so references and land data are still read lazily from the content files
+    void writeContext(ESM::ESMWriter& writer, const ESM::ESM_Context& context)
+    {
+        writer.writeHNString("CTXF", context.filename);
+        writer.startSubRecord("CTXD");
+        writer.writeT(context.leftRec);
+        writer.writeT(context.leftSub);
+        writer.writeT(static_cast<std::uint64_t>(context.leftFile));
+        writer.writeT(context.recName.toInt());
+        writer.writeT(context.subName.toInt());
+        writer.writeT(context.index);
+        writer.writeT(static_cast<std::uint8_t>(context.subCached));
+        writer.writeT(static_cast<std::uint64_t>(context.filePos));
+        writer.writeT(static_cast<std::uint32_t>(context.parentFileIndices.size()));
+        for (int index : context.parentFileIndices)
+            writer.writeT(index);
+        writer.endRecord("CTXD");
+    }
+
+    /// Read the rest of a context after its CTXF subrecord name
+    ESM::ESM_Context readContext(ESM::ESMReader& reader)
+    {
+        ESM::ESM_Context context;
+        context.filename = reader.getHString();
+        reader.getSubNameIs("CTXD");
+        reader.getSubHeader();
+        reader.getT(context.leftRec);
+        reader.getT(context.leftSub);
+        std::uint64_t leftFile = 0;
+        reader.getT(leftFile);
+        context.leftFile = static_cast<std::size_t>(leftFile);
+        std::uint32_t name = 0;
+        reader.getT(name);
+        context.recName = name;
+        reader.getT(name);
+        context.subName = name;
+        reader.getT(context.index);
+        std::uint8_t subCached = 0;
+        reader.getT(subCached);
+        context.subCached = subCached != 0;
+        std::uint64_t filePos = 0;
+        reader.getT(filePos);
+        context.filePos = static_cast<std::size_t>(filePos);
+        std::uint32_t parentsCount = 0;
+        reader.getT(parentsCount);
+        context.parentFileIndices.resize(parentsCount);
+        for (int& index : context.parentFileIndices)
+            reader.getT(index);
+        return context;
+    }
+}
+
 namespace MWWorld
 {
     RecordId::RecordId(const std::string &id, bool isDeleted)
         : mId(id), mIsDeleted(isDeleted)
     {}
 
+    std::size_t StoreBase::parse(ESM::ESMReader &esm, std::unique_ptr<ParsedRecords>& records) const
+    {
+        throw std::logic_error("Store can't parse records ahead of loading");
+    }
+
+    RecordId StoreBase::loadParsed(ParsedRecords& records, std::size_t index)
+    {
+        throw std::logic_error("Store can't load parsed records");
+    }
+
     template<typename T>
     IndexedStore<T>::IndexedStore()
     {
@@ -96,22 +161,22 @@ namespace MWWorld
     }
 
     template<typename T>
-    const T *Store<T>::search(const std::string &id) const
+    const T *Store<T>::search(std::string_view id) const
     {
-        typename Dynamic::const_iterator dit = mDynamic.find(id);
+        typename Dynamic::const_iterator dit = Misc::StringUtils::ciFind(mDynamic, id);
         if (dit != mDynamic.end())
             return &dit->second;
 
-        typename Static::const_iterator it = mStatic.find(id);
+        typename Static::const_iterator it = Misc::StringUtils::ciFind(mStatic, id);
         if (it != mStatic.end())
             return &(it->second);
 
         return nullptr;
     }
     template<typename T>
-    const T *Store<T>::searchStatic(const std::string &id) const
+    const T *Store<T>::searchStatic(std::string_view id) const
     {
-        typename Static::const_iterator it = mStatic.find(id);
+        typename Static::const_iterator it = Misc::StringUtils::ciFind(mStatic, id);
         if (it != mStatic.end())
             return &(it->second);
 
@@ -119,9 +184,9 @@ namespace MWWorld
     }
 
     template<typename T>
-    bool Store<T>::isDynamic(const std::string &id) const
+    bool Store<T>::isDynamic(std::string_view id) const
     {
-        typename Dynamic::const_iterator dit = mDynamic.find(id);
+        typename Dynamic::const_iterator dit = Misc::StringUtils::ciFind(mDynamic, id);
         return (dit != mDynamic.end());
     }
     template<typename T>
@@ -138,7 +203,7 @@ namespace MWWorld
         return nullptr;
     }
     template<typename T>
-    const T *Store<T>::find(const std::string &id) const
+    const T *Store<T>::find(std::string_view id) const
     {
         const T *ptr = search(id);
         if (ptr == nullptr)
@@ -165,6 +230,31 @@ namespace MWWorld
         return RecordId(record.mId, isDeleted);
     }
     template<typename T>
+    std::size_t Store<T>::parse(ESM::ESMReader &esm, std::unique_ptr<ParsedRecords>& records) const
+    {
+        if (records == nullptr)
+            records = std::make_unique<Parsed>();
+        auto& parsed = static_cast<Parsed&>(*records).mRecords;
+
+        auto& [record, isDeleted] = parsed.emplace_back(T(), false);
+        record.load(esm, isDeleted);
+        Misc::StringUtils::lowerCaseInPlace(record.mId);
+
+        return parsed.size() - 1;
+    }
+    template<typename T>
+    RecordId Store<T>::loadParsed(ParsedRecords& records, std::size_t index)
+    {
+        auto& [record, isDeleted] = static_cast<Parsed&>(records).mRecords[index];
+        RecordId id(record.mId, isDeleted);
+
+        std::pair<typename Static::iterator, bool> inserted = mStatic.insert_or_assign(id.mId, std::move(record));
+        if (inserted.second)
+            mShared.push_back(&inserted.first->second);
+
+        return id;
+    }
+    template<typename T>
     void Store<T>::setUp()
     {
     }
@@ -278,6 +368,18 @@ namespace MWWorld
         }
     }
     template<typename T>
+    void Store<T>::writeSnapshot(ESM::ESMWriter& writer) const
+    {
+        // The static records come first and keep the content files order
+        for (std::size_t i = 0; i < mStatic.size(); ++i)
+        {
+            const T& record = *mShared[i];
+            writer.startRecord(T::sRecordId, record.mRecordFlags);
+            record.save(writer);
+            writer.endRecord(T::sRecordId);
+        }
+    }
+    template<typename T>
     RecordId Store<T>::read(ESM::ESMReader& reader, bool overrideOnly)
     {
         T record;
@@ -350,6 +452,50 @@ namespace MWWorld
 
         return RecordId(ltexl[idx].mId, isDeleted);
     }
+    void Store<ESM::LandTexture>::writeSnapshot(ESM::ESMWriter& writer) const
+    {
+        writer.startRecord(ESM::REC_LTEX);
+        writer.writeHNT("PLGS", static_cast<std::uint32_t>(mStatic.size()));
+        writer.endRecord(ESM::REC_LTEX);
+
+        for (std::size_t plugin = 0; plugin < mStatic.size(); ++plugin)
+        {
+            for (std::size_t index = 0; index < mStatic[plugin].size(); ++index)
+            {
+                writer.startRecord(ESM::REC_LTEX);
+                writer.writeHNT("PLUG", static_cast<std::uint32_t>(plugin));
+                writer.writeHNT("INDX", static_cast<std::uint32_t>(index));
+                mStatic[plugin][index].save(writer);
+                writer.endRecord(ESM::REC_LTEX);
+            }
+        }
+    }
+    RecordId Store<ESM::LandTexture>::readSnapshot(ESM::ESMReader& reader)
+    {
+        if (reader.isNextSub("PLGS"))
+        {
+            std::uint32_t pluginsCount = 0;
+            reader.getHT(pluginsCount);
+            mStatic.resize(pluginsCount);
+            return RecordId();
+        }
+
+        std::uint32_t plugin = 0;
+        std::uint32_t index = 0;
+        reader.getHNT(plugin, "PLUG");
+        reader.getHNT(index, "INDX");
+
+        ESM::LandTexture lt;
+        bool isDeleted = false;
+        lt.load(reader, isDeleted);
+
+        LandTextureList& ltexl = mStatic.at(plugin);
+        if (index >= ltexl.size())
+            ltexl.resize(index + 1);
+        ltexl[index] = std::move(lt);
+
+        return RecordId(ltexl[index].mId, isDeleted);
+    }
     Store<ESM::LandTexture>::iterator Store<ESM::LandTexture>::begin(size_t plugin) const
     {
         assert(plugin < mStatic.size());
@@ -412,6 +558,40 @@ namespace MWWorld
 
         return RecordId("", isDeleted);
     }
+    void Store<ESM::Land>::writeSnapshot(ESM::ESMWriter& writer) const
+    {
+        for (const ESM::Land& land : mStatic)
+        {
+            writer.startRecord(ESM::REC_LAND);
+            writer.startSubRecord("INTV");
+            writer.writeT(land.mX);
+            writer.writeT(land.mY);
+            writer.endRecord("INTV");
+            writer.writeHNT("DATA", land.mFlags);
+            writer.writeHNT("TYPE", land.mDataTypes);
+            writer.writeHNT("WNAM", land.mWnam);
+            writeContext(writer, land.mContext);
+            writer.endRecord(ESM::REC_LAND);
+        }
+    }
+    RecordId Store<ESM::Land>::readSnapshot(ESM::ESMReader& reader)
+    {
+        ESM::Land land;
+        reader.getSubNameIs("INTV");
+        reader.getSubHeader();
+        reader.getT(land.mX);
+        reader.getT(land.mY);
+        reader.getHNT(land.mFlags, "DATA");
+        reader.getHNT(land.mDataTypes, "TYPE");
+        reader.getSubNameIs("WNAM");
+        reader.getHExact(land.mWnam, sizeof(land.mWnam));
+        reader.getSubNameIs("CTXF");
+        land.mContext = readContext(reader);
+
+        mStatic.insert(std::move(land));
+
+        return RecordId("", false);
+    }
     void Store<ESM::Land>::setUp()
     {
         // The land is static for given game session, there is no need to refresh it every load.
@@ -471,14 +651,14 @@ namespace MWWorld
 
         esm.restoreContext(ctx);
     }
-    const ESM::Cell *Store<ESM::Cell>::search(const std::string &id) const
+    const ESM::Cell *Store<ESM::Cell>::search(std::string_view id) const
     {
-        DynamicInt::const_iterator it = mInt.find(id);
+        DynamicInt::const_iterator it = Misc::StringUtils::ciFind(mInt, id);
         if (it != mInt.end()) {
             return &(it->second);
         }
 
-        DynamicInt::const_iterator dit = mDynamicInt.find(id);
+        DynamicInt::const_iterator dit = Misc::StringUtils::ciFind(mDynamicInt, id);
         if (dit != mDynamicInt.end()) {
             return &dit->second;
         }
@@ -526,12 +706,12 @@ namespace MWWorld
         newCell.mAmbi.mFogDensity = 0;
         return &mExt.insert(std::make_pair(key, newCell)).first->second;
     }
-    const ESM::Cell *Store<ESM::Cell>::find(const std::string &id) const
+    const ESM::Cell *Store<ESM::Cell>::find(std::string_view id) const
     {
         const ESM::Cell *ptr = search(id);
         if (ptr == nullptr)
         {
-            const std::string msg = "Cell '" + id + "' not found";
+            const std::string msg = "Cell '" + std::string(id) + "' not found";
             throw std::runtime_error(msg);
         }
         return ptr;
@@ -653,6 +833,85 @@ namespace MWWorld
 
         return RecordId(cell.mName, isDeleted);
     }
+    void Store<ESM::Cell>::writeSnapshot(ESM::ESMWriter& writer) const
+    {
+        const auto writeCell = [&] (const ESM::Cell& cell)
+        {
+            writer.startRecord(ESM::REC_CELL);
+            writer.writeHNCString("NAME", cell.mName);
+            writer.writeHNT("DATA", cell.mData, 12);
+            writer.writeHNOCString("RGNN", cell.mRegion);
+            writer.startSubRecord("CELD");
+            writer.writeT(cell.mWater);
+            writer.writeT(static_cast<std::uint8_t>(cell.mWaterInt));
+            writer.writeT(static_cast<std::uint8_t>(cell.mHasAmbi));
+            writer.writeT(cell.mAmbi);
+            writer.writeT(cell.mMapColor);
+            writer.writeT(cell.mRefNumCounter);
+            writer.endRecord("CELD");
+            for (const ESM::ESM_Context& context : cell.mContextList)
+                writeContext(writer, context);
+            for (const ESM::MovedCellRef& movedRef : cell.mMovedRefs)
+                writer.writeHNT("MVRF", movedRef);
+            for (const auto& [ref, deleted] : cell.mLeasedRefs)
+            {
+                writer.writeHNT("LEAS", static_cast<std::uint8_t>(deleted));
+                ref.save(writer, true);
+            }
+            writer.endRecord(ESM::REC_CELL);
+        };
+
+        for (const auto& [_, cell] : mInt)
+            writeCell(cell);
+        for (const auto& [_, cell] : mExt)
+            writeCell(cell);
+    }
+    RecordId Store<ESM::Cell>::readSnapshot(ESM::ESMReader& reader)
+    {
+        ESM::Cell cell;
+        bool isDeleted = false;
+        cell.loadNameAndData(reader, isDeleted);
+        cell.mRegion = reader.getHNOString("RGNN");
+
+        reader.getSubNameIs("CELD");
+        reader.getSubHeader();
+        reader.getT(cell.mWater);
+        std::uint8_t flag = 0;
+        reader.getT(flag);
+        cell.mWaterInt = flag != 0;
+        reader.getT(flag);
+        cell.mHasAmbi = flag != 0;
+        reader.getT(cell.mAmbi);
+        reader.getT(cell.mMapColor);
+        reader.getT(cell.mRefNumCounter);
+
+        while (reader.isNextSub("CTXF"))
+            cell.mContextList.push_back(readContext(reader));
+
+        while (reader.isNextSub("MVRF"))
+        {
+            ESM::MovedCellRef movedRef;
+            reader.getHT(movedRef);
+            cell.mMovedRefs.push_back(movedRef);
+        }
+
+        while (reader.isNextSub("LEAS"))
+        {
+            std::uint8_t deleted = 0;
+            reader.getHT(deleted);
+            ESM::CellRef ref;
+            bool ignored = false;
+            ref.load(reader, ignored, true);
+            cell.mLeasedRefs.emplace_back(std::move(ref), deleted != 0);
+        }
+
+        if (cell.mData.mFlags & ESM::Cell::Interior)
+            mInt[cell.mName] = cell;
+        else
+            mExt[std::make_pair(cell.mData.mX, cell.mData.mY)] = cell;
+
+        return RecordId(cell.mName, isDeleted);
+    }
     Store<ESM::Cell>::iterator Store<ESM::Cell>::intBegin() const
     {
         return iterator(mSharedInt.begin());
@@ -855,6 +1114,38 @@ namespace MWWorld
 
         return RecordId("", isDeleted);
     }
+    void Store<ESM::Pathgrid>::writeSnapshot(ESM::ESMWriter& writer) const
+    {
+        // Whether the pathgrid belongs to an interior cell is guessed while loading, keep the result
+        const auto writePathgrid = [&] (const ESM::Pathgrid& pathgrid, bool interior)
+        {
+            writer.startRecord(ESM::REC_PGRD);
+            writer.writeHNT("INTR", static_cast<std::uint8_t>(interior));
+            pathgrid.save(writer);
+            writer.endRecord(ESM::REC_PGRD);
+        };
+
+        for (const auto& [_, pathgrid] : mInt)
+            writePathgrid(pathgrid, true);
+        for (const auto& [_, pathgrid] : mExt)
+            writePathgrid(pathgrid, false);
+    }
+    RecordId Store<ESM::Pathgrid>::readSnapshot(ESM::ESMReader& reader)
+    {
+        std::uint8_t interior = 0;
+        reader.getHNT(interior, "INTR");
+
+        ESM::Pathgrid pathgrid;
+        bool isDeleted = false;
+        pathgrid.load(reader, isDeleted);
+
+        if (interior != 0)
+            mInt.insert_or_assign(pathgrid.mCell, std::move(pathgrid));
+        else
+            mExt.insert_or_assign(std::make_pair(pathgrid.mData.mX, pathgrid.mData.mY), std::move(pathgrid));
+
+        return RecordId("", false);
+    }
     size_t Store<ESM::Pathgrid>::getSize() const
     {
         return mInt.size() + mExt.size();
@@ -869,9 +1160,9 @@ namespace MWWorld
             return &(it->second);
         return nullptr;
     }
-    const ESM::Pathgrid *Store<ESM::Pathgrid>::search(const std::string& name) const
+    const ESM::Pathgrid *Store<ESM::Pathgrid>::search(std::string_view name) const
     {
-        Interior::const_iterator it = mInt.find(name);
+        Interior::const_iterator it = Misc::StringUtils::ciFind(mInt, name);
         if (it != mInt.end())
             return &(it->second);
         return nullptr;
@@ -886,12 +1177,12 @@ namespace MWWorld
         }
         return pathgrid;
     }
-    const ESM::Pathgrid* Store<ESM::Pathgrid>::find(const std::string& name) const
+    const ESM::Pathgrid* Store<ESM::Pathgrid>::find(std::string_view name) const
     {
         const ESM::Pathgrid* pathgrid = search(name);
         if (!pathgrid)
         {
-            const std::string msg = "Pathgrid in cell '" + name + "' not found";
+            const std::string msg = "Pathgrid in cell '" + std::string(name) + "' not found";
             throw std::runtime_error(msg);
         }
         return pathgrid;
@@ -991,7 +1282,12 @@ namespace MWWorld
         // DialInfos marked as deleted are kept during the loading phase, so that the linked list
         // structure is kept intact for inserting further INFOs. Delete them now that loading is done.
         for (auto & [_, dial] : mStatic)
+        {
             dial.clearDeletedInfos();
+            // The dialogue filter compares them to reference IDs, which are lower-cased
+            for (ESM::DialInfo& info : dial.mInfo)
+                Misc::StringUtils::lowerCaseInPlace(info.mActor);
+        }
 
         mShared.clear();
         mShared.reserve(mStatic.size());
@@ -1004,16 +1300,16 @@ namespace MWWorld
         mKeywordSearchModFlag = true;
     }
 
-    const ESM::Dialogue *Store<ESM::Dialogue>::search(const std::string &id) const
+    const ESM::Dialogue *Store<ESM::Dialogue>::search(std::string_view id) const
     {
-        typename Static::const_iterator it = mStatic.find(id);
+        typename Static::const_iterator it = Misc::StringUtils::ciFind(mStatic, id);
         if (it != mStatic.end())
             return &(it->second);
 
         return nullptr;
     }
 
-    const ESM::Dialogue *Store<ESM::Dialogue>::find(const std::string &id) const
+    const ESM::Dialogue *Store<ESM::Dialogue>::find(std::string_view id) const
     {
         const ESM::Dialogue *ptr = search(id);
         if (ptr == nullptr)
@@ -1064,6 +1360,23 @@ namespace MWWorld
         return RecordId(dialogue.mId, isDeleted);
     }
 
+    void Store<ESM::Dialogue>::writeSnapshot(ESM::ESMWriter& writer) const
+    {
+        for (const auto& [_, dialogue] : mStatic)
+        {
+            writer.startRecord(ESM::REC_DIAL);
+            dialogue.save(writer);
+            writer.endRecord(ESM::REC_DIAL);
+
+            for (const ESM::DialInfo& info : dialogue.mInfo)
+            {
+                writer.startRecord(ESM::REC_INFO);
+                info.save(writer);
+                writer.endRecord(ESM::REC_INFO);
+            }
+        }
+    }
+
     bool Store<ESM::Dialogue>::eraseStatic(const std::string &id)
     {
         if (mStatic.erase(id))
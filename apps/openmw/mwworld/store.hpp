@@ -2,6 +2,7 @@
 #define OPENMW_MWWORLD_STORE_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
 #include <map>
@@ -47,6 +48,24 @@ namespace MWWorld
         virtual int getDynamicSize() const { return 0; }
         virtual RecordId load(ESM::ESMReader &esm) = 0;
 
+        /// Records read by parse() and not yet added to the store.
+        struct ParsedRecords
+        {
+            virtual ~ParsedRecords() = default;
+        };
+
+        /// Can records be read by parse() ahead of load()? False if reading a record depends on the records
+        /// already in the store.
+        virtual bool isParseable() const { return false; }
+
+        /// Read a record into \a records without modifying the store, so records from different readers can be
+        /// parsed concurrently.
+        /// @return Index of the record to pass to loadParsed().
+        virtual std::size_t parse(ESM::ESMReader &esm, std::unique_ptr<ParsedRecords>& records) const;
+
+        /// Add a record read by parse(), with the same effect load() would have had.
+        virtual RecordId loadParsed(ParsedRecords& records, std::size_t index);
+
         virtual bool eraseStatic(const std::string &id) {return false;}
         virtual void clearDynamic() {}
 
@@ -54,6 +73,12 @@ namespace MWWorld
 
         virtual RecordId read (ESM::ESMReader& reader, bool overrideOnly = false) { return RecordId(); }
         ///< Read into dynamic storage
+
+        /// Write the static records, including the state other content files can't change anymore once loaded.
+        virtual void writeSnapshot(ESM::ESMWriter& writer) const {}
+
+        /// Read a record written by writeSnapshot()
+        virtual RecordId readSnapshot(ESM::ESMReader& reader) { return load(reader); }
     };
 
     template <class T>
@@ -172,18 +197,18 @@ namespace MWWorld
         void clearDynamic() override;
         void setUp() override;
 
-        const T *search(const std::string &id) const;
-        const T *searchStatic(const std::string &id) const;
+        const T *search(std::string_view id) const;
+        const T *searchStatic(std::string_view id) const;
 
         /**
          * Does the record with this ID come from the dynamic store?
          */
-        bool isDynamic(const std::string &id) const;
+        bool isDynamic(std::string_view id) const;
 
         /** Returns a random record that starts with the named ID, or nullptr if not found. */
         const T *searchRandom(const std::string &id) const;
 
-        const T *find(const std::string &id) const;
+        const T *find(std::string_view id) const;
 
         iterator begin() const;
         iterator end() const;
@@ -202,8 +227,19 @@ namespace MWWorld
         bool erase(const T &item);
 
         RecordId load(ESM::ESMReader &esm) override;
+        bool isParseable() const override { return true; }
+        std::size_t parse(ESM::ESMReader &esm, std::unique_ptr<ParsedRecords>& records) const override;
+        RecordId loadParsed(ParsedRecords& records, std::size_t index) override;
         void write(ESM::ESMWriter& writer, Loading::Listener& progress) const override;
         RecordId read(ESM::ESMReader& reader, bool overrideOnly = false) override;
+        void writeSnapshot(ESM::ESMWriter& writer) const override;
+
+    private:
+        struct Parsed : ParsedRecords
+        {
+            /// Records and their deleted flags.
+            std::vector<std::pair<T, bool>> mRecords;
+        };
     };
 
     template <>
@@ -229,6 +265,8 @@ namespace MWWorld
         size_t getSize(size_t plugin) const;
 
         RecordId load(ESM::ESMReader &esm) override;
+        void writeSnapshot(ESM::ESMWriter& writer) const override;
+        RecordId readSnapshot(ESM::ESMReader& reader) override;
 
         iterator begin(size_t plugin) const;
         iterator end(size_t plugin) const;
@@ -272,6 +310,8 @@ namespace MWWorld
         const ESM::Land *find(int x, int y) const;
 
         RecordId load(ESM::ESMReader &esm) override;
+        void writeSnapshot(ESM::ESMWriter& writer) const override;
+        RecordId readSnapshot(ESM::ESMReader& reader) override;
         void setUp() override;
     private:
         bool mBuilt = false;
@@ -314,18 +354,20 @@ namespace MWWorld
     public:
         typedef SharedIterator<ESM::Cell> iterator;
 
-        const ESM::Cell *search(const std::string &id) const;
+        const ESM::Cell *search(std::string_view id) const;
         const ESM::Cell *search(int x, int y) const;
         const ESM::Cell *searchStatic(int x, int y) const;
         const ESM::Cell *searchOrCreate(int x, int y);
 
-        const ESM::Cell *find(const std::string &id) const;
+        const ESM::Cell *find(std::string_view id) const;
         const ESM::Cell *find(int x, int y) const;
 
         void clearDynamic() override;
         void setUp() override;
 
         RecordId load(ESM::ESMReader &esm) override;
+        void writeSnapshot(ESM::ESMWriter& writer) const override;
+        RecordId readSnapshot(ESM::ESMReader& reader) override;
 
         iterator intBegin() const;
         iterator intEnd() const;
@@ -370,14 +412,16 @@ namespace MWWorld
 
         void setCells(Store<ESM::Cell>& cells);
         RecordId load(ESM::ESMReader &esm) override;
+        void writeSnapshot(ESM::ESMWriter& writer) const override;
+        RecordId readSnapshot(ESM::ESMReader& reader) override;
         size_t getSize() const override;
 
         void setUp() override;
 
         const ESM::Pathgrid *search(int x, int y) const;
-        const ESM::Pathgrid *search(const std::string& name) const;
+        const ESM::Pathgrid *search(std::string_view name) const;
         const ESM::Pathgrid *find(int x, int y) const;
-        const ESM::Pathgrid* find(const std::string& name) const;
+        const ESM::Pathgrid* find(std::string_view name) const;
         const ESM::Pathgrid *search(const ESM::Cell &cell) const;
         const ESM::Pathgrid *find(const ESM::Cell &cell) const;
     };
@@ -462,8 +506,8 @@ namespace MWWorld
 
         void setUp() override;
 
-        const ESM::Dialogue *search(const std::string &id) const;
-        const ESM::Dialogue *find(const std::string &id) const;
+        const ESM::Dialogue *search(std::string_view id) const;
+        const ESM::Dialogue *find(std::string_view id) const;
 
         iterator begin() const;
         iterator end() const;
@@ -474,6 +518,9 @@ namespace MWWorld
 
         RecordId load(ESM::ESMReader &esm) override;
 
+        /// Writes each dialogue followed by its infos
+        void writeSnapshot(ESM::ESMWriter& writer) const override;
+
         const MWDialogue::KeywordSearch<std::string, int>& getDialogIdKeywordSearch() const;
     };
 
@@ -0,0 +1,132 @@
+#include "storesnapshot.hpp"
+
+#include <array>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <components/debug/debuglog.hpp>
+#include <components/esm3/esmreader.hpp>
+#include <components/esm3/esmwriter.hpp>
+#include <components/files/hash.hpp>
+#include <components/files/memorymappedfile.hpp>
+
+#include "esmstore.hpp"
+
+namespace MWWorld
+{
+    namespace
+    {
+        constexpr std::uint32_t recSnapshot = ESM::FourCC<'S','N','A','P'>::value;
+
+        // Increase when the records written by ESMStore::writeSnapshot change
+        constexpr int snapshotFormat = 1;
+
+        std::array<std::uint64_t, 2> getContentHash(const boost::filesystem::path& path)
+        {
+            if (boost::filesystem::file_size(path) == 0)
+                return Files::getHash(std::string_view());
+            const Files::MemoryMappedFile file(path.string());
+            return Files::getHash(std::string_view(file.data(), file.size()));
+        }
+    }
+
+    StoreSnapshot::StoreSnapshot(const boost::filesystem::path& path, const std::string& version)
+        : mPath(path)
+        , mVersion(version)
+    {
+    }
+
+    void StoreSnapshot::setContentFiles(const std::vector<boost::filesystem::path>& contentFiles)
+    {
+        std::ostringstream key;
+        key << "format " << snapshotFormat << '\n' << mVersion << '\n';
+        for (const boost::filesystem::path& path : contentFiles)
+        {
+            const std::array<std::uint64_t, 2> hash = getContentHash(path);
+            key << path.string() << ' ' << std::hex << std::setfill('0') << std::setw(16) << hash[0]
+                << std::setw(16) << hash[1] << std::dec << '\n';
+        }
+        mKey = key.str();
+    }
+
+    bool StoreSnapshot::read(ESMStore& store, Loading::Listener* listener) const
+    {
+        if (!boost::filesystem::exists(mPath))
+            return false;
+
+        ESM::ESMReader reader;
+        try
+        {
+            reader.open(mPath.string());
+            if (!reader.hasMoreRecs() || reader.getRecName().toInt() != recSnapshot)
+                throw std::runtime_error("Not a content snapshot");
+            reader.getRecHeader();
+            if (reader.getHNString("KEY_") != mKey)
+            {
+                Log(Debug::Info) << "Content files have changed since the last content snapshot, loading them";
+                return false;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to open content snapshot " << mPath << ": " << e.what();
+            return false;
+        }
+
+        Log(Debug::Info) << "Loading content snapshot " << mPath;
+
+        try
+        {
+            store.readSnapshot(reader, listener);
+        }
+        catch (...)
+        {
+            // The store is partially loaded, so it's too late to fall back to the content files. At least don't fail
+            // again on the next launch.
+            boost::system::error_code ec;
+            boost::filesystem::remove(mPath, ec);
+            throw;
+        }
+
+        return true;
+    }
+
+    void StoreSnapshot::write(const ESMStore& store) const
+    {
+        boost::filesystem::path temporaryPath = mPath;
+        temporaryPath += ".tmp";
+
+        try
+        {
+            boost::filesystem::create_directories(mPath.parent_path());
+            {
+                boost::filesystem::ofstream stream(temporaryPath, std::ios_base::binary);
+                ESM::ESMWriter writer;
+                writer.setFormat(0);
+                writer.save(stream);
+
+                writer.startRecord(recSnapshot);
+                writer.writeHNString("KEY_", mKey);
+                writer.endRecord(recSnapshot);
+
+                store.writeSnapshot(writer);
+                writer.close();
+
+                if (!stream.good())
+                    throw std::runtime_error("Failed to write to " + temporaryPath.string());
+            }
+            // Never leave a partially written snapshot behind
+            boost::filesystem::rename(temporaryPath, mPath);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write content snapshot " << mPath << ": " << e.what();
+            boost::system::error_code ec;
+            boost::filesystem::remove(temporaryPath, ec);
+        }
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef OPENMW_MWWORLD_STORESNAPSHOT_H
+#define OPENMW_MWWORLD_STORESNAPSHOT_H
+
+#include <string>
+#include <vector>
+
+#include <boost/filesystem/path.hpp>
+
+namespace Loading
+{
+    class Listener;
+}
+
+namespace MWWorld
+{
+    class ESMStore;
+
+    /// @brief Single file snapshot of the ESMStore after loading all content files and setting it up.
+    /// @par The snapshot is only read when it was written for the same content files, in the same order, with the
+    /// same contents and by the same version of the engine. The content files are still needed to load cell references
+    /// and land data.
+    class StoreSnapshot
+    {
+    public:
+        StoreSnapshot(const boost::filesystem::path& path, const std::string& version);
+
+        /// Identify the snapshot by the content files in the load order. Reads all of them to hash their contents.
+        void setContentFiles(const std::vector<boost::filesystem::path>& contentFiles);
+
+        /// @return True if the store was read from a snapshot of the same content files.
+        /// @note Call before loading anything else into the store.
+        bool read(ESMStore& store, Loading::Listener* listener) const;
+
+        /// Replace the stored snapshot. Failures are logged and otherwise ignored.
+        void write(const ESMStore& store) const;
+
+    private:
+        boost::filesystem::path mPath;
+        std::string mVersion;
+        std::string mKey;
+    };
+}
+
+#endif
@@ -78,6 +78,7 @@
 
 #include "contentloader.hpp"
 #include "esmloader.hpp"
+#include "storesnapshot.hpp"
 
 namespace MWWorld
 {
@@ -88,6 +89,13 @@ namespace MWWorld
             mLoaders.emplace(std::move(extension), &loader);
         }
 
+        void prepare(const boost::filesystem::path& filepath, int index) override
+        {
+            const auto it = mLoaders.find(Misc::StringUtils::lowerCase(filepath.extension().string()));
+            if (it != mLoaders.end())
+                it->second->prepare(filepath, index);
+        }
+
         void load(const boost::filesystem::path& filepath, int& index, Loading::Listener* listener) override
         {
             const auto it = mLoaders.find(Misc::StringUtils::lowerCase(filepath.extension().string()));
@@ -141,7 +149,8 @@ namespace MWWorld
         const std::vector<std::string>& groundcoverFiles,
         ToUTF8::Utf8Encoder* encoder, int activationDistanceOverride,
         const std::string& startCell, const std::string& startupScript,
-        const std::string& resourcePath, const std::string& userDataPath)
+        const std::string& resourcePath, const std::string& userDataPath,
+        StoreSnapshot* storeSnapshot)
     : mResourceSystem(resourceSystem), mLocalScripts (mStore),
       mCells (mStore, mEsm), mSky (true),
       mGodMode(false), mScriptsEnabled(true), mDiscardMovements(true), mContentFiles (contentFiles),
@@ -157,7 +166,7 @@ namespace MWWorld
         Loading::Listener* listener = MWBase::Environment::get().getWindowManager()->getLoadingScreen();
         listener->loadingOn();
 
-        loadContentFiles(fileCollections, contentFiles, mStore, mEsm, encoder, listener);
+        const bool loadedSnapshot = loadContentFiles(fileCollections, contentFiles, mStore, mEsm, encoder, listener, storeSnapshot);
         loadGroundcoverFiles(fileCollections, groundcoverFiles, encoder);
 
         listener->loadingOff();
@@ -179,6 +188,9 @@ namespace MWWorld
         mStore.setUp(true);
         mStore.movePlayerRecord();
 
+        if (storeSnapshot != nullptr && !loadedSnapshot)
+            storeSnapshot->write(mStore);
+
         mSwimHeightScale = mStore.get<ESM::GameSetting>().find("fSwimHeightScale")->mValue.getFloat();
 
         mPhysics.reset(new MWPhysics::PhysicsSystem(resourceSystem, rootNode));
@@ -1252,6 +1264,8 @@ namespace MWWorld
             mWorldScene->removeFromPagedRefs(newPtr);
         }
 
+        MWBase::Environment::get().getMechanicsManager()->updatePosition(newPtr);
+
         return newPtr;
     }
 
@@ -2945,7 +2959,7 @@ namespace MWWorld
         return mScriptsEnabled;
     }
 
-    void World::loadContentFiles(const Files::Collections& fileCollections, const std::vector<std::string>& content, ESMStore& store, std::vector<ESM::ESMReader>& readers, ToUTF8::Utf8Encoder* encoder, Loading::Listener* listener)
+    bool World::loadContentFiles(const Files::Collections& fileCollections, const std::vector<std::string>& content, ESMStore& store, std::vector<ESM::ESMReader>& readers, ToUTF8::Utf8Encoder* encoder, Loading::Listener* listener, StoreSnapshot* snapshot)
     {
         GameContentLoader gameContentLoader;
         EsmLoader esmLoader(store, readers, encoder);
@@ -2960,22 +2974,41 @@ namespace MWWorld
         OMWScriptsLoader omwScriptsLoader(store);
         gameContentLoader.addLoader(".omwscripts", omwScriptsLoader);
 
-        int idx = 0;
+        std::vector<boost::filesystem::path> paths;
+        paths.reserve(content.size());
         for (const std::string &file : content)
         {
             boost::filesystem::path filename(file);
             const Files::MultiDirCollection& col = fileCollections.getCollection(filename.extension().string());
             if (col.doesExist(file))
             {
-                gameContentLoader.load(col.getPath(file), idx, listener);
+                paths.push_back(col.getPath(file));
+                gameContentLoader.prepare(paths.back(), static_cast<int>(paths.size()) - 1);
             }
             else
             {
                 std::string message = "Failed loading " + file + ": the content file does not exist";
                 throw std::runtime_error(message);
             }
+        }
+
+        if (snapshot != nullptr)
+        {
+            snapshot->setContentFiles(paths);
+            // The readers stay open to load cell references and land data
+            if (snapshot->read(store, listener))
+                return true;
+        }
+
+        // Files are parsed in parallel, but their records are added in the load order
+        int idx = 0;
+        for (const boost::filesystem::path& path : paths)
+        {
+            gameContentLoader.load(path, idx, listener);
             idx++;
         }
+
+        return false;
     }
 
     void World::loadGroundcoverFiles(const Files::Collections& fileCollections, const std::vector<std::string>& groundcoverFiles, ToUTF8::Utf8Encoder* encoder)
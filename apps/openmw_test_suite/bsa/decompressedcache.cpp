@@ -0,0 +1,80 @@
+#include <components/bsa/decompressedcache.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace Bsa;
+
+    DecompressedCache::Buffer makeBuffer(std::size_t size)
+    {
+        return std::make_shared<const std::vector<char>>(size, 'a');
+    }
+
+    TEST(BsaDecompressedCacheTest, getShouldReturnStoredBuffer)
+    {
+        DecompressedCache cache(100);
+        const auto buffer = makeBuffer(10);
+        cache.put(1, 42, buffer);
+        EXPECT_EQ(cache.get(1, 42), buffer);
+        EXPECT_EQ(cache.get(2, 42), nullptr);
+        EXPECT_EQ(cache.get(1, 43), nullptr);
+    }
+
+    TEST(BsaDecompressedCacheTest, getShouldCountHitsAndMisses)
+    {
+        DecompressedCache cache(100);
+        cache.put(1, 0, makeBuffer(10));
+        cache.get(1, 0);
+        cache.get(1, 0);
+        cache.get(1, 1);
+        const DecompressedCache::Stats stats = cache.getStats();
+        EXPECT_EQ(stats.mHits, 2u);
+        EXPECT_EQ(stats.mMisses, 1u);
+        EXPECT_EQ(stats.mFiles, 1u);
+        EXPECT_EQ(stats.mBytes, 10u);
+    }
+
+    TEST(BsaDecompressedCacheTest, putShouldEvictLeastRecentlyUsed)
+    {
+        DecompressedCache cache(30);
+        cache.put(1, 0, makeBuffer(10));
+        cache.put(1, 1, makeBuffer(10));
+        cache.put(1, 2, makeBuffer(10));
+        cache.get(1, 0);
+        cache.put(1, 3, makeBuffer(10));
+        EXPECT_NE(cache.get(1, 0), nullptr);
+        EXPECT_EQ(cache.get(1, 1), nullptr);
+        EXPECT_NE(cache.get(1, 2), nullptr);
+        EXPECT_NE(cache.get(1, 3), nullptr);
+        EXPECT_EQ(cache.getStats().mBytes, 30u);
+    }
+
+    TEST(BsaDecompressedCacheTest, putShouldIgnoreBufferLargerThanMaxSize)
+    {
+        DecompressedCache cache(10);
+        cache.put(1, 0, makeBuffer(5));
+        cache.put(1, 1, makeBuffer(11));
+        EXPECT_NE(cache.get(1, 0), nullptr);
+        EXPECT_EQ(cache.get(1, 1), nullptr);
+    }
+
+    TEST(BsaDecompressedCacheTest, setMaxSizeShouldEvict)
+    {
+        DecompressedCache cache(100);
+        cache.put(1, 0, makeBuffer(10));
+        cache.put(1, 1, makeBuffer(10));
+        cache.setMaxSize(15);
+        EXPECT_EQ(cache.getStats().mFiles, 1u);
+        EXPECT_NE(cache.get(1, 1), nullptr);
+    }
+
+    TEST(BsaDecompressedCacheTest, zeroMaxSizeShouldDisableCache)
+    {
+        DecompressedCache cache(0);
+        cache.put(1, 0, makeBuffer(0));
+        EXPECT_EQ(cache.get(1, 0), nullptr);
+        EXPECT_EQ(cache.getStats().mMisses, 0u);
+    }
+}
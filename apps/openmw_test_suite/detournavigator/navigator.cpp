@@ -188,6 +188,88 @@ namespace
         )) << mPath;
     }
 
+    TEST_F(DetourNavigatorNavigatorTest, request_path_then_process_should_return_same_path_as_find_path)
+    {
+        constexpr std::array<float, 5 * 5> heightfieldData {{
+            0,   0,    0,    0,    0,
+            0, -25,  -25,  -25,  -25,
+            0, -25, -100, -100, -100,
+            0, -25, -100, -100, -100,
+            0, -25, -100, -100, -100,
+        }};
+        const HeightfieldSurface surface = makeSquareHeightfieldSurface(heightfieldData);
+        const int cellSize = mHeightfieldTileSize * (surface.mSize - 1);
+
+        mNavigator->addAgent(mAgentHalfExtents);
+        mNavigator->addHeightfield(mCellPosition, cellSize, surface);
+        mNavigator->update(mPlayerPosition);
+        mNavigator->wait(mListener, WaitConditionType::requiredTilesPresent);
+
+        ASSERT_EQ(findPath(*mNavigator, mAgentHalfExtents, mStepSize, mStart, mEnd, Flag_walk, mAreaCosts, mEndTolerance, mOut),
+                  Status::Success);
+
+        PathRequest request;
+        request.mAgentHalfExtents = mAgentHalfExtents;
+        request.mStepSize = mStepSize;
+        request.mStart = mStart;
+        request.mEnd = mEnd;
+        request.mIncludeFlags = Flag_walk;
+        request.mAreaCosts = mAreaCosts;
+        request.mEndTolerance = mEndTolerance;
+
+        const PendingPath pendingPath = mNavigator->requestPath(request);
+        EXPECT_FALSE(pendingPath.isProcessed());
+
+        mNavigator->processPathRequests();
+
+        ASSERT_TRUE(pendingPath.isProcessed());
+        EXPECT_EQ(pendingPath.get().mStatus, Status::Success);
+        EXPECT_THAT(pendingPath.get().mPath, ElementsAreArray(mPath));
+    }
+
+    TEST_F(DetourNavigatorNavigatorTest, equal_path_requests_should_share_search)
+    {
+        mNavigator->addAgent(mAgentHalfExtents);
+
+        PathRequest request;
+        request.mAgentHalfExtents = mAgentHalfExtents;
+        request.mStepSize = mStepSize;
+        request.mStart = mStart;
+        request.mEnd = mEnd;
+        request.mIncludeFlags = Flag_walk;
+
+        const PendingPath first = mNavigator->requestPath(request);
+        const PendingPath second = mNavigator->requestPath(request);
+        request.mEnd = mStart;
+        const PendingPath other = mNavigator->requestPath(request);
+
+        EXPECT_TRUE(first.isSameSearch(second));
+        EXPECT_FALSE(first.isSameSearch(other));
+
+        mNavigator->processPathRequests();
+
+        const PendingPath afterProcess = mNavigator->requestPath(request);
+        EXPECT_FALSE(other.isSameSearch(afterProcess));
+        EXPECT_FALSE(afterProcess.isProcessed());
+    }
+
+    TEST_F(DetourNavigatorNavigatorTest, request_path_for_unknown_agent_should_return_nav_mesh_not_found)
+    {
+        PathRequest request;
+        request.mAgentHalfExtents = mAgentHalfExtents;
+        request.mStepSize = mStepSize;
+        request.mStart = mStart;
+        request.mEnd = mEnd;
+        request.mIncludeFlags = Flag_walk;
+
+        const PendingPath pendingPath = mNavigator->requestPath(request);
+        mNavigator->processPathRequests();
+
+        ASSERT_TRUE(pendingPath.isProcessed());
+        EXPECT_EQ(pendingPath.get().mStatus, Status::NavMeshNotFound);
+        EXPECT_THAT(pendingPath.get().mPath, IsEmpty());
+    }
+
     TEST_F(DetourNavigatorNavigatorTest, add_object_should_change_navmesh)
     {
         const std::array<float, 5 * 5> heightfieldData {{
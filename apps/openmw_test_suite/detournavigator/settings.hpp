@@ -35,6 +35,7 @@ namespace DetourNavigator
             result.mRecast.mTileSize = 64;
             result.mWaitUntilMinDistanceToPlayer = std::numeric_limits<int>::max();
             result.mAsyncNavMeshUpdaterThreads = 1;
+            result.mAsyncPathFinderThreads = 2;
             result.mMaxNavMeshTilesCacheSize = 1024 * 1024;
             result.mDetour.mMaxPolygonPathSize = 1024;
             result.mDetour.mMaxSmoothPathSize = 1024;
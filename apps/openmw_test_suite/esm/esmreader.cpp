@@ -0,0 +1,123 @@
+#include <components/esm3/esmreader.hpp>
+#include <components/esm3/esmwriter.hpp>
+#include <components/to_utf8/to_utf8.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    using namespace testing;
+    using namespace ESM;
+
+    std::string makeContent()
+    {
+        std::ostringstream out;
+        ESMWriter writer;
+        writer.save(out);
+        writer.startRecord("TEST");
+        writer.writeHNString("NAME", "foo");
+        writer.writeHNT("DATA", std::uint32_t {42});
+        writer.writeHNString("DESC", "bar");
+        writer.endRecord("TEST");
+        writer.close();
+        return out.str();
+    }
+
+    struct ESMReaderTest : TestWithParam<bool>
+    {
+        const std::string mContent = makeContent();
+        const std::string mFileName = makeFileName();
+        ESMReader mReader;
+
+        static std::string makeFileName()
+        {
+            std::string result = std::string(UnitTest::GetInstance()->current_test_info()->name()) + ".esp";
+            std::replace(result.begin(), result.end(), '/', '_');
+            return result;
+        }
+
+        void SetUp() override
+        {
+            if (GetParam())
+            {
+                std::ofstream(mFileName, std::ios_base::binary) << mContent;
+                mReader.open(mFileName);
+            }
+            else
+                mReader.open(std::make_shared<std::istringstream>(mContent), mFileName);
+        }
+
+        void TearDown() override
+        {
+            mReader.close();
+            std::remove(mFileName.c_str());
+        }
+
+        void readRecordHeader()
+        {
+            ASSERT_TRUE(mReader.hasMoreRecs());
+            EXPECT_EQ(mReader.getRecName(), "TEST");
+            mReader.getRecHeader();
+        }
+    };
+
+    TEST_P(ESMReaderTest, openShouldUseMappingOnlyForFiles)
+    {
+        EXPECT_EQ(mReader.isMapped(), GetParam());
+        EXPECT_EQ(mReader.getFileSize(), mContent.size());
+    }
+
+    TEST_P(ESMReaderTest, shouldReadSubrecords)
+    {
+        readRecordHeader();
+        EXPECT_EQ(mReader.getHNString("NAME"), "foo");
+        std::uint32_t data = 0;
+        mReader.getHNT(data, "DATA");
+        EXPECT_EQ(data, 42u);
+        EXPECT_EQ(mReader.getHNOStringView("NAME"), "");
+        EXPECT_EQ(mReader.getHNOStringView("DESC"), "bar");
+        EXPECT_FALSE(mReader.hasMoreSubs());
+        EXPECT_FALSE(mReader.hasMoreRecs());
+        EXPECT_EQ(mReader.getFileOffset(), mContent.size());
+    }
+
+    TEST_P(ESMReaderTest, restoreContextShouldContinueFromSavedPosition)
+    {
+        readRecordHeader();
+        const ESM_Context context = mReader.getContext();
+        mReader.getSubName();
+        mReader.skipHSub();
+        mReader.restoreContext(context);
+        EXPECT_EQ(mReader.getHNString("NAME"), "foo");
+    }
+
+    TEST_P(ESMReaderTest, skipRecordShouldMoveToEndOfRecord)
+    {
+        readRecordHeader();
+        mReader.getSubName();
+        mReader.skipRecord();
+        EXPECT_EQ(mReader.getFileOffset(), mContent.size());
+    }
+
+    INSTANTIATE_TEST_SUITE_P(MappedAndStream, ESMReaderTest, Values(true, false));
+
+    TEST(ESMReaderToUtf8Test, shouldConvertOnlyTheViewedCharacters)
+    {
+        ToUTF8::Utf8Encoder encoder(ToUTF8::WINDOWS_1252);
+        ESMReader reader;
+        reader.setEncoder(&encoder);
+        const std::string content = "\xe9t\xe9 \xe9t\xe9";
+        std::string out = "previous value";
+        reader.toUtf8(std::string_view(content.data(), 3), out);
+        EXPECT_EQ(out, "\xc3\xa9t\xc3\xa9");
+        reader.toUtf8(std::string_view(content.data() + 1, 1), out);
+        EXPECT_EQ(out, "t");
+    }
+}
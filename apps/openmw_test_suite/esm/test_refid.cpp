@@ -0,0 +1,49 @@
+#include <components/esm/refid.hpp>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace ESM;
+
+    TEST(EsmRefIdTest, defaultConstructedShouldBeEmpty)
+    {
+        EXPECT_TRUE(RefId().empty());
+        EXPECT_EQ(RefId(), RefId::intern(""));
+    }
+
+    TEST(EsmRefIdTest, internShouldIgnoreCase)
+    {
+        const RefId id = RefId::intern("Fargoth");
+        EXPECT_EQ(id, RefId::intern("fargoth"));
+        EXPECT_EQ(id, RefId::intern("FARGOTH"));
+        EXPECT_EQ(id.getString(), "fargoth");
+        EXPECT_NE(id, RefId::intern("fargoth_ring"));
+    }
+
+    TEST(EsmRefIdTest, searchShouldNotIntern)
+    {
+        const std::size_t count = RefId::getCount();
+        EXPECT_EQ(RefId::search("never_interned_id"), std::nullopt);
+        EXPECT_EQ(RefId::getCount(), count);
+        const RefId id = RefId::intern("Never_Interned_Id");
+        EXPECT_EQ(RefId::search("never_interned_id"), id);
+        EXPECT_EQ(RefId::getCount(), count + 1);
+    }
+
+    TEST(EsmRefIdTest, internFromMultipleThreadsShouldReturnSameAtom)
+    {
+        std::vector<RefId> ids(4);
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < ids.size(); ++i)
+            threads.emplace_back([&ids, i] { ids[i] = RefId::intern("concurrently_interned_id"); });
+        for (std::thread& thread : threads)
+            thread.join();
+        for (const RefId& id : ids)
+            EXPECT_EQ(id, ids.front());
+    }
+}
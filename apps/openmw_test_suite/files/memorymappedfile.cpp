@@ -0,0 +1,67 @@
+#include <components/files/memorymappedfile.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace
+{
+    using namespace testing;
+    using namespace Files;
+
+    struct FilesMemoryMappedFileTest : Test
+    {
+        const std::string mFileName = "memorymappedfile_test.bin";
+        const std::string mContent = "0123456789abcdef";
+
+        void SetUp() override
+        {
+            std::ofstream(mFileName, std::ios_base::binary).write(mContent.data(), static_cast<std::streamsize>(mContent.size()));
+        }
+    };
+
+    TEST_F(FilesMemoryMappedFileTest, shouldMapWholeFile)
+    {
+        const MemoryMappedFile file(mFileName);
+        EXPECT_EQ(std::string(file.data(), file.size()), mContent);
+    }
+
+    TEST_F(FilesMemoryMappedFileTest, viewShouldPointToRequestedRange)
+    {
+        const FileView view = makeFileView(std::make_shared<const MemoryMappedFile>(mFileName), 4, 6);
+        EXPECT_TRUE(view.isValid());
+        EXPECT_EQ(view.getData(), "456789");
+    }
+
+    TEST_F(FilesMemoryMappedFileTest, viewShouldKeepMappingAlive)
+    {
+        FileView view;
+        {
+            auto file = std::make_shared<const MemoryMappedFile>(mFileName);
+            view = makeFileView(file, 10, 6);
+        }
+        EXPECT_EQ(view.getData(), "abcdef");
+    }
+
+    TEST_F(FilesMemoryMappedFileTest, viewOutsideOfFileShouldThrow)
+    {
+        const auto file = std::make_shared<const MemoryMappedFile>(mFileName);
+        EXPECT_THROW(makeFileView(file, 10, 7), std::runtime_error);
+        EXPECT_THROW(makeFileView(file, 17, 0), std::runtime_error);
+    }
+
+    TEST_F(FilesMemoryMappedFileTest, streamShouldReadViewContent)
+    {
+        const IStreamPtr stream = openFileViewStream(makeFileView(std::make_shared<const MemoryMappedFile>(mFileName), 2, 5));
+        const std::string result(std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>{});
+        EXPECT_EQ(result, "23456");
+    }
+
+    TEST(FilesFileViewTest, defaultConstructedShouldBeInvalid)
+    {
+        EXPECT_FALSE(FileView {}.isValid());
+    }
+}
@@ -36,6 +36,17 @@ namespace
         EXPECT_FLOAT_EQ(value.as<double>(), 3.14);
     }
 
+    TEST(LuaSerializationTest, SerializeToBufferShouldReplaceItsContent)
+    {
+        sol::state lua;
+        std::string buffer = "previous content";
+        LuaUtil::serialize(buffer, sol::make_object<double>(lua, 3.14));
+        EXPECT_EQ(buffer, LuaUtil::serialize(sol::make_object<double>(lua, 3.14)));
+        EXPECT_FLOAT_EQ(LuaUtil::deserialize(lua, buffer).as<double>(), 3.14);
+        LuaUtil::serialize(buffer, sol::nil);
+        EXPECT_EQ(buffer, "");
+    }
+
     TEST(LuaSerializationTest, Boolean)
     {
         sol::state lua;
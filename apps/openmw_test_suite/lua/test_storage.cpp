@@ -64,6 +64,25 @@ namespace
         EXPECT_EQ(get<std::string>(mLua, "ro:get('x').y"), "abc");
     }
 
+    TEST(LuaUtilStorageTest, ReadOnlySectionInAnotherLuaState)
+    {
+        sol::state mLua;
+        sol::state otherLua;
+        LuaUtil::LuaStorage::initLuaBindings(mLua);
+        LuaUtil::LuaStorage::initLuaBindings(otherLua);
+        LuaUtil::LuaStorage storage(mLua);
+        mLua["mutable"] = storage.getMutableSection("test");
+        otherLua["ro"] = storage.getReadOnlySection("test", otherLua);
+
+        mLua.safe_script("mutable:set('x', { y = 'abc', z = 7 })");
+        EXPECT_EQ(get<int>(mLua, "mutable:get('x').z"), 7);
+        EXPECT_EQ(get<int>(otherLua, "ro:get('x').z"), 7);
+        EXPECT_EQ(get<std::string>(otherLua, "ro:get('x').y"), "abc");
+        EXPECT_THROW(otherLua.safe_script("ro:get('x').z = 3"), std::exception);
+        EXPECT_EQ(get<int>(otherLua, "ro:asTable().x.z"), 7);
+        EXPECT_TRUE(get<bool>(otherLua, "ro:get('w') == nil"));
+    }
+
     TEST(LuaUtilStorageTest, Saving)
     {
         sol::state mLua;
@@ -0,0 +1,110 @@
+#include <components/misc/spatialgrid.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace Misc;
+
+    std::vector<int> findInRadius(const SpatialGrid<int>& grid, const osg::Vec3f& center, float radius)
+    {
+        std::vector<int> result;
+        grid.forEachInRadius(center, radius, [&] (int value, const osg::Vec3f& /*position*/)
+        {
+            result.push_back(value);
+            return true;
+        });
+        return result;
+    }
+
+    TEST(MiscSpatialGridTest, forEachInRadiusShouldVisitOnlyValuesWithinRadius)
+    {
+        SpatialGrid<int> grid(100);
+        grid.update(1, osg::Vec3f(0, 0, 0));
+        grid.update(2, osg::Vec3f(150, 0, 0));
+        grid.update(3, osg::Vec3f(-90, -90, 0));
+        grid.update(4, osg::Vec3f(0, 0, 300));
+        EXPECT_THAT(findInRadius(grid, osg::Vec3f(0, 0, 0), 160), UnorderedElementsAre(1, 2, 3));
+        EXPECT_THAT(findInRadius(grid, osg::Vec3f(0, 0, 0), 100), ElementsAre(1));
+        EXPECT_THAT(findInRadius(grid, osg::Vec3f(0, 0, 250), 100), ElementsAre(4));
+    }
+
+    TEST(MiscSpatialGridTest, forEachInRadiusShouldHandleNegativeCoordinates)
+    {
+        SpatialGrid<int> grid(100);
+        grid.update(1, osg::Vec3f(-1, -1, 0));
+        grid.update(2, osg::Vec3f(1, 1, 0));
+        EXPECT_THAT(findInRadius(grid, osg::Vec3f(-1, -1, 0), 1), ElementsAre(1));
+        EXPECT_THAT(findInRadius(grid, osg::Vec3f(0, 0, 0), 2), UnorderedElementsAre(1, 2));
+    }
+
+    TEST(MiscSpatialGridTest, forEachInRadiusShouldStopWhenVisitorReturnsFalse)
+    {
+        SpatialGrid<int> grid(100);
+        for (int i = 0; i < 10; ++i)
+            grid.update(i, osg::Vec3f(i * 50.f, 0, 0));
+        int visited = 0;
+        EXPECT_FALSE(grid.forEachInRadius(osg::Vec3f(0, 0, 0), 1000, [&] (int, const osg::Vec3f&) { return ++visited < 3; }));
+        EXPECT_EQ(visited, 3);
+        EXPECT_TRUE(grid.forEachInRadius(osg::Vec3f(0, 0, 0), 1000, [] (int, const osg::Vec3f&) { return true; }));
+    }
+
+    TEST(MiscSpatialGridTest, forEachInRadiusWithLargeRadiusShouldVisitAllPopulatedCells)
+    {
+        SpatialGrid<int> grid(1);
+        grid.update(1, osg::Vec3f(-500, 700, 0));
+        grid.update(2, osg::Vec3f(300, -200, 0));
+        EXPECT_THAT(findInRadius(grid, osg::Vec3f(0, 0, 0), 1e6f), UnorderedElementsAre(1, 2));
+    }
+
+    TEST(MiscSpatialGridTest, updateShouldMoveValueToNewPosition)
+    {
+        SpatialGrid<int> grid(100);
+        grid.update(1, osg::Vec3f(0, 0, 0));
+        grid.update(2, osg::Vec3f(10, 0, 0));
+        grid.update(1, osg::Vec3f(1000, 0, 0));
+        EXPECT_EQ(grid.size(), 2u);
+        EXPECT_THAT(findInRadius(grid, osg::Vec3f(0, 0, 0), 50), ElementsAre(2));
+        EXPECT_THAT(findInRadius(grid, osg::Vec3f(1000, 0, 0), 50), ElementsAre(1));
+        grid.update(2, osg::Vec3f(20, 0, 0));
+        EXPECT_THAT(findInRadius(grid, osg::Vec3f(20, 0, 0), 1), ElementsAre(2));
+    }
+
+    TEST(MiscSpatialGridTest, eraseShouldRemoveValue)
+    {
+        SpatialGrid<int> grid(100);
+        grid.update(1, osg::Vec3f(0, 0, 0));
+        grid.update(2, osg::Vec3f(10, 0, 0));
+        grid.update(3, osg::Vec3f(20, 0, 0));
+        EXPECT_TRUE(grid.erase(1));
+        EXPECT_FALSE(grid.erase(1));
+        EXPECT_THAT(findInRadius(grid, osg::Vec3f(0, 0, 0), 50), UnorderedElementsAre(2, 3));
+        EXPECT_TRUE(grid.erase(3));
+        EXPECT_THAT(findInRadius(grid, osg::Vec3f(0, 0, 0), 50), ElementsAre(2));
+        EXPECT_EQ(grid.size(), 1u);
+    }
+
+    TEST(MiscSpatialGridTest, replaceShouldKeepPosition)
+    {
+        SpatialGrid<int> grid(100);
+        grid.update(1, osg::Vec3f(0, 0, 0));
+        grid.replace(1, 5);
+        EXPECT_FALSE(grid.erase(1));
+        EXPECT_THAT(findInRadius(grid, osg::Vec3f(0, 0, 0), 1), ElementsAre(5));
+    }
+
+    TEST(MiscSpatialGridTest, forEachInRadiusShouldHandleNonFiniteAndHugeValues)
+    {
+        SpatialGrid<int> grid(100);
+        grid.update(1, osg::Vec3f(0, 0, 0));
+        grid.update(2, osg::Vec3f(1e30f, -1e30f, 0));
+        EXPECT_THAT(findInRadius(grid, osg::Vec3f(0, 0, 0), 10), ElementsAre(1));
+        EXPECT_THAT(findInRadius(grid, osg::Vec3f(0, 0, 0), std::numeric_limits<float>::infinity()), UnorderedElementsAre(1, 2));
+        EXPECT_THAT(findInRadius(grid, osg::Vec3f(0, 0, 0), std::numeric_limits<float>::quiet_NaN()), IsEmpty());
+    }
+}
@@ -5,6 +5,8 @@
 #include <string>
 #include <string_view>
 #include <type_traits>
+#include <cstring>
+#include <unordered_map>
 
 struct PartialBinarySearchTest : public ::testing::Test
 {
@@ -146,3 +148,39 @@ namespace
         EXPECT_FALSE(StringUtils::ciEqual(std::string("a"), std::string("aa")));
     }
 }
+
+namespace
+{
+    using ::Misc::StringUtils;
+
+    TEST(MiscStringUtilsToLower8Test, should_match_to_lower_for_each_byte)
+    {
+        for (int i = 0; i < 256; ++i)
+        {
+            const char ch = static_cast<char>(i);
+            std::uint64_t word = 0;
+            std::memset(&word, ch, sizeof(word));
+            std::uint64_t expected = 0;
+            std::memset(&expected, StringUtils::toLower(ch), sizeof(expected));
+            EXPECT_EQ(StringUtils::toLower8(word), expected) << i;
+        }
+    }
+
+    TEST(MiscStringUtilsCiHashTest, should_ignore_case)
+    {
+        const StringUtils::CiHash hash;
+        EXPECT_EQ(hash("Fargoth's Ring Of Mild Healing"), hash("fargoth's ring of mild healing"));
+        EXPECT_EQ(hash(std::string("BOOK")), hash(std::string_view("book")));
+        EXPECT_NE(hash("book"), hash("book "));
+        EXPECT_NE(hash("a"), hash(std::string_view("a\0", 2)));
+    }
+
+    TEST(MiscStringUtilsCiFindTest, should_find_key_ignoring_case)
+    {
+        const std::unordered_map<std::string, int, StringUtils::CiHash, StringUtils::CiEqual> map {{"Balmora", 1}, {"Vivec", 2}};
+        const auto it = StringUtils::ciFind(map, std::string_view("bALMORA"));
+        ASSERT_NE(it, map.end());
+        EXPECT_EQ(it->second, 1);
+        EXPECT_EQ(StringUtils::ciFind(map, std::string_view("Ald'ruhn")), map.end());
+    }
+}
@@ -0,0 +1,48 @@
+#include <components/misc/threadpool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace Misc;
+
+    TEST(MiscThreadPoolTest, runShouldCallTaskForEachIndexOnce)
+    {
+        ThreadPool pool(3);
+        for (std::size_t count : {0, 1, 2, 100, 1000})
+        {
+            std::vector<std::atomic_int> calls(count);
+            pool.run(count, [&] (std::size_t i) { ++calls[i]; });
+            for (std::size_t i = 0; i < count; ++i)
+                EXPECT_EQ(calls[i], 1) << count << " " << i;
+        }
+    }
+
+    TEST(MiscThreadPoolTest, runWithoutWorkersShouldCallTaskInOrder)
+    {
+        ThreadPool pool(0);
+        std::vector<std::size_t> indices;
+        pool.run(5, [&] (std::size_t i) { indices.push_back(i); });
+        EXPECT_EQ(indices, (std::vector<std::size_t> {0, 1, 2, 3, 4}));
+    }
+
+    TEST(MiscThreadPoolTest, runShouldRethrowExceptionAfterAllTasksAreDone)
+    {
+        ThreadPool pool(2);
+        std::atomic_int calls {0};
+        EXPECT_THROW(pool.run(50, [&] (std::size_t i)
+        {
+            ++calls;
+            if (i == 10)
+                throw std::runtime_error("error");
+        }), std::runtime_error);
+        EXPECT_EQ(calls, 50);
+        pool.run(10, [&] (std::size_t) { ++calls; });
+        EXPECT_EQ(calls, 60);
+    }
+}
@@ -0,0 +1,69 @@
+#include "apps/openmw/mwlua/shardidgenerator.hpp"
+
+#include <components/misc/threadpool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWLua;
+
+    std::vector<std::vector<ESM::RefNum>> generateInShards(ESM::RefNum lastAssigned, std::size_t shardsCount)
+    {
+        std::vector<std::vector<ESM::RefNum>> result(shardsCount);
+        Misc::ThreadPool threadPool(shardsCount - 1);
+        threadPool.run(shardsCount, [&](std::size_t i)
+        {
+            ShardIdGenerator generator(lastAssigned, i, shardsCount);
+            for (std::size_t j = 0; j < 100 * (i + 1); ++j)
+                result[i].push_back(generator.next());
+        });
+        return result;
+    }
+
+    TEST(MWLuaShardIdGeneratorTest, singleShardShouldFollowGetOrAssignRefNum)
+    {
+        ESM::RefNum lastAssigned;
+        lastAssigned.unset();
+        ShardIdGenerator generator(lastAssigned, 0, 1);
+        EXPECT_EQ(generator.next(), (ESM::RefNum {1, -1}));
+        EXPECT_EQ(generator.next(), (ESM::RefNum {2, -1}));
+        EXPECT_EQ(generator.getCount(), 2u);
+        EXPECT_EQ(ShardIdGenerator::getLastAssigned(lastAssigned, 1, 2), (ESM::RefNum {2, -1}));
+    }
+
+    TEST(MWLuaShardIdGeneratorTest, shouldDecrementContentFileWhenIndexOverflows)
+    {
+        ShardIdGenerator generator(ESM::RefNum {0xfffffffe, -1}, 0, 1);
+        EXPECT_EQ(generator.next(), (ESM::RefNum {0xffffffff, -1}));
+        EXPECT_EQ(generator.next(), (ESM::RefNum {0, -2}));
+    }
+
+    TEST(MWLuaShardIdGeneratorTest, parallelShardsShouldGenerateSameUniqueIdsOnEveryRun)
+    {
+        const ESM::RefNum lastAssigned {41, -1};
+        const std::size_t shardsCount = 3;
+        const std::vector<std::vector<ESM::RefNum>> ids = generateInShards(lastAssigned, shardsCount);
+        EXPECT_EQ(generateInShards(lastAssigned, shardsCount), ids);
+
+        std::set<std::pair<int, unsigned int>> unique;
+        for (const std::vector<ESM::RefNum>& shardIds : ids)
+            for (const ESM::RefNum& id : shardIds)
+                EXPECT_TRUE(unique.emplace(id.mContentFile, id.mIndex).second);
+        EXPECT_EQ(ids[1].front(), (ESM::RefNum {43, -1}));
+
+        // Ids generated after the shards are merged don't collide with theirs
+        const ESM::RefNum merged = ShardIdGenerator::getLastAssigned(lastAssigned, shardsCount, 300);
+        ShardIdGenerator next(merged, 0, 1);
+        for (int i = 0; i < 10; ++i)
+        {
+            const ESM::RefNum id = next.next();
+            EXPECT_EQ(unique.count({id.mContentFile, id.mIndex}), 0u);
+        }
+    }
+}
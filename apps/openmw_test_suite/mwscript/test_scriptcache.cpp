@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <components/compiler/scriptcache.hpp>
+
+namespace
+{
+    using namespace testing;
+
+    namespace bfs = boost::filesystem;
+
+    struct MWScriptScriptCacheTest : Test
+    {
+        const bfs::path mCachePath = bfs::path(UnitTest::GetInstance()->current_test_info()->name()) / "scripts.bin";
+
+        const std::string mSource = "begin test\nshort value\nfloat speed\nend";
+
+        Compiler::CompiledScript mScript;
+
+        MWScriptScriptCacheTest()
+        {
+            mScript.mByteCode = {1, 2, 0x2000000, 42};
+            mScript.mLocals.declare('s', "value");
+            mScript.mLocals.declare('f', "speed");
+        }
+
+        void SetUp() override
+        {
+            bfs::remove_all(mCachePath.parent_path());
+        }
+
+        void TearDown() override
+        {
+            bfs::remove_all(mCachePath.parent_path());
+        }
+
+        void saveScript(const std::string& key)
+        {
+            Compiler::ScriptCache cache(mCachePath, key);
+            cache.load();
+            cache.set("test", mSource, mScript);
+            cache.save();
+        }
+    };
+
+    TEST_F(MWScriptScriptCacheTest, getShouldReturnScriptSavedByPreviousRun)
+    {
+        saveScript("key");
+        Compiler::ScriptCache cache(mCachePath, "key");
+        cache.load();
+        const auto script = cache.get("test", mSource);
+        ASSERT_TRUE(script.has_value());
+        EXPECT_EQ(script->mByteCode, mScript.mByteCode);
+        EXPECT_THAT(script->mLocals.get('s'), ElementsAre("value"));
+        EXPECT_THAT(script->mLocals.get('l'), IsEmpty());
+        EXPECT_THAT(script->mLocals.get('f'), ElementsAre("speed"));
+    }
+
+    TEST_F(MWScriptScriptCacheTest, getShouldReturnNothingWhenSourceChanged)
+    {
+        saveScript("key");
+        Compiler::ScriptCache cache(mCachePath, "key");
+        cache.load();
+        EXPECT_EQ(cache.get("test", mSource + "\n"), std::nullopt);
+        EXPECT_EQ(cache.get("other", mSource), std::nullopt);
+    }
+
+    TEST_F(MWScriptScriptCacheTest, loadShouldDiscardCacheWithDifferentKey)
+    {
+        saveScript("key");
+        Compiler::ScriptCache cache(mCachePath, "other key");
+        cache.load();
+        EXPECT_EQ(cache.size(), 0u);
+        EXPECT_EQ(cache.get("test", mSource), std::nullopt);
+    }
+
+    TEST_F(MWScriptScriptCacheTest, loadShouldIgnoreCorruptedCache)
+    {
+        saveScript("key");
+        bfs::resize_file(mCachePath, bfs::file_size(mCachePath) - 1);
+        Compiler::ScriptCache cache(mCachePath, "key");
+        cache.load();
+        EXPECT_EQ(cache.get("test", mSource), std::nullopt);
+    }
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <sstream>
+#include <stdexcept>
 
 #include "test_utils.hpp"
 
@@ -49,6 +50,16 @@ namespace
             mInterpreter.run(&script.mByteCode[0], static_cast<int>(script.mByteCode.size()), context);
         }
 
+        std::vector<Interpreter::Instruction> decode(const CompiledScript& script) const
+        {
+            return mInterpreter.decode(&script.mByteCode[0], static_cast<int>(script.mByteCode.size()));
+        }
+
+        void run(const CompiledScript& script, const std::vector<Interpreter::Instruction>& instructions, TestInterpreterContext& context)
+        {
+            mInterpreter.run(&script.mByteCode[0], static_cast<int>(script.mByteCode.size()), instructions, context);
+        }
+
         template<typename T, typename ...TArgs>
         void installOpcode(int code, TArgs&& ...args)
         {
@@ -484,6 +495,50 @@ messagebox,"this is a %g",a
         }
     }
 
+    TEST_F(MWScriptTest, mwscript_test_decode_unknown_opcode)
+    {
+        registerExtensions();
+        if(const auto script = compile(sScript2))
+        {
+            EXPECT_THROW(decode(*script), std::runtime_error);
+        }
+        else
+        {
+            FAIL();
+        }
+    }
+
+    TEST_F(MWScriptTest, mwscript_test_run_decoded)
+    {
+        registerExtensions();
+        if(const auto script = compile(sScript2))
+        {
+            class AddTopic : public Interpreter::Opcode0
+            {
+                int& mCalls;
+            public:
+                AddTopic(int& calls) : mCalls(calls) {}
+
+                void execute(Interpreter::Runtime& runtime)
+                {
+                    runtime.pop();
+                    ++mCalls;
+                }
+            };
+            int calls = 0;
+            installOpcode<AddTopic>(Compiler::Dialogue::opcodeAddTopic, calls);
+            const std::vector<Interpreter::Instruction> instructions = decode(*script);
+            TestInterpreterContext context;
+            run(*script, instructions, context);
+            run(*script, instructions, context);
+            EXPECT_EQ(calls, 2);
+        }
+        else
+        {
+            FAIL();
+        }
+    }
+
     TEST_F(MWScriptTest, mwscript_test_math)
     {
         if(const auto script = compile(sScript3))
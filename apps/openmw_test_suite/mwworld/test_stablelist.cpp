@@ -0,0 +1,126 @@
+#include "apps/openmw/mwworld/stablelist.hpp"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWWorld;
+
+    template <class List>
+    std::vector<typename List::value_type> toVector(const List& list)
+    {
+        return std::vector<typename List::value_type>(list.begin(), list.end());
+    }
+
+    TEST(MWWorldStableListTest, insertShouldKeepOrder)
+    {
+        StableList<int, 2> list;
+        for (int i = 0; i < 5; ++i)
+            list.insert(i);
+        EXPECT_EQ(list.size(), 5u);
+        EXPECT_THAT(toVector(list), ElementsAre(0, 1, 2, 3, 4));
+        EXPECT_EQ(list.front(), 0);
+        EXPECT_EQ(list.back(), 4);
+    }
+
+    TEST(MWWorldStableListTest, insertShouldNotMoveElements)
+    {
+        StableList<std::string, 2> list;
+        const std::string& first = *list.emplace("first");
+        for (int i = 0; i < 100; ++i)
+            list.insert(std::to_string(i));
+        EXPECT_EQ(&first, &list.front());
+        EXPECT_EQ(first, "first");
+    }
+
+    TEST(MWWorldStableListTest, eraseShouldSkipErasedElements)
+    {
+        StableList<int, 2> list;
+        for (int i = 0; i < 5; ++i)
+            list.insert(i);
+        auto it = std::find(list.begin(), list.end(), 1);
+        it = list.erase(it);
+        EXPECT_EQ(*it, 2);
+        list.erase(std::find(list.begin(), list.end(), 4));
+        list.erase(list.begin());
+        EXPECT_EQ(list.size(), 2u);
+        EXPECT_THAT(toVector(list), ElementsAre(2, 3));
+        EXPECT_EQ(list.back(), 3);
+        EXPECT_EQ(*--list.end(), 3);
+    }
+
+    TEST(MWWorldStableListTest, iteratorsShouldStayValidAfterInsert)
+    {
+        StableList<int, 2> list;
+        list.insert(0);
+        const auto begin = list.begin();
+        const auto end = list.end();
+        list.insert(1);
+        EXPECT_EQ(*begin, 0);
+        EXPECT_EQ(std::distance(begin, end), 2);
+    }
+
+    TEST(MWWorldStableListTest, copyShouldSkipErasedElements)
+    {
+        StableList<int, 2> list;
+        for (int i = 0; i < 3; ++i)
+            list.insert(i);
+        list.erase(list.begin());
+        const StableList<int, 2> copy = list;
+        EXPECT_THAT(toVector(copy), ElementsAre(1, 2));
+        StableList<int, 2> moved = std::move(list);
+        EXPECT_THAT(toVector(moved), ElementsAre(1, 2));
+        EXPECT_TRUE(list.empty());
+    }
+
+    TEST(MWWorldStableListTest, constIteratorShouldCompareWithIterator)
+    {
+        StableList<int> list;
+        list.insert(0);
+        StableList<int>::const_iterator it = list.begin();
+        EXPECT_TRUE(it == list.begin());
+        EXPECT_TRUE(++it == list.end());
+    }
+
+    TEST(MWWorldStableListTest, insertShouldReuseErasedSlots)
+    {
+        StableList<std::string, 2> list;
+        for (int i = 0; i < 4; ++i)
+            list.insert(std::to_string(i));
+        const std::string& last = list.back();
+        list.erase(std::find(list.begin(), list.end(), "1"));
+        list.erase(std::find(list.begin(), list.end(), "2"));
+        const std::size_t capacity = list.capacity();
+        list.insert("4");
+        list.insert("5");
+        EXPECT_EQ(list.capacity(), capacity);
+        EXPECT_THAT(toVector(list), UnorderedElementsAre("0", "3", "4", "5"));
+        EXPECT_EQ(&last, &*std::find(list.begin(), list.end(), "3"));
+    }
+
+    TEST(MWWorldStableListTest, chunksShouldGrowGeometrically)
+    {
+        StableList<int> list;
+        EXPECT_EQ(list.capacity(), 0u);
+        list.insert(0);
+        EXPECT_EQ(list.capacity(), 4u);
+        for (int i = 1; i < 5; ++i)
+            list.insert(i);
+        EXPECT_EQ(list.capacity(), 12u);
+        for (int i = 5; i < 61; ++i)
+            list.insert(i);
+        EXPECT_EQ(list.capacity(), 124u);
+        std::vector<int> expected(61);
+        for (int i = 0; i < 61; ++i)
+            expected[i] = i;
+        EXPECT_EQ(toVector(list), expected);
+        list.clear();
+        EXPECT_EQ(list.capacity(), 0u);
+    }
+}
@@ -311,3 +311,123 @@ TEST_F(StoreTest, overwrite_test)
 
     ASSERT_TRUE (overwrittenRec && overwrittenRec->mModel == "the_new_model");
 }
+
+/// Tests that records parsed ahead of loading are added in the file order.
+TEST_F(StoreTest, load_parsed_test)
+{
+    ESM::ESMWriter writer;
+    auto* stream = new std::stringstream;
+    writer.setFormat(0);
+    writer.save(*stream);
+
+    ESM::Apparatus apparatus;
+    apparatus.blank();
+    apparatus.mId = "foo";
+    writer.startRecord(ESM::Apparatus::sRecordId);
+    apparatus.save(writer, false);
+    writer.endRecord(ESM::Apparatus::sRecordId);
+
+    ESM::Dialogue dialogue;
+    dialogue.blank();
+    dialogue.mId = "greeting";
+    writer.startRecord(ESM::Dialogue::sRecordId);
+    dialogue.save(writer, false);
+    writer.endRecord(ESM::Dialogue::sRecordId);
+
+    ESM::DialInfo info;
+    info.blank();
+    info.mId = "info";
+    writer.startRecord(ESM::DialInfo::sRecordId);
+    info.save(writer, false);
+    writer.endRecord(ESM::DialInfo::sRecordId);
+
+    writer.startRecord(ESM::Apparatus::sRecordId);
+    apparatus.save(writer, true);
+    writer.endRecord(ESM::Apparatus::sRecordId);
+
+    apparatus.mId = "Bar";
+    writer.startRecord(ESM::Apparatus::sRecordId);
+    apparatus.save(writer, false);
+    writer.endRecord(ESM::Apparatus::sRecordId);
+
+    ESM::ESMReader reader;
+    reader.open(Files::IStreamPtr(stream), "filename");
+
+    MWWorld::ESMStore::ParsedFile parsed;
+    mEsmStore.parse(reader, parsed);
+    ASSERT_EQ(parsed.mEntries.size(), 5u);
+    mEsmStore.load(reader, parsed, &dummyListener);
+
+    EXPECT_FALSE(reader.hasMoreRecs());
+    EXPECT_EQ(mEsmStore.get<ESM::Apparatus>().getSize(), 1u);
+    EXPECT_NE(mEsmStore.get<ESM::Apparatus>().search("bar"), nullptr);
+    ASSERT_NE(mEsmStore.get<ESM::Dialogue>().search("greeting"), nullptr);
+    EXPECT_EQ(mEsmStore.get<ESM::Dialogue>().search("greeting")->mInfo.size(), 1u);
+}
+
+/// Tests that a snapshot of the store is read back with the same records.
+TEST_F(StoreTest, snapshot_test)
+{
+    ESM::ESMWriter writer;
+    auto* stream = new std::stringstream;
+    writer.setFormat(0);
+    writer.save(*stream);
+
+    ESM::Apparatus apparatus;
+    apparatus.blank();
+    apparatus.mId = "foo";
+    apparatus.mModel = "foo.nif";
+    writer.startRecord(ESM::Apparatus::sRecordId);
+    apparatus.save(writer, false);
+    writer.endRecord(ESM::Apparatus::sRecordId);
+
+    ESM::Dialogue dialogue;
+    dialogue.blank();
+    dialogue.mId = "greeting";
+    writer.startRecord(ESM::Dialogue::sRecordId);
+    dialogue.save(writer, false);
+    writer.endRecord(ESM::Dialogue::sRecordId);
+
+    ESM::DialInfo info;
+    info.blank();
+    info.mId = "info";
+    writer.startRecord(ESM::DialInfo::sRecordId);
+    info.save(writer, false);
+    writer.endRecord(ESM::DialInfo::sRecordId);
+
+    ESM::Cell cell;
+    cell.blank();
+    cell.mName = "Cell";
+    cell.mData.mFlags = ESM::Cell::Interior;
+    writer.startRecord(ESM::Cell::sRecordId);
+    cell.save(writer, false);
+    writer.endRecord(ESM::Cell::sRecordId);
+
+    ESM::ESMReader reader;
+    reader.open(Files::IStreamPtr(stream), "filename");
+    mEsmStore.load(reader, &dummyListener);
+    mEsmStore.setUp();
+
+    std::stringstream snapshot;
+    ESM::ESMWriter snapshotWriter;
+    snapshotWriter.setFormat(0);
+    snapshotWriter.save(snapshot);
+    mEsmStore.writeSnapshot(snapshotWriter);
+    snapshotWriter.close();
+
+    MWWorld::ESMStore store;
+    ESM::ESMReader snapshotReader;
+    snapshotReader.open(Files::IStreamPtr(new std::stringstream(snapshot.str())), "snapshot");
+    store.readSnapshot(snapshotReader, &dummyListener);
+    store.setUp();
+
+    ASSERT_NE(store.get<ESM::Apparatus>().search("foo"), nullptr);
+    EXPECT_EQ(store.get<ESM::Apparatus>().search("foo")->mModel, "foo.nif");
+    ASSERT_NE(store.get<ESM::Dialogue>().search("greeting"), nullptr);
+    EXPECT_EQ(store.get<ESM::Dialogue>().search("greeting")->mInfo.size(), 1u);
+    const ESM::Cell* const loadedCell = store.get<ESM::Cell>().search("cell");
+    ASSERT_NE(loadedCell, nullptr);
+    ASSERT_EQ(loadedCell->mContextList.size(), 1u);
+    EXPECT_EQ(loadedCell->mContextList[0].filename, "filename");
+    EXPECT_EQ(loadedCell->mContextList[0].filePos, mEsmStore.get<ESM::Cell>().search("cell")->mContextList[0].filePos);
+}
@@ -0,0 +1,75 @@
+#include <components/nif/recordarena.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace Nif;
+
+    struct Tracked
+    {
+        std::vector<int>& mDestroyed;
+        int mId;
+
+        Tracked(std::vector<int>& destroyed, int id) : mDestroyed(destroyed), mId(id) {}
+
+        ~Tracked() { mDestroyed.push_back(mId); }
+    };
+
+    struct alignas(64) OverAligned
+    {
+        char mValue;
+    };
+
+    TEST(NifRecordArenaTest, createShouldConstructObject)
+    {
+        RecordArena arena;
+        const std::string* const value = arena.create<std::string>(3, 'a');
+        EXPECT_EQ(*value, "aaa");
+    }
+
+    TEST(NifRecordArenaTest, destructorShouldDestroyObjectsInReverseOrder)
+    {
+        std::vector<int> destroyed;
+        {
+            RecordArena arena;
+            arena.create<Tracked>(destroyed, 1);
+            arena.create<Tracked>(destroyed, 2);
+            EXPECT_TRUE(destroyed.empty());
+        }
+        EXPECT_EQ(destroyed, std::vector<int>({2, 1}));
+    }
+
+    TEST(NifRecordArenaTest, createShouldRespectAlignment)
+    {
+        RecordArena arena(256);
+        for (int i = 0; i < 10; ++i)
+        {
+            arena.create<char>('a');
+            const OverAligned* const value = arena.create<OverAligned>();
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(value) % alignof(OverAligned), 0u);
+        }
+    }
+
+    TEST(NifRecordArenaTest, createShouldPlaceSmallObjectsInOneBlock)
+    {
+        RecordArena arena(1024);
+        for (int i = 0; i < 100; ++i)
+            arena.create<int>(i);
+        EXPECT_EQ(arena.getAllocatedSize(), 1024u);
+    }
+
+    TEST(NifRecordArenaTest, createShouldSupportObjectsLargerThanBlock)
+    {
+        RecordArena arena(16);
+        struct Large { char mData[100]; };
+        Large* const value = arena.create<Large>();
+        value->mData[99] = 'a';
+        EXPECT_GE(arena.getAllocatedSize(), sizeof(Large));
+    }
+}
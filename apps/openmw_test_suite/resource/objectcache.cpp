@@ -0,0 +1,66 @@
+#include <components/resource/objectcache.hpp>
+
+#include <osg/Node>
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace
+{
+    using namespace testing;
+    using namespace Resource;
+
+    TEST(ResourceObjectCacheTest, updateAndRemoveExpiredShouldRemoveObjectsWithoutExternalReferences)
+    {
+        osg::ref_ptr<ObjectCache> cache(new ObjectCache);
+        cache->addEntryToObjectCache("a", new osg::Node);
+        cache->updateAndRemoveExpiredObjectsInCache(1, -4, 16);
+        EXPECT_EQ(cache->getCacheSize(), 1u);
+        cache->updateAndRemoveExpiredObjectsInCache(10, 5, 16);
+        EXPECT_EQ(cache->getCacheSize(), 0u);
+    }
+
+    TEST(ResourceObjectCacheTest, updateAndRemoveExpiredShouldKeepObjectsWithExternalReferences)
+    {
+        osg::ref_ptr<ObjectCache> cache(new ObjectCache);
+        osg::ref_ptr<osg::Node> node(new osg::Node);
+        cache->addEntryToObjectCache("a", node);
+        cache->updateAndRemoveExpiredObjectsInCache(1, -4, 16);
+        cache->updateAndRemoveExpiredObjectsInCache(10, 5, 16);
+        EXPECT_EQ(cache->getCacheSize(), 1u);
+        EXPECT_EQ(cache->getRefFromObjectCache("a").get(), node.get());
+    }
+
+    TEST(ResourceObjectCacheTest, updateAndRemoveExpiredShouldProcessAllShardsInRoundRobin)
+    {
+        osg::ref_ptr<ObjectCache> cache(new ObjectCache);
+        for (int i = 0; i < 100; ++i)
+            cache->addEntryToObjectCache(std::to_string(i), new osg::Node, 1);
+        std::size_t calls = 0;
+        while (cache->getCacheSize() > 0 && calls < 100)
+        {
+            const unsigned int size = cache->getCacheSize();
+            cache->updateAndRemoveExpiredObjectsInCache(10, 5, 2);
+            EXPECT_LE(cache->getCacheSize(), size);
+            ++calls;
+        }
+        EXPECT_EQ(cache->getCacheSize(), 0u);
+        EXPECT_LE(calls, 8u);
+    }
+
+    TEST(ResourceObjectCacheTest, takeStatsShouldReturnLookupsSincePreviousCall)
+    {
+        osg::ref_ptr<ObjectCache> cache(new ObjectCache);
+        cache->addEntryToObjectCache("a", new osg::Node);
+        cache->getRefFromObjectCache("a");
+        cache->getRefFromObjectCache("b");
+        const ObjectCache::Stats first = cache->takeStats();
+        EXPECT_EQ(first.mHits, 1u);
+        EXPECT_EQ(first.mMisses, 1u);
+        cache->getRefFromObjectCache("a");
+        const ObjectCache::Stats second = cache->takeStats();
+        EXPECT_EQ(second.mHits, 1u);
+        EXPECT_EQ(second.mMisses, 0u);
+    }
+}
@@ -0,0 +1,96 @@
+#include <components/vfs/indexcache.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <ctime>
+
+namespace
+{
+    using namespace testing;
+    using namespace VFS;
+
+    namespace bfs = boost::filesystem;
+
+    struct VFSIndexCacheTest : Test
+    {
+        const bfs::path mRoot = bfs::path(UnitTest::GetInstance()->current_test_info()->name()) / "data";
+        const bfs::path mCachePath = bfs::path(UnitTest::GetInstance()->current_test_info()->name()) / "vfsindex.bin";
+
+        void SetUp() override
+        {
+            bfs::remove_all(mRoot.parent_path());
+            bfs::create_directories(mRoot / "meshes");
+            bfs::ofstream(mRoot / "meshes" / "foo.nif");
+            bfs::ofstream(mRoot / "bar.dds");
+            makeOld(mRoot / "meshes");
+            makeOld(mRoot);
+        }
+
+        void TearDown() override
+        {
+            bfs::remove_all(mRoot.parent_path());
+        }
+
+        // Directories modified within the last second are not cached
+        static void makeOld(const bfs::path& path)
+        {
+            bfs::last_write_time(path, std::time(nullptr) - 60);
+        }
+    };
+
+    TEST_F(VFSIndexCacheTest, scanDirectoryShouldListFilesAndDirectories)
+    {
+        const DirectoryListing listing = scanDirectory(mRoot.string());
+        EXPECT_THAT(listing.mFiles, UnorderedElementsAre((mRoot / "meshes" / "foo.nif").string(), (mRoot / "bar.dds").string()));
+        EXPECT_EQ(listing.mDirectories.size(), 2u);
+    }
+
+    TEST_F(VFSIndexCacheTest, getShouldReturnListingSavedByPreviousRun)
+    {
+        {
+            IndexCache cache(mCachePath);
+            cache.load();
+            EXPECT_EQ(cache.get(mRoot.string()), std::nullopt);
+            cache.set(mRoot.string(), scanDirectory(mRoot.string()));
+            cache.save();
+        }
+        IndexCache cache(mCachePath);
+        cache.load();
+        const auto listing = cache.get(mRoot.string());
+        ASSERT_TRUE(listing.has_value());
+        EXPECT_EQ(listing->mFiles, scanDirectory(mRoot.string()).mFiles);
+    }
+
+    TEST_F(VFSIndexCacheTest, getShouldReturnNothingWhenSubdirectoryChanged)
+    {
+        {
+            IndexCache cache(mCachePath);
+            cache.set(mRoot.string(), scanDirectory(mRoot.string()));
+            cache.save();
+        }
+        bfs::ofstream(mRoot / "meshes" / "baz.nif");
+        IndexCache cache(mCachePath);
+        cache.load();
+        EXPECT_EQ(cache.get(mRoot.string()), std::nullopt);
+    }
+
+    TEST_F(VFSIndexCacheTest, setShouldIgnoreRecentlyModifiedDirectories)
+    {
+        IndexCache cache(mCachePath);
+        bfs::ofstream(mRoot / "recent.dds");
+        cache.set(mRoot.string(), scanDirectory(mRoot.string()));
+        EXPECT_EQ(cache.get(mRoot.string()), std::nullopt);
+    }
+
+    TEST_F(VFSIndexCacheTest, loadShouldIgnoreCorruptedFile)
+    {
+        bfs::ofstream(mCachePath, std::ios_base::binary) << "garbage";
+        IndexCache cache(mCachePath);
+        cache.load();
+        EXPECT_EQ(cache.get(mRoot.string()), std::nullopt);
+    }
+}
@@ -0,0 +1,137 @@
+#include <components/vfs/archive.hpp>
+#include <components/vfs/manager.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+
+    struct TestFile : VFS::File
+    {
+        explicit TestFile(std::string content) : mContent(std::move(content)) {}
+
+        Files::IStreamPtr open() override { return std::make_shared<std::istringstream>(mContent); }
+
+        std::string mContent;
+    };
+
+    struct TestArchive : VFS::Archive
+    {
+        std::map<std::string, TestFile> mFiles;
+
+        void listResources(std::map<std::string, VFS::File*>& out, char (*normalize)(char)) override
+        {
+            for (auto& [name, file] : mFiles)
+            {
+                std::string normalized = name;
+                std::transform(normalized.begin(), normalized.end(), normalized.begin(), normalize);
+                out[normalized] = &file;
+            }
+        }
+
+        bool contains(const std::string& file, char (*normalize)(char)) const override
+        {
+            return std::any_of(mFiles.begin(), mFiles.end(), [&] (const auto& v)
+            {
+                std::string normalized = v.first;
+                std::transform(normalized.begin(), normalized.end(), normalized.begin(), normalize);
+                return normalized == file;
+            });
+        }
+
+        std::string getDescription() const override { return "TestArchive"; }
+    };
+
+    std::string read(const Files::IStreamPtr& stream)
+    {
+        return std::string(std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>());
+    }
+
+    struct VFSManagerTest : Test
+    {
+        VFS::Manager mManager {false};
+
+        VFSManagerTest()
+        {
+            auto first = new TestArchive;
+            first->mFiles.emplace("Meshes\\Foo.nif", "first foo");
+            first->mFiles.emplace("meshes/bar.nif", "first bar");
+            auto second = new TestArchive;
+            second->mFiles.emplace("meshes/foo.nif", "second foo");
+            second->mFiles.emplace("textures/baz.dds", "second baz");
+            for (int i = 0; i < 100; ++i)
+                second->mFiles.emplace("textures/tx_" + std::to_string(i) + ".dds", std::to_string(i));
+            mManager.addArchive(first);
+            mManager.addArchive(second);
+            mManager.buildIndex();
+        }
+    };
+
+    TEST_F(VFSManagerTest, existsShouldFoldCaseAndSlashes)
+    {
+        EXPECT_TRUE(mManager.exists("meshes/foo.nif"));
+        EXPECT_TRUE(mManager.exists("MESHES\\FOO.NIF"));
+        EXPECT_TRUE(mManager.exists("Textures/Tx_42.dds"));
+        EXPECT_FALSE(mManager.exists("meshes/foo.ni"));
+        EXPECT_FALSE(mManager.exists("textures/tx_100.dds"));
+        EXPECT_FALSE(mManager.exists(""));
+    }
+
+    TEST_F(VFSManagerTest, getShouldReturnFileFromLastArchive)
+    {
+        EXPECT_EQ(read(mManager.get("Meshes\\Foo.nif")), "second foo");
+        EXPECT_EQ(read(mManager.get("meshes/bar.nif")), "first bar");
+        EXPECT_EQ(read(mManager.getNormalized("textures/tx_7.dds")), "7");
+    }
+
+    TEST_F(VFSManagerTest, getForMissingFileShouldThrow)
+    {
+        EXPECT_THROW(mManager.get("meshes/missing.nif"), std::runtime_error);
+    }
+
+    TEST_F(VFSManagerTest, getViewShouldFallbackToStream)
+    {
+        EXPECT_EQ(mManager.getView("textures\\baz.dds").getData(), "second baz");
+    }
+
+    TEST_F(VFSManagerTest, recursiveDirectoryIteratorShouldReturnFilesWithPrefix)
+    {
+        std::vector<std::string> names;
+        for (const auto& name : mManager.getRecursiveDirectoryIterator("Meshes\\"))
+            names.push_back(name);
+        EXPECT_THAT(names, ElementsAre("meshes/bar.nif", "meshes/foo.nif"));
+    }
+
+    TEST_F(VFSManagerTest, recursiveDirectoryIteratorForMissingPathShouldBeEmpty)
+    {
+        const auto range = mManager.getRecursiveDirectoryIterator("sound/");
+        EXPECT_FALSE(range.begin() != range.end());
+    }
+
+    TEST(VFSManagerStrictTest, existsShouldNotFoldCase)
+    {
+        VFS::Manager manager(true);
+        auto archive = new TestArchive;
+        archive->mFiles.emplace("Meshes\\Foo.nif", "foo");
+        manager.addArchive(archive);
+        manager.buildIndex();
+        EXPECT_TRUE(manager.exists("Meshes/Foo.nif"));
+        EXPECT_TRUE(manager.exists("Meshes\\Foo.nif"));
+        EXPECT_FALSE(manager.exists("meshes/foo.nif"));
+    }
+
+    TEST(VFSManagerEmptyTest, existsShouldReturnFalse)
+    {
+        VFS::Manager manager(false);
+        manager.buildIndex();
+        EXPECT_FALSE(manager.exists("meshes/foo.nif"));
+    }
+}
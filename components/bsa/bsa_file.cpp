@@ -255,15 +255,35 @@ void Bsa::BSAFile::close()
 
     mFiles.clear();
     mStringBuf.clear();
+    mMapping.reset();
     mIsLoaded = false;
 }
 
+void Bsa::BSAFile::mapArchive()
+{
+    if (!mIsLoaded)
+        fail("Unable to map the archive into memory, the archive is not opened");
+    if (mHasChanged)
+        fail("Unable to map the archive into memory, the archive has unsaved changes");
+    mMapping = std::make_shared<const Files::MemoryMappedFile>(mFilename);
+}
+
+Files::FileView Bsa::BSAFile::getFileView(const FileStruct *file)
+{
+    if (mMapping == nullptr)
+        return {};
+    return Files::makeFileView(mMapping, file->offset, file->fileSize);
+}
+
 void Bsa::BSAFile::addFile(const std::string& filename, std::istream& file)
 {
     if (!mIsLoaded)
         fail("Unable to add file " + filename + " the archive is not opened");
     namespace bfs = boost::filesystem;
 
+    // The mapping would not cover the moved and appended data
+    mMapping.reset();
+
     auto newStartOfDataBuffer = 12 + (12 + 8) * (mFiles.size() + 1) + mStringBuf.size() + filename.size() + 1;
     if (mFiles.empty())
         bfs::resize_file(mFilename, newStartOfDataBuffer);
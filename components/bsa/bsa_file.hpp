@@ -29,6 +29,7 @@
 #include <vector>
 
 #include <components/files/constrainedfilestream.hpp>
+#include <components/files/memorymappedfile.hpp>
 
 
 namespace Bsa
@@ -88,6 +89,9 @@ protected:
     /// Used for error messages
     std::string mFilename;
 
+    /// Whole archive mapped into memory, if requested with mapArchive()
+    std::shared_ptr<const Files::MemoryMappedFile> mMapping;
+
     /// Error handling
     [[noreturn]] void fail(const std::string &msg);
 
@@ -125,9 +129,25 @@ public:
     */
     Files::IStreamPtr getFile(const FileStruct *file)
     {
+        if (mMapping != nullptr)
+            return Files::openFileViewStream(getFileView(file));
         return Files::openConstrainedFileStream (mFilename.c_str (), file->offset, file->fileSize);
     }
 
+    /** Get a read-only view of a file contained in the archive, without opening or copying anything.
+     * @return An invalid view if the archive is not mapped into memory.
+     * @note Thread safe.
+    */
+    virtual Files::FileView getFileView(const FileStruct *file);
+
+    /// Map the whole archive into memory. Files are then served from the mapping instead of being
+    /// read through a newly opened file stream each time.
+    /// @note Must be called after open(), before any file is read from other threads.
+    void mapArchive();
+
+    bool isMapped() const
+    { return mMapping != nullptr; }
+
     virtual void addFile(const std::string& filename, std::istream& file);
 
     /// Get a list of all files
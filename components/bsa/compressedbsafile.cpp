@@ -24,6 +24,7 @@
  */
 #include "compressedbsafile.hpp"
 
+#include <atomic>
 #include <stdexcept>
 #include <cassert>
 
@@ -46,6 +47,7 @@
 #endif
 
 #include <boost/iostreams/device/array.hpp>
+#include <components/bsa/decompressedcache.hpp>
 #include <components/bsa/memorystream.hpp>
 #include <components/misc/stringops.hpp>
 
@@ -119,6 +121,10 @@ void CompressedBSAFile::readHeader()
 {
     assert(!mIsLoaded);
 
+    // Entries are cached by their offset, so each opened archive needs its own cache key
+    static std::atomic<std::uint64_t> nextCacheId {1};
+    mCacheId = nextCacheId++;
+
     namespace bfs = boost::filesystem;
     bfs::ifstream input(bfs::path(mFilename), std::ios_base::binary);
 
@@ -335,6 +341,36 @@ Files::IStreamPtr CompressedBSAFile::getFile(const FileStruct* file)
     return getFile(fileRec);
 }
 
+Files::FileView CompressedBSAFile::getFileView(const FileStruct* file)
+{
+    if (mMapping == nullptr)
+        return {};
+    FileRecord fileRec = getFileRecord(file->name());
+    if (!fileRec.isValid()) {
+        fail("File not found: " + std::string(file->name()));
+    }
+    if (fileRec.isCompressed(mCompressedByDefault))
+        return {};
+    return getRecordView(fileRec);
+}
+
+Files::FileView CompressedBSAFile::getRecordView(const FileRecord& fileRecord)
+{
+    std::size_t offset = fileRecord.offset;
+    std::size_t size = fileRecord.getSizeWithoutCompressionFlag();
+    if (mEmbeddedFileNames)
+    {
+        // Skip over the embedded file name
+        const Files::FileView length = Files::makeFileView(mMapping, offset, 1);
+        const std::size_t nameSize = static_cast<unsigned char>(length.mData[0]) + sizeof(char);
+        if (nameSize > size)
+            fail("Embedded file name is larger than the file record");
+        offset += nameSize;
+        size -= nameSize;
+    }
+    return Files::makeFileView(mMapping, offset, size);
+}
+
 void CompressedBSAFile::addFile(const std::string& filename, std::istream& file)
 {
     assert(false); //not implemented yet
@@ -352,58 +388,102 @@ Files::IStreamPtr CompressedBSAFile::getFile(const char* file)
 
 Files::IStreamPtr CompressedBSAFile::getFile(const FileRecord& fileRecord)
 {
-    size_t size = fileRecord.getSizeWithoutCompressionFlag();
-    size_t uncompressedSize = size;
-    bool compressed = fileRecord.isCompressed(mCompressedByDefault);
+    if (fileRecord.isCompressed(mCompressedByDefault))
+    {
+        const DecompressedCache::Buffer buffer = getDecompressed(fileRecord);
+        return Files::openFileViewStream(Files::FileView {buffer->data(), buffer->size(), buffer});
+    }
+
+    if (mMapping != nullptr)
+        return Files::openFileViewStream(getRecordView(fileRecord));
+
+    size_t size = 0;
+    Files::IStreamPtr streamPtr = openRecord(fileRecord, size);
+    std::shared_ptr<Bsa::MemoryInputStream> memoryStreamPtr = std::make_shared<MemoryInputStream>(size);
+    streamPtr->read(memoryStreamPtr->getRawData(), size);
+    return std::shared_ptr<std::istream>(memoryStreamPtr, (std::istream*)memoryStreamPtr.get());
+}
+
+void CompressedBSAFile::prefetch(const FileStruct* file)
+{
+    FileRecord fileRec = getFileRecord(file->name());
+    if (!fileRec.isValid()) {
+        fail("File not found: " + std::string(file->name()));
+    }
+    if (fileRec.isCompressed(mCompressedByDefault))
+        getDecompressed(fileRec);
+}
+
+Files::IStreamPtr CompressedBSAFile::openRecord(const FileRecord& fileRecord, size_t& size)
+{
+    if (mMapping != nullptr)
+    {
+        Files::FileView view = getRecordView(fileRecord);
+        size = view.mSize;
+        return Files::openFileViewStream(std::move(view));
+    }
+
+    size = fileRecord.getSizeWithoutCompressionFlag();
     Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilename.c_str(), fileRecord.offset, size);
-    std::istream* fileStream = streamPtr.get();
     if (mEmbeddedFileNames)
     {
         // Skip over the embedded file name
         char length = 0;
-        fileStream->read(&length, 1);
-        fileStream->ignore(length);
+        streamPtr->read(&length, 1);
+        streamPtr->ignore(length);
         size -= length + sizeof(char);
     }
-    if (compressed)
-    {
-        fileStream->read(reinterpret_cast<char*>(&uncompressedSize), sizeof(uint32_t));
-        size -= sizeof(uint32_t);
-    }
-    std::shared_ptr<Bsa::MemoryInputStream> memoryStreamPtr = std::make_shared<MemoryInputStream>(uncompressedSize);
+    return streamPtr;
+}
 
-    if (compressed)
+DecompressedCache::Buffer CompressedBSAFile::getDecompressed(const FileRecord& fileRecord)
+{
+    DecompressedCache& cache = getDecompressedCache();
+    if (DecompressedCache::Buffer cached = cache.get(mCacheId, fileRecord.offset))
+        return cached;
+    DecompressedCache::Buffer buffer = decompress(fileRecord);
+    cache.put(mCacheId, fileRecord.offset, buffer);
+    return buffer;
+}
+
+DecompressedCache::Buffer CompressedBSAFile::decompress(const FileRecord& fileRecord)
+{
+    size_t size = 0;
+    Files::IStreamPtr streamPtr = openRecord(fileRecord, size);
+    std::istream* fileStream = streamPtr.get();
+
+    uint32_t storedSize = 0;
+    fileStream->read(reinterpret_cast<char*>(&storedSize), sizeof(uint32_t));
+    size -= sizeof(uint32_t);
+    size_t uncompressedSize = storedSize;
+
+    auto buffer = std::make_shared<std::vector<char>>(uncompressedSize);
+
+    if (mVersion != 0x69) // Non-SSE: zlib
     {
-        if (mVersion != 0x69) // Non-SSE: zlib
-        {
-            boost::iostreams::filtering_streambuf<boost::iostreams::input> inputStreamBuf;
-            inputStreamBuf.push(boost::iostreams::zlib_decompressor());
-            inputStreamBuf.push(*fileStream);
+        boost::iostreams::filtering_streambuf<boost::iostreams::input> inputStreamBuf;
+        inputStreamBuf.push(boost::iostreams::zlib_decompressor());
+        inputStreamBuf.push(*fileStream);
 
-            boost::iostreams::basic_array_sink<char> sr(memoryStreamPtr->getRawData(), uncompressedSize);
-            boost::iostreams::copy(inputStreamBuf, sr);
-        }
-        else // SSE: lz4
-        {
-            boost::scoped_array<char> buffer(new char[size]);
-            fileStream->read(buffer.get(), size);
-            LZ4F_decompressionContext_t context = nullptr;
-            LZ4F_createDecompressionContext(&context, LZ4F_VERSION);
-            LZ4F_decompressOptions_t options = {};
-            LZ4F_errorCode_t errorCode = LZ4F_decompress(context, memoryStreamPtr->getRawData(), &uncompressedSize, buffer.get(), &size, &options);
-            if (LZ4F_isError(errorCode))
-                fail("LZ4 decompression error (file " + mFilename + "): " + LZ4F_getErrorName(errorCode));
-            errorCode = LZ4F_freeDecompressionContext(context);
-            if (LZ4F_isError(errorCode))
-                fail("LZ4 decompression error (file " + mFilename + "): " + LZ4F_getErrorName(errorCode));
-        }
+        boost::iostreams::basic_array_sink<char> sr(buffer->data(), uncompressedSize);
+        boost::iostreams::copy(inputStreamBuf, sr);
     }
-    else
+    else // SSE: lz4
     {
-        fileStream->read(memoryStreamPtr->getRawData(), size);
+        boost::scoped_array<char> compressed(new char[size]);
+        fileStream->read(compressed.get(), size);
+        LZ4F_decompressionContext_t context = nullptr;
+        LZ4F_createDecompressionContext(&context, LZ4F_VERSION);
+        LZ4F_decompressOptions_t options = {};
+        LZ4F_errorCode_t errorCode = LZ4F_decompress(context, buffer->data(), &uncompressedSize, compressed.get(), &size, &options);
+        if (LZ4F_isError(errorCode))
+            fail("LZ4 decompression error (file " + mFilename + "): " + LZ4F_getErrorName(errorCode));
+        errorCode = LZ4F_freeDecompressionContext(context);
+        if (LZ4F_isError(errorCode))
+            fail("LZ4 decompression error (file " + mFilename + "): " + LZ4F_getErrorName(errorCode));
     }
 
-    return std::shared_ptr<std::istream>(memoryStreamPtr, (std::istream*)memoryStreamPtr.get());
+    return buffer;
 }
 
 BsaVersion CompressedBSAFile::detectVersion(const std::string& filePath)
@@ -29,6 +29,7 @@
 #include <map>
 
 #include <components/bsa/bsa_file.hpp>
+#include <components/bsa/decompressedcache.hpp>
 
 namespace Bsa
 {
@@ -68,6 +69,9 @@ namespace Bsa
 
         std::uint32_t mVersion{0u};
 
+        /// Identifies this archive in the decompressed entries cache
+        std::uint64_t mCacheId{0u};
+
         struct FolderRecord
         {
             std::uint32_t count;
@@ -84,6 +88,13 @@ namespace Bsa
         /// \brief Normalizes given filename or folder and generates format-compatible hash. See https://en.uesp.net/wiki/Tes4Mod:Hash_Calculation.
         static std::uint64_t generateHash(std::string stem, std::string extension) ;
         Files::IStreamPtr getFile(const FileRecord& fileRecord);
+        /// Open the record data, skipping the embedded file name. Sets size to the remaining record size.
+        Files::IStreamPtr openRecord(const FileRecord& fileRecord, size_t& size);
+        /// Get the decompressed contents of a compressed record from the cache, decompressing it on a miss
+        DecompressedCache::Buffer getDecompressed(const FileRecord& fileRecord);
+        DecompressedCache::Buffer decompress(const FileRecord& fileRecord);
+        /// Get the range of the archive holding the record data, without the embedded file name
+        Files::FileView getRecordView(const FileRecord& fileRecord);
     public:
         CompressedBSAFile();
         virtual ~CompressedBSAFile();
@@ -96,6 +107,11 @@ namespace Bsa
        
         Files::IStreamPtr getFile(const char* filePath);
         Files::IStreamPtr getFile(const FileStruct* fileStruct);
+        /// Decompress a compressed file into the decompressed entries cache, so that getFile() doesn't have to.
+        /// @note Thread safe.
+        void prefetch(const FileStruct* fileStruct);
+        /// @return An invalid view if the archive is not mapped into memory or the file is compressed.
+        Files::FileView getFileView(const FileStruct* fileStruct) override;
         void addFile(const std::string& filename, std::istream& file) override;
     };
 }
@@ -0,0 +1,82 @@
+#include "decompressedcache.hpp"
+
+namespace Bsa
+{
+    DecompressedCache::DecompressedCache(std::size_t maxSize)
+        : mMaxSize(maxSize)
+    {
+    }
+
+    void DecompressedCache::setMaxSize(std::size_t maxSize)
+    {
+        const std::lock_guard<std::mutex> lock(mMutex);
+        mMaxSize = maxSize;
+        shrink(maxSize);
+    }
+
+    std::size_t DecompressedCache::getMaxSize() const
+    {
+        const std::lock_guard<std::mutex> lock(mMutex);
+        return mMaxSize;
+    }
+
+    DecompressedCache::Buffer DecompressedCache::get(std::uint64_t archiveId, std::uint32_t offset)
+    {
+        const std::lock_guard<std::mutex> lock(mMutex);
+        if (mMaxSize == 0)
+            return nullptr;
+        const auto it = mIndex.find(Key {archiveId, offset});
+        if (it == mIndex.end())
+        {
+            ++mStats.mMisses;
+            return nullptr;
+        }
+        ++mStats.mHits;
+        mEntries.splice(mEntries.begin(), mEntries, it->second);
+        return it->second->second;
+    }
+
+    void DecompressedCache::put(std::uint64_t archiveId, std::uint32_t offset, Buffer buffer)
+    {
+        const std::lock_guard<std::mutex> lock(mMutex);
+        if (mMaxSize == 0 || buffer->size() > mMaxSize)
+            return;
+        const Key key {archiveId, offset};
+        if (mIndex.find(key) != mIndex.end())
+            return;
+        shrink(mMaxSize - buffer->size());
+        mStats.mBytes += buffer->size();
+        ++mStats.mFiles;
+        mEntries.emplace_front(key, std::move(buffer));
+        mIndex.emplace(key, mEntries.begin());
+    }
+
+    void DecompressedCache::clear()
+    {
+        const std::lock_guard<std::mutex> lock(mMutex);
+        shrink(0);
+    }
+
+    DecompressedCache::Stats DecompressedCache::getStats() const
+    {
+        const std::lock_guard<std::mutex> lock(mMutex);
+        return mStats;
+    }
+
+    void DecompressedCache::shrink(std::size_t maxSize)
+    {
+        while (!mEntries.empty() && mStats.mBytes > maxSize)
+        {
+            mStats.mBytes -= mEntries.back().second->size();
+            --mStats.mFiles;
+            mIndex.erase(mEntries.back().first);
+            mEntries.pop_back();
+        }
+    }
+
+    DecompressedCache& getDecompressedCache()
+    {
+        static DecompressedCache cache(0);
+        return cache;
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef BSA_DECOMPRESSED_CACHE_H
+#define BSA_DECOMPRESSED_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Bsa
+{
+    /// @brief Least recently used cache of decompressed archive entries, bounded by the total size of the cached data.
+    /// @note Thread safe.
+    class DecompressedCache
+    {
+    public:
+        using Buffer = std::shared_ptr<const std::vector<char>>;
+
+        struct Stats
+        {
+            std::size_t mFiles = 0;
+            std::size_t mBytes = 0;
+            std::size_t mHits = 0;
+            std::size_t mMisses = 0;
+        };
+
+        explicit DecompressedCache(std::size_t maxSize);
+
+        /// Set the byte budget, evicting least recently used entries if needed. Zero disables the cache.
+        void setMaxSize(std::size_t maxSize);
+
+        std::size_t getMaxSize() const;
+
+        /// @return Decompressed data of the entry at the given offset of the given archive, or nullptr.
+        Buffer get(std::uint64_t archiveId, std::uint32_t offset);
+
+        /// Store the decompressed data, unless it alone is larger than the byte budget.
+        void put(std::uint64_t archiveId, std::uint32_t offset, Buffer buffer);
+
+        void clear();
+
+        Stats getStats() const;
+
+    private:
+        struct Key
+        {
+            std::uint64_t mArchiveId;
+            std::uint32_t mOffset;
+
+            bool operator==(const Key& other) const
+            {
+                return mArchiveId == other.mArchiveId && mOffset == other.mOffset;
+            }
+        };
+
+        struct KeyHash
+        {
+            std::size_t operator()(const Key& key) const
+            {
+                return std::hash<std::uint64_t>()(key.mArchiveId * 0x9E3779B97F4A7C15ull ^ key.mOffset);
+            }
+        };
+
+        using Entries = std::list<std::pair<Key, Buffer>>;
+
+        mutable std::mutex mMutex;
+        std::size_t mMaxSize;
+        Stats mStats;
+        /// Most recently used first.
+        Entries mEntries;
+        std::unordered_map<Key, Entries::iterator, KeyHash> mIndex;
+
+        void shrink(std::size_t maxSize);
+    };
+
+    /// Cache shared by all compressed archives.
+    DecompressedCache& getDecompressedCache();
+}
+
+#endif
@@ -1,6 +1,7 @@
 #include "extensions.hpp"
 
 #include <cassert>
+#include <ostream>
 #include <stdexcept>
 
 #include "generator.hpp"
@@ -207,4 +208,25 @@ namespace Compiler
         for (const auto & mKeyword : mKeywords)
             keywords.push_back (mKeyword.first);
     }
+
+    void Extensions::write (std::ostream& stream) const
+    {
+        for (const auto& [keyword, index] : mKeywords)
+        {
+            stream << keyword;
+
+            auto function = mFunctions.find (index);
+            if (function!=mFunctions.end())
+                stream << " function " << function->second.mReturn << ' ' << function->second.mArguments << ' '
+                    << function->second.mSegment << ' ' << function->second.mCode << ' '
+                    << function->second.mCodeExplicit;
+
+            auto instruction = mInstructions.find (index);
+            if (instruction!=mInstructions.end())
+                stream << " instruction " << instruction->second.mArguments << ' ' << instruction->second.mSegment
+                    << ' ' << instruction->second.mCode << ' ' << instruction->second.mCodeExplicit;
+
+            stream << '\n';
+        }
+    }
 }
@@ -4,6 +4,7 @@
 #include <string>
 #include <map>
 #include <vector>
+#include <iosfwd>
 
 #include <components/interpreter/types.hpp>
 
@@ -109,6 +110,9 @@ namespace Compiler
 
             void listKeywords (std::vector<std::string>& keywords) const;
             ///< Append all known keywords to \a kaywords.
+
+            void write (std::ostream& stream) const;
+            ///< Write all keywords with their argument types and opcodes, describing the code generated for them.
     };
 }
 
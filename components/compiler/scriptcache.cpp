@@ -0,0 +1,207 @@
+#include "scriptcache.hpp"
+
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/hash.hpp>
+#include <components/serialization/binaryreader.hpp>
+#include <components/serialization/binarywriter.hpp>
+#include <components/serialization/format.hpp>
+#include <components/serialization/sizeaccumulator.hpp>
+
+namespace Compiler
+{
+namespace
+{
+    constexpr char scriptCacheMagic[] = {'O', 'M', 'W', 'S', 'C', 'R', 'P', 'T'};
+    constexpr std::uint32_t scriptCacheVersion = 1;
+
+    struct ScriptCacheRecord
+    {
+        std::string mName;
+        std::array<std::uint64_t, 2> mSourceHash;
+        std::vector<Interpreter::Type_Code> mByteCode;
+        std::vector<std::string> mShorts;
+        std::vector<std::string> mLongs;
+        std::vector<std::string> mFloats;
+    };
+
+    struct ScriptCacheData
+    {
+        std::array<std::uint64_t, 2> mKeyHash;
+        std::vector<ScriptCacheRecord> mRecords;
+    };
+
+    template <Serialization::Mode mode>
+    struct ScriptCacheFormat : Serialization::Format<mode, ScriptCacheFormat<mode>>
+    {
+        using Serialization::Format<mode, ScriptCacheFormat<mode>>::operator();
+
+        template <class Visitor, class T>
+        auto operator()(Visitor&& visitor, T& value) const
+            -> std::enable_if_t<std::is_same_v<std::decay_t<T>, std::string>>
+        {
+            if constexpr (mode == Serialization::Mode::Write)
+                visitor(*this, value.size());
+            else
+            {
+                static_assert(mode == Serialization::Mode::Read);
+                std::size_t size = 0;
+                visitor(*this, size);
+                value.resize(size);
+            }
+            visitor(*this, value.data(), value.size());
+        }
+
+        template <class Visitor, class T>
+        auto operator()(Visitor&& visitor, T& value) const
+            -> std::enable_if_t<std::is_same_v<std::decay_t<T>, ScriptCacheRecord>>
+        {
+            visitor(*this, value.mName);
+            visitor(*this, value.mSourceHash.data(), value.mSourceHash.size());
+            visitor(*this, value.mByteCode);
+            visitor(*this, value.mShorts);
+            visitor(*this, value.mLongs);
+            visitor(*this, value.mFloats);
+        }
+
+        template <class Visitor, class T>
+        auto operator()(Visitor&& visitor, T& value) const
+            -> std::enable_if_t<std::is_same_v<std::decay_t<T>, ScriptCacheData>>
+        {
+            if constexpr (mode == Serialization::Mode::Write)
+            {
+                visitor(*this, scriptCacheMagic);
+                visitor(*this, scriptCacheVersion);
+            }
+            else
+            {
+                static_assert(mode == Serialization::Mode::Read);
+                char magic[std::size(scriptCacheMagic)];
+                visitor(*this, magic);
+                if (std::memcmp(magic, scriptCacheMagic, sizeof(magic)) != 0)
+                    throw std::runtime_error("Bad script cache magic");
+                std::uint32_t version = 0;
+                visitor(*this, version);
+                if (version != scriptCacheVersion)
+                    throw std::runtime_error("Bad script cache version");
+            }
+            visitor(*this, value.mKeyHash.data(), value.mKeyHash.size());
+            visitor(*this, value.mRecords);
+        }
+    };
+
+    Locals makeLocals(const ScriptCacheRecord& record)
+    {
+        Locals locals;
+        for (const std::string& name : record.mShorts)
+            locals.declare('s', name);
+        for (const std::string& name : record.mLongs)
+            locals.declare('l', name);
+        for (const std::string& name : record.mFloats)
+            locals.declare('f', name);
+        return locals;
+    }
+}
+
+    ScriptCache::ScriptCache (const boost::filesystem::path& path, const std::string& key)
+    : mPath (path), mKeyHash (Files::getHash (key))
+    {}
+
+    void ScriptCache::load()
+    {
+        ScriptCacheData cacheData;
+        try
+        {
+            boost::filesystem::ifstream stream (mPath, std::ios_base::binary);
+            if (!stream.is_open())
+                return;
+            std::vector<char> data ((std::istreambuf_iterator<char> (stream)), std::istreambuf_iterator<char>());
+            const std::byte* begin = reinterpret_cast<const std::byte*> (data.data());
+            constexpr ScriptCacheFormat<Serialization::Mode::Read> format;
+            format (Serialization::BinaryReader (begin, begin + data.size()), cacheData);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Ignoring script cache \"" << mPath.string() << "\": " << e.what();
+            return;
+        }
+
+        const std::lock_guard<std::mutex> lock (mMutex);
+        mEntries.clear();
+        // Scripts compiled against different content or extensions are rewritten from scratch
+        mChanged = cacheData.mKeyHash != mKeyHash;
+        if (mChanged)
+            return;
+        for (ScriptCacheRecord& record : cacheData.mRecords)
+            mEntries.emplace (record.mName,
+                Entry {record.mSourceHash, CompiledScript {std::move (record.mByteCode), makeLocals (record)}});
+    }
+
+    void ScriptCache::save()
+    {
+        ScriptCacheData cacheData;
+        cacheData.mKeyHash = mKeyHash;
+        {
+            const std::lock_guard<std::mutex> lock (mMutex);
+            if (!mChanged)
+                return;
+            mChanged = false;
+            cacheData.mRecords.reserve (mEntries.size());
+            for (const auto& [name, entry] : mEntries)
+            {
+                const Locals& locals = entry.mScript.mLocals;
+                cacheData.mRecords.push_back (ScriptCacheRecord {name, entry.mSourceHash, entry.mScript.mByteCode,
+                    locals.get ('s'), locals.get ('l'), locals.get ('f')});
+            }
+        }
+
+        try
+        {
+            constexpr ScriptCacheFormat<Serialization::Mode::Write> format;
+            Serialization::SizeAccumulator sizeAccumulator;
+            format (sizeAccumulator, cacheData);
+            std::vector<std::byte> data (sizeAccumulator.value());
+            format (Serialization::BinaryWriter (data.data(), data.data() + data.size()), cacheData);
+            boost::filesystem::create_directories (mPath.parent_path());
+            boost::filesystem::ofstream stream (mPath, std::ios_base::binary | std::ios_base::trunc);
+            stream.write (reinterpret_cast<const char*> (data.data()), static_cast<std::streamsize> (data.size()));
+            if (!stream)
+                throw std::runtime_error ("failed to write file");
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to save script cache \"" << mPath.string() << "\": " << e.what();
+        }
+    }
+
+    std::optional<CompiledScript> ScriptCache::get (const std::string& name, const std::string& source) const
+    {
+        const std::array<std::uint64_t, 2> sourceHash = Files::getHash (source);
+        const std::lock_guard<std::mutex> lock (mMutex);
+        const auto it = mEntries.find (name);
+        if (it == mEntries.end() || it->second.mSourceHash != sourceHash)
+            return {};
+        return it->second.mScript;
+    }
+
+    void ScriptCache::set (const std::string& name, const std::string& source, const CompiledScript& script)
+    {
+        Entry entry {Files::getHash (source), script};
+        const std::lock_guard<std::mutex> lock (mMutex);
+        mEntries.insert_or_assign (name, std::move (entry));
+        mChanged = true;
+    }
+
+    std::size_t ScriptCache::size() const
+    {
+        const std::lock_guard<std::mutex> lock (mMutex);
+        return mEntries.size();
+    }
+}
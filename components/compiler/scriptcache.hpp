@@ -0,0 +1,67 @@
+#ifndef COMPILER_SCRIPTCACHE_H_INCLUDED
+#define COMPILER_SCRIPTCACHE_H_INCLUDED
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem/path.hpp>
+
+#include <components/interpreter/types.hpp>
+
+#include "locals.hpp"
+
+namespace Compiler
+{
+    struct CompiledScript
+    {
+        std::vector<Interpreter::Type_Code> mByteCode;
+        Locals mLocals;
+    };
+
+    /// @brief On-disk cache of compiled scripts, so a script doesn't have to be compiled again in every session.
+    /// @par Besides the source text, the compiled code depends on the extensions, on the warnings mode and on the
+    /// records the compiler looks up (global variables, locals of other scripts, object IDs). All of the latter are
+    /// described by the key, a cache written with a different key is discarded. The source text is checked for each
+    /// script separately.
+    /// @note Thread safe.
+    class ScriptCache
+    {
+        public:
+
+            ScriptCache (const boost::filesystem::path& path, const std::string& key);
+
+            void load();
+            ///< Read the cache from disk. A missing, outdated or corrupted cache is ignored.
+
+            void save();
+            ///< Write the cache to disk if anything was added since load().
+
+            std::optional<CompiledScript> get (const std::string& name, const std::string& source) const;
+            ///< Return compiled script \a name if it was compiled from the same \a source.
+
+            void set (const std::string& name, const std::string& source, const CompiledScript& script);
+
+            std::size_t size() const;
+
+        private:
+
+            struct Entry
+            {
+                std::array<std::uint64_t, 2> mSourceHash;
+                CompiledScript mScript;
+            };
+
+            const boost::filesystem::path mPath;
+            const std::array<std::uint64_t, 2> mKeyHash;
+            mutable std::mutex mMutex;
+            std::map<std::string, Entry> mEntries;
+            bool mChanged = false;
+    };
+}
+
+#endif
@@ -0,0 +1,142 @@
+#include "asyncpathfinder.hpp"
+#include "findsmoothpath.hpp"
+#include "settings.hpp"
+#include "settingsutils.hpp"
+
+#include <iterator>
+#include <tuple>
+
+namespace DetourNavigator
+{
+    namespace
+    {
+        PathResult findPath(const Settings& settings, const PathRequest& request, const SharedNavMeshCacheItem& navMesh)
+        {
+            PathResult result;
+            if (navMesh == nullptr)
+                return result;
+            auto out = std::back_inserter(result.mPath);
+            result.mStatus = findSmoothPath(navMesh->lockConst()->getImpl(),
+                toNavMeshCoordinates(settings.mRecast, request.mAgentHalfExtents),
+                toNavMeshCoordinates(settings.mRecast, request.mStepSize),
+                toNavMeshCoordinates(settings.mRecast, request.mStart),
+                toNavMeshCoordinates(settings.mRecast, request.mEnd), request.mIncludeFlags, request.mAreaCosts,
+                settings, request.mEndTolerance, out);
+            return result;
+        }
+    }
+
+    bool operator<(const PathRequest& lhs, const PathRequest& rhs)
+    {
+        const auto tie = [] (const PathRequest& v)
+        {
+            return std::tie(v.mAgentHalfExtents, v.mStepSize, v.mStart, v.mEnd, v.mIncludeFlags,
+                v.mAreaCosts.mWater, v.mAreaCosts.mDoor, v.mAreaCosts.mPathgrid, v.mAreaCosts.mGround, v.mEndTolerance);
+        };
+        return tie(lhs) < tie(rhs);
+    }
+
+    PendingPath makeProcessedPath(PathResult&& result)
+    {
+        std::promise<PathResult> promise;
+        promise.set_value(std::move(result));
+        auto state = std::make_shared<PendingPath::State>();
+        state->mProcessed = true;
+        state->mResult = promise.get_future().share();
+        return PendingPath(std::move(state));
+    }
+
+    AsyncPathFinder::AsyncPathFinder(const Settings& settings, std::size_t threadsCount)
+        : mSettings(settings)
+        , mThreadPool(threadsCount > 0 ? threadsCount - 1 : 0)
+    {
+        if (threadsCount > 0)
+            mThread = std::thread([&] { run(); });
+    }
+
+    AsyncPathFinder::~AsyncPathFinder()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            mShouldStop = true;
+        }
+        mHasBatch.notify_all();
+        if (mThread.joinable())
+            mThread.join();
+    }
+
+    PendingPath AsyncPathFinder::request(const PathRequest& request)
+    {
+        const auto it = mQueued.find(request);
+        if (it != mQueued.end())
+            return PendingPath(it->second.mState);
+        Queued queued;
+        queued.mState = std::make_shared<PendingPath::State>();
+        queued.mState->mResult = queued.mResult.get_future().share();
+        PendingPath result(queued.mState);
+        mQueued.emplace(request, std::move(queued));
+        return result;
+    }
+
+    void AsyncPathFinder::process(const std::function<SharedNavMeshCacheItem (const osg::Vec3f&)>& getNavMesh)
+    {
+        if (mQueued.empty())
+            return;
+
+        std::map<osg::Vec3f, SharedNavMeshCacheItem> navMeshes;
+        std::vector<Job> batch;
+        batch.reserve(mQueued.size());
+        for (auto& [request, queued] : mQueued)
+        {
+            auto navMesh = navMeshes.find(request.mAgentHalfExtents);
+            if (navMesh == navMeshes.end())
+                navMesh = navMeshes.emplace(request.mAgentHalfExtents, getNavMesh(request.mAgentHalfExtents)).first;
+            queued.mState->mProcessed = true;
+            batch.push_back(Job {request, navMesh->second, std::move(queued.mResult)});
+        }
+        mQueued.clear();
+
+        if (!mThread.joinable())
+            return processBatch(batch);
+
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            mBatches.push_back(std::move(batch));
+        }
+        mHasBatch.notify_one();
+    }
+
+    void AsyncPathFinder::run()
+    {
+        while (true)
+        {
+            std::vector<Job> batch;
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mHasBatch.wait(lock, [&] { return mShouldStop || !mBatches.empty(); });
+                if (mShouldStop)
+                    return;
+                batch = std::move(mBatches.front());
+                mBatches.pop_front();
+            }
+            processBatch(batch);
+        }
+    }
+
+    void AsyncPathFinder::processBatch(std::vector<Job>& batch)
+    {
+        const Settings& settings = mSettings;
+        mThreadPool.run(batch.size(), [&] (std::size_t index)
+        {
+            Job& job = batch[index];
+            try
+            {
+                job.mResult.set_value(findPath(settings, job.mRequest, job.mNavMesh));
+            }
+            catch (...)
+            {
+                job.mResult.set_exception(std::current_exception());
+            }
+        });
+    }
+}
@@ -0,0 +1,121 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_ASYNCPATHFINDER_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_ASYNCPATHFINDER_H
+
+#include "areatype.hpp"
+#include "flags.hpp"
+#include "navmeshcacheitem.hpp"
+#include "status.hpp"
+
+#include <components/misc/threadpool.hpp>
+
+#include <osg/Vec3f>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace DetourNavigator
+{
+    struct Settings;
+
+    struct PathRequest
+    {
+        osg::Vec3f mAgentHalfExtents;
+        float mStepSize = 0;
+        osg::Vec3f mStart;
+        osg::Vec3f mEnd;
+        Flags mIncludeFlags = Flag_none;
+        AreaCosts mAreaCosts;
+        float mEndTolerance = 0;
+    };
+
+    bool operator<(const PathRequest& lhs, const PathRequest& rhs);
+
+    struct PathResult
+    {
+        Status mStatus = Status::NavMeshNotFound;
+        std::vector<osg::Vec3f> mPath;
+    };
+
+    /// @brief Path requested from Navigator::requestPath. Its search starts with the next
+    /// Navigator::processPathRequests call.
+    class PendingPath
+    {
+    public:
+        struct State
+        {
+            bool mProcessed = false;
+            std::shared_future<PathResult> mResult;
+        };
+
+        explicit PendingPath(std::shared_ptr<const State> state) : mState(std::move(state)) {}
+
+        /// Has the search been started. Only then get may be called.
+        bool isProcessed() const { return mState->mProcessed; }
+
+        /// Wait for the search to finish.
+        const PathResult& get() const { return mState->mResult.get(); }
+
+        /// Equal requests made before the same processPathRequests call share one search.
+        bool isSameSearch(const PendingPath& other) const { return mState == other.mState; }
+
+    private:
+        std::shared_ptr<const State> mState;
+    };
+
+    /// @brief Returns a pending path that is already found.
+    PendingPath makeProcessedPath(PathResult&& result);
+
+    /**
+     * @brief Searches for the paths requested during a frame together on background threads. A request made before
+     * process is called is searched for once, no matter how many equal requests are made.
+     */
+    class AsyncPathFinder
+    {
+    public:
+        /// @param threadsCount number of background threads, 0 searches for the paths in process
+        AsyncPathFinder(const Settings& settings, std::size_t threadsCount);
+
+        ~AsyncPathFinder();
+
+        PendingPath request(const PathRequest& request);
+
+        /// Start searching for all requested paths. getNavMesh is called on the calling thread once for each agent.
+        void process(const std::function<SharedNavMeshCacheItem (const osg::Vec3f&)>& getNavMesh);
+
+    private:
+        struct Queued
+        {
+            std::shared_ptr<PendingPath::State> mState;
+            std::promise<PathResult> mResult;
+        };
+
+        struct Job
+        {
+            PathRequest mRequest;
+            SharedNavMeshCacheItem mNavMesh;
+            std::promise<PathResult> mResult;
+        };
+
+        std::reference_wrapper<const Settings> mSettings;
+        std::map<PathRequest, Queued> mQueued;
+        Misc::ThreadPool mThreadPool;
+        std::mutex mMutex;
+        std::condition_variable mHasBatch;
+        std::deque<std::vector<Job>> mBatches;
+        bool mShouldStop = false;
+        std::thread mThread;
+
+        void run();
+
+        void processBatch(std::vector<Job>& batch);
+    };
+}
+
+#endif
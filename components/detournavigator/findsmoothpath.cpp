@@ -2,11 +2,26 @@
 
 #include <components/misc/convert.hpp>
 
+#include <DetourNode.h>
+
 #include <algorithm>
 #include <array>
+#include <memory>
 
 namespace DetourNavigator
 {
+    dtNavMeshQuery* getNavMeshQuery(const dtNavMesh& navMesh, const int maxNodes)
+    {
+        thread_local std::unique_ptr<dtNavMeshQuery> navMeshQuery;
+        // dtNavMeshQuery::init keeps a larger node pool, that would allow to search more nodes than requested
+        if (navMeshQuery == nullptr || navMeshQuery->getNodePool() == nullptr
+                || navMeshQuery->getNodePool()->getMaxNodes() != maxNodes)
+            navMeshQuery = std::make_unique<dtNavMeshQuery>();
+        if (!initNavMeshQuery(*navMeshQuery, navMesh, maxNodes))
+            return nullptr;
+        return navMeshQuery.get();
+    }
+
     std::size_t fixupCorridor(std::vector<dtPolyRef>& path, std::size_t pathSize, const std::vector<dtPolyRef>& visited)
     {
         std::vector<dtPolyRef>::const_reverse_iterator furthestVisited;
@@ -100,6 +100,14 @@ namespace DetourNavigator
         return dtStatusSucceed(status);
     }
 
+    /**
+     * @brief getNavMeshQuery returns a query owned by the calling thread and initialized for the given navmesh.
+     * The node pool and the open list are allocated on the first call and then only cleared, so the following
+     * queries made by the same thread don't allocate. Valid until the next call from the same thread.
+     * @return nullptr if initialization has failed.
+     */
+    dtNavMeshQuery* getNavMeshQuery(const dtNavMesh& navMesh, const int maxNodes);
+
     dtPolyRef findNearestPoly(const dtNavMeshQuery& query, const dtQueryFilter& filter,
             const osg::Vec3f& center, const osg::Vec3f& halfExtents);
 
@@ -260,9 +268,10 @@ namespace DetourNavigator
             const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags, const AreaCosts& areaCosts,
             const Settings& settings, float endTolerance, OutputIterator& out)
     {
-        dtNavMeshQuery navMeshQuery;
-        if (!initNavMeshQuery(navMeshQuery, navMesh, settings.mDetour.mMaxNavMeshQueryNodes))
+        dtNavMeshQuery* const query = getNavMeshQuery(navMesh, settings.mDetour.mMaxNavMeshQueryNodes);
+        if (query == nullptr)
             return Status::InitNavMeshQueryFailed;
+        dtNavMeshQuery& navMeshQuery = *query;
 
         dtQueryFilter queryFilter;
         queryFilter.setIncludeFlags(includeFlags);
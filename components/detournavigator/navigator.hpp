@@ -1,6 +1,7 @@
 ﻿#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVIGATOR_H
 #define OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVIGATOR_H
 
+#include "asyncpathfinder.hpp"
 #include "objectid.hpp"
 #include "navmeshcacheitem.hpp"
 #include "recastmeshtiles.hpp"
@@ -175,6 +176,19 @@ namespace DetourNavigator
          */
         virtual void wait(Loading::Listener& listener, WaitConditionType waitConditionType) = 0;
 
+        /**
+         * @brief requestPath queues a search for a path to be used later. Equal requests made before the same
+         * processPathRequests call are searched for once.
+         * @param request defines the path the same way findPath arguments do.
+         * @return path that is searched for after the next processPathRequests call.
+         */
+        virtual PendingPath requestPath(const PathRequest& request) = 0;
+
+        /**
+         * @brief processPathRequests starts searching for all paths requested since the last call in background threads.
+         */
+        virtual void processPathRequests() = 0;
+
         /**
          * @brief getNavMesh returns navmesh for specific agent half extents
          * @return navmesh
@@ -13,6 +13,7 @@ namespace DetourNavigator
         : mSettings(settings)
         , mNavMeshManager(mSettings, std::move(db))
         , mUpdatesEnabled(true)
+        , mAsyncPathFinder(mSettings, mSettings.mAsyncPathFinderThreads)
     {
     }
 
@@ -172,6 +173,16 @@ namespace DetourNavigator
         mNavMeshManager.wait(listener, waitConditionType);
     }
 
+    PendingPath NavigatorImpl::requestPath(const PathRequest& request)
+    {
+        return mAsyncPathFinder.request(request);
+    }
+
+    void NavigatorImpl::processPathRequests()
+    {
+        mAsyncPathFinder.process([&] (const osg::Vec3f& agentHalfExtents) { return getNavMesh(agentHalfExtents); });
+    }
+
     SharedNavMeshCacheItem NavigatorImpl::getNavMesh(const osg::Vec3f& agentHalfExtents) const
     {
         return mNavMeshManager.getNavMesh(agentHalfExtents);
@@ -54,6 +54,10 @@ namespace DetourNavigator
 
         void wait(Loading::Listener& listener, WaitConditionType waitConditionType) override;
 
+        PendingPath requestPath(const PathRequest& request) override;
+
+        void processPathRequests() override;
+
         SharedNavMeshCacheItem getNavMesh(const osg::Vec3f& agentHalfExtents) const override;
 
         std::map<osg::Vec3f, SharedNavMeshCacheItem> getNavMeshes() const override;
@@ -74,6 +78,7 @@ namespace DetourNavigator
         std::map<osg::Vec3f, std::size_t> mAgents;
         std::unordered_map<ObjectId, ObjectId> mAvoidIds;
         std::unordered_map<ObjectId, ObjectId> mWaterIds;
+        AsyncPathFinder mAsyncPathFinder;
 
         void updateAvoidShapeId(const ObjectId id, const ObjectId avoidId);
         void updateWaterShapeId(const ObjectId id, const ObjectId waterId);
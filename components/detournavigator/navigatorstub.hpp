@@ -78,6 +78,13 @@ namespace DetourNavigator
 
         void wait(Loading::Listener& /*listener*/, WaitConditionType /*waitConditionType*/) override {}
 
+        PendingPath requestPath(const PathRequest& /*request*/) override
+        {
+            return makeProcessedPath(PathResult {});
+        }
+
+        void processPathRequests() override {}
+
         SharedNavMeshCacheItem getNavMesh(const osg::Vec3f& /*agentHalfExtents*/) const override
         {
             return mEmptyNavMeshCacheItem;
@@ -12,9 +12,10 @@ namespace DetourNavigator
     std::optional<osg::Vec3f> raycast(const dtNavMesh& navMesh, const osg::Vec3f& halfExtents,
         const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags, const DetourSettings& settings)
     {
-        dtNavMeshQuery navMeshQuery;
-        if (!initNavMeshQuery(navMeshQuery, navMesh, settings.mMaxNavMeshQueryNodes))
+        dtNavMeshQuery* const query = getNavMeshQuery(navMesh, settings.mMaxNavMeshQueryNodes);
+        if (query == nullptr)
             return {};
+        dtNavMeshQuery& navMeshQuery = *query;
 
         dtQueryFilter queryFilter;
         queryFilter.setIncludeFlags(includeFlags);
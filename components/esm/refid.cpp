@@ -0,0 +1,73 @@
+#include "refid.hpp"
+
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include <components/misc/stringops.hpp>
+
+namespace ESM
+{
+    namespace
+    {
+        struct RefIdTable
+        {
+            std::shared_mutex mMutex;
+            /// Deque never moves its elements, so atoms can point into it.
+            std::deque<std::string> mValues;
+            std::unordered_map<std::string_view, const std::string*, Misc::StringUtils::CiHash, Misc::StringUtils::CiEqual> mIndex;
+            const std::string* mEmpty;
+
+            RefIdTable()
+                : mEmpty(&mValues.emplace_back())
+            {
+                mIndex.emplace(*mEmpty, mEmpty);
+            }
+        };
+
+        RefIdTable& getRefIdTable()
+        {
+            static RefIdTable table;
+            return table;
+        }
+    }
+
+    RefId::RefId()
+        : mValue(getRefIdTable().mEmpty)
+    {
+    }
+
+    RefId RefId::intern(std::string_view id)
+    {
+        if (const std::optional<RefId> existing = search(id))
+            return *existing;
+
+        RefIdTable& table = getRefIdTable();
+        const std::unique_lock lock(table.mMutex);
+        // Another thread may have interned the same ID since the lookup above
+        const auto it = table.mIndex.find(id);
+        if (it != table.mIndex.end())
+            return RefId(it->second);
+        const std::string& value = table.mValues.emplace_back(Misc::StringUtils::lowerCase(id));
+        table.mIndex.emplace(value, &value);
+        return RefId(&value);
+    }
+
+    std::optional<RefId> RefId::search(std::string_view id)
+    {
+        RefIdTable& table = getRefIdTable();
+        const std::shared_lock lock(table.mMutex);
+        const auto it = table.mIndex.find(id);
+        if (it == table.mIndex.end())
+            return std::nullopt;
+        return RefId(it->second);
+    }
+
+    std::size_t RefId::getCount()
+    {
+        RefIdTable& table = getRefIdTable();
+        const std::shared_lock lock(table.mMutex);
+        return table.mValues.size();
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef OPENMW_ESM_REFID_H
+#define OPENMW_ESM_REFID_H
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace ESM
+{
+    /// @brief Interned record ID.
+    /// Each distinct ID is stored once, lower-cased, for the lifetime of the process. Ids differing only by case share
+    /// the same atom, so comparing and hashing a RefId costs as much as for a pointer.
+    /// @note Thread safe.
+    class RefId
+    {
+    public:
+        /// The empty ID.
+        RefId();
+
+        /// @return Atom of the given ID, interning it if it was not seen before.
+        static RefId intern(std::string_view id);
+
+        /// @return Atom of the given ID if it was interned before. Doesn't intern anything.
+        static std::optional<RefId> search(std::string_view id);
+
+        /// @return Number of interned IDs.
+        static std::size_t getCount();
+
+        const std::string& getString() const { return *mValue; }
+
+        bool empty() const { return mValue->empty(); }
+
+        bool operator==(RefId other) const { return mValue == other.mValue; }
+
+        bool operator!=(RefId other) const { return mValue != other.mValue; }
+
+        /// Order of the atoms in memory, stable for the lifetime of the process only.
+        bool operator<(RefId other) const { return std::less<const std::string*>()(mValue, other.mValue); }
+
+        std::size_t hash() const { return std::hash<const std::string*>()(mValue); }
+
+    private:
+        const std::string* mValue;
+
+        explicit RefId(const std::string* value) : mValue(value) {}
+    };
+}
+
+namespace std
+{
+    template <>
+    struct hash<ESM::RefId>
+    {
+        std::size_t operator()(ESM::RefId id) const { return id.hash(); }
+    };
+}
+
+#endif
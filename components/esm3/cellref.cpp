@@ -46,7 +46,7 @@ void ESM::CellRef::loadId (ESMReader& esm, bool wideRefNum)
 
     mRefNum.load (esm, wideRefNum);
 
-    mRefID = esm.getHNOString ("NAME");
+    esm.toUtf8(esm.getHNOStringView("NAME"), mRefID);
     if (mRefID.empty())
     {
         Log(Debug::Warning) << "Warning: got CellRef with empty RefId in " << esm.getName() << " 0x" << std::hex << esm.getFileOffset();
@@ -71,16 +71,16 @@ void ESM::CellRef::loadData(ESMReader &esm, bool &isDeleted)
                 mScale = std::clamp(mScale, 0.5f, 2.0f);
                 break;
             case ESM::FourCC<'A','N','A','M'>::value:
-                mOwner = esm.getHString();
+                esm.toUtf8(esm.getHStringView(), mOwner);
                 break;
             case ESM::FourCC<'B','N','A','M'>::value:
-                mGlobalVariable = esm.getHString();
+                esm.toUtf8(esm.getHStringView(), mGlobalVariable);
                 break;
             case ESM::FourCC<'X','S','O','L'>::value:
-                mSoul = esm.getHString();
+                esm.toUtf8(esm.getHStringView(), mSoul);
                 break;
             case ESM::FourCC<'C','N','A','M'>::value:
-                mFaction = esm.getHString();
+                esm.toUtf8(esm.getHStringView(), mFaction);
                 break;
             case ESM::FourCC<'I','N','D','X'>::value:
                 esm.getHT(mFactionRank);
@@ -99,16 +99,16 @@ void ESM::CellRef::loadData(ESMReader &esm, bool &isDeleted)
                 mTeleport = true;
                 break;
             case ESM::FourCC<'D','N','A','M'>::value:
-                mDestCell = esm.getHString();
+                esm.toUtf8(esm.getHStringView(), mDestCell);
                 break;
             case ESM::FourCC<'F','L','T','V'>::value:
                 esm.getHT(mLockLevel);
                 break;
             case ESM::FourCC<'K','N','A','M'>::value:
-                mKey = esm.getHString();
+                esm.toUtf8(esm.getHStringView(), mKey);
                 break;
             case ESM::FourCC<'T','N','A','M'>::value:
-                mTrap = esm.getHString();
+                esm.toUtf8(esm.getHStringView(), mTrap);
                 break;
             case ESM::FourCC<'D','A','T','A'>::value:
                 esm.getHT(mPos, 24);
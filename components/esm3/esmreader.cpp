@@ -3,6 +3,7 @@
 #include <boost/filesystem/path.hpp>
 #include <components/misc/stringops.hpp>
 
+#include <algorithm>
 #include <stdexcept>
 
 namespace ESM
@@ -13,7 +14,7 @@ using namespace Misc;
 ESM_Context ESMReader::getContext()
 {
     // Update the file position before returning
-    mCtx.filePos = mEsm->tellg();
+    mCtx.filePos = getFileOffset();
     return mCtx;
 }
 
@@ -37,12 +38,26 @@ void ESMReader::restoreContext(const ESM_Context &rc)
     mCtx = rc;
 
     // Make sure we seek to the right place
-    mEsm->seekg(mCtx.filePos);
+    seek(mCtx.filePos);
+}
+
+void ESMReader::seek(size_t offset)
+{
+    if (isMapped())
+    {
+        if (offset > mView.mSize)
+            fail("Seek past the end of file");
+        mCursor = mView.mData + offset;
+    }
+    else
+        mEsm->seekg(offset);
 }
 
 void ESMReader::close()
 {
     mEsm.reset();
+    mView = Files::FileView {};
+    mCursor = nullptr;
     clearCtx();
     mHeader.blank();
 }
@@ -91,15 +106,51 @@ void ESMReader::openRaw(Files::IStreamPtr _esm, const std::string& name)
     mEsm->seekg(0, mEsm->beg);
 }
 
+void ESMReader::openRaw(Files::FileView view, const std::string& name)
+{
+    close();
+    mView = std::move(view);
+    mCursor = mView.mData;
+    mCtx.filename = name;
+    mCtx.leftFile = mFileSize = mView.mSize;
+}
+
 void ESMReader::openRaw(const std::string& filename)
 {
-    openRaw(Files::openConstrainedFileStream(filename.c_str()), filename);
+    std::shared_ptr<const Files::MemoryMappedFile> mapping;
+    try
+    {
+        mapping = std::make_shared<const Files::MemoryMappedFile>(filename);
+    }
+    catch (const std::exception&)
+    {
+        // Empty files and files on some special file systems can't be mapped
+        openRaw(Files::openConstrainedFileStream(filename.c_str()), filename);
+        return;
+    }
+    openRaw(Files::makeFileView(mapping, 0, mapping->size()), filename);
 }
 
 void ESMReader::open(Files::IStreamPtr _esm, const std::string &name)
 {
     openRaw(_esm, name);
+    loadHeader();
+}
+
+void ESMReader::open(Files::FileView view, const std::string &name)
+{
+    openRaw(std::move(view), name);
+    loadHeader();
+}
+
+void ESMReader::open(const std::string &file)
+{
+    openRaw(file);
+    loadHeader();
+}
 
+void ESMReader::loadHeader()
+{
     if (getRecName() != "TES3")
         fail("Not a valid Morrowind file");
 
@@ -108,11 +159,6 @@ void ESMReader::open(Files::IStreamPtr _esm, const std::string &name)
     mHeader.load (*this);
 }
 
-void ESMReader::open(const std::string &file)
-{
-    open (Files::openConstrainedFileStream (file.c_str ()), file);
-}
-
 std::string ESMReader::getHNOString(const char* name)
 {
     if (isNextSub(name))
@@ -127,6 +173,24 @@ std::string ESMReader::getHNString(const char* name)
 }
 
 std::string ESMReader::getHString()
+{
+    return toUtf8(getHStringView());
+}
+
+std::string_view ESMReader::getHNOStringView(const char* name)
+{
+    if (isNextSub(name))
+        return getHStringView();
+    return {};
+}
+
+std::string_view ESMReader::getHNStringView(const char* name)
+{
+    getSubNameIs(name);
+    return getHStringView();
+}
+
+std::string_view ESMReader::getHStringView()
 {
     getSubHeader();
 
@@ -135,16 +199,38 @@ std::string ESMReader::getHString()
     // them. For some reason, they break the rules, and contain a byte
     // (value 0) even if the header says there is no data. If
     // Morrowind accepts it, so should we.
-    if (mCtx.leftSub == 0 && hasMoreSubs() && !mEsm->peek())
+    if (mCtx.leftSub == 0 && hasMoreSubs() && peek() == 0)
     {
         // Skip the following zero byte
         mCtx.leftRec--;
         char c;
         getT(c);
-        return std::string();
+        return {};
     }
 
-    return getString(mCtx.leftSub);
+    return getStringView(mCtx.leftSub);
+}
+
+std::string ESMReader::toUtf8(std::string_view value)
+{
+    std::string result;
+    toUtf8(value, result);
+    return result;
+}
+
+void ESMReader::toUtf8(std::string_view value, std::string& out)
+{
+    // All supported encodings share ASCII with UTF8, and most strings in content files are plain ASCII
+    const bool ascii = std::all_of(value.begin(), value.end(), [] (char c) { return static_cast<unsigned char>(c) < 128; });
+    if (mEncoder == nullptr || ascii)
+    {
+        out.assign(value.data(), value.size());
+        return;
+    }
+
+    // The encoder reads up to a zero byte, and a view into a mapped file isn't followed by one
+    const std::string terminated(value);
+    out = mEncoder->getUtf8(terminated.data(), terminated.size());
 }
 
 void ESMReader::getHExact(void*p, int size)
@@ -303,26 +389,38 @@ void ESMReader::getRecHeader(uint32_t &flags)
 
 std::string ESMReader::getString(int size)
 {
-    size_t s = size;
-    if (mBuffer.size() <= s)
-        // Add some extra padding to reduce the chance of having to resize
-        // again later.
-        mBuffer.resize(3*s);
-
-    // And make sure the string is zero terminated
-    mBuffer[s] = 0;
-
-    // read ESM data
-    char *ptr = mBuffer.data();
-    getExact(ptr, size);
+    return toUtf8(getStringView(size));
+}
 
-    size = static_cast<int>(strnlen(ptr, size));
+std::string_view ESMReader::getStringView(int size)
+{
+    const char* ptr;
+    if (isMapped())
+    {
+        // Point straight into the file contents
+        ptr = advance(size);
+    }
+    else
+    {
+        size_t s = size;
+        if (mBuffer.size() <= s)
+            // Add some extra padding to reduce the chance of having to resize
+            // again later.
+            mBuffer.resize(3*s);
+
+        // read ESM data
+        getExact(mBuffer.data(), size);
+        ptr = mBuffer.data();
+    }
 
-    // Convert to UTF8 and return
-    if (mEncoder)
-        return mEncoder->getUtf8(ptr, size);
+    return std::string_view(ptr, strnlen(ptr, size));
+}
 
-    return std::string (ptr, size);
+int ESMReader::peek()
+{
+    if (isMapped())
+        return mCursor < mView.mData + mView.mSize ? static_cast<unsigned char>(*mCursor) : std::char_traits<char>::eof();
+    return mEsm->peek();
 }
 
 [[noreturn]] void ESMReader::fail(const std::string &msg)
@@ -333,8 +431,8 @@ std::string ESMReader::getString(int size)
     ss << "\n  File: " << mCtx.filename;
     ss << "\n  Record: " << mCtx.recName.toStringView();
     ss << "\n  Subrecord: " << mCtx.subName.toStringView();
-    if (mEsm.get())
-        ss << "\n  Offset: 0x" << std::hex << mEsm->tellg();
+    if (mEsm.get() || isMapped())
+        ss << "\n  Offset: 0x" << std::hex << getFileOffset();
     throw std::runtime_error(ss.str());
 }
 
@@ -3,10 +3,13 @@
 
 #include <cstdint>
 #include <cassert>
+#include <cstring>
 #include <vector>
 #include <sstream>
+#include <string_view>
 
 #include <components/files/constrainedfilestream.hpp>
+#include <components/files/memorymappedfile.hpp>
 
 #include <components/misc/stringops.hpp>
 
@@ -64,16 +67,23 @@ public:
   /// parse the header.
   void openRaw(Files::IStreamPtr _esm, const std::string &name);
 
+  /// Raw opening of file contents already in memory.
+  void openRaw(Files::FileView view, const std::string &name);
+
   /// Load ES file from a new stream, parses the header. Closes the
   /// currently open file first, if any.
   void open(Files::IStreamPtr _esm, const std::string &name);
 
+  /// Load ES file from contents already in memory, parses the header.
+  void open(Files::FileView view, const std::string &name);
+
+  /// Memory maps the file, falling back to a stream if it can't be mapped.
   void open(const std::string &file);
 
   void openRaw(const std::string &filename);
 
   /// Get the current position in the file. Make sure that the file has been opened!
-  size_t getFileOffset() const { return mEsm->tellg(); };
+  size_t getFileOffset() const { return isMapped() ? static_cast<size_t>(mCursor - mView.mData) : static_cast<size_t>(mEsm->tellg()); };
 
   // This is a quick hack for multiple esm/esp files. Each plugin introduces its own
   //  terrain palette, but ESMReader does not pass a reference to the correct plugin
@@ -152,6 +162,18 @@ public:
   // Read a string by the given name if it is the next record.
   std::string getHNOString(const char* name);
 
+  // Versions of the string reading methods that return the string as it is stored in the file, without converting
+  // it to UTF8. The view is valid until the file is closed if it is memory mapped, otherwise until the next read.
+  std::string_view getHNOStringView(const char* name);
+  std::string_view getHNStringView(const char* name);
+  std::string_view getHStringView();
+
+  // Convert a string returned by one of the view methods to UTF8
+  std::string toUtf8(std::string_view value);
+
+  // Same, but assigns the result to 'out' so that loaders reading into the same record can reuse its storage
+  void toUtf8(std::string_view value, std::string& out);
+
   // Read a string with the given sub-record name
   std::string getHNString(const char* name);
 
@@ -237,7 +259,13 @@ public:
   template <typename X>
   void getT(X &x) { getExact(&x, sizeof(X)); }
 
-  void getExact(void* x, int size) { mEsm->read((char*)x, size); }
+  void getExact(void* x, int size)
+  {
+      if (isMapped())
+          std::memcpy(x, advance(size), size);
+      else
+          mEsm->read((char*)x, size);
+  }
   void getName(NAME &name) { getT(name); }
   void getUint(uint32_t &u) { getT(u); }
 
@@ -245,7 +273,19 @@ public:
   // them from native encoding to UTF8 in the process.
   std::string getString(int size);
 
-  void skip(int bytes) { mEsm->seekg(getFileOffset()+bytes); };
+  // Read the next 'size' bytes as a string in the native encoding, up to the first zero byte
+  std::string_view getStringView(int size);
+
+  void skip(int bytes)
+  {
+      if (isMapped())
+          advance(bytes);
+      else
+          mEsm->seekg(getFileOffset()+bytes);
+  };
+
+  /// True if the file contents are in memory and reading is pointer arithmetic instead of stream calls
+  bool isMapped() const { return mView.isValid(); }
 
   /// Used for error handling
   [[noreturn]] void fail(const std::string &msg);
@@ -268,8 +308,29 @@ private:
 
   void clearCtx();
 
+  void seek(size_t offset);
+
+  void loadHeader();
+
+  // Next byte without consuming it, or EOF
+  int peek();
+
+  // Move the read position within mapped contents and return the previous one
+  const char* advance(int size)
+  {
+      if (size < 0 || static_cast<size_t>(size) > static_cast<size_t>(mView.mData + mView.mSize - mCursor))
+          fail("Read of " + std::to_string(size) + " bytes past the end of file");
+      const char* const result = mCursor;
+      mCursor += size;
+      return result;
+  }
+
   Files::IStreamPtr mEsm;
 
+  // Whole file contents and the read position when the file is memory mapped, used instead of mEsm
+  Files::FileView mView;
+  const char* mCursor = nullptr;
+
   ESM_Context mCtx;
 
   unsigned int mRecordFlags;
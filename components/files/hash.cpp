@@ -2,10 +2,12 @@
 
 #include <extern/smhasher/MurmurHash3.h>
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <istream>
 #include <string>
+#include <string_view>
 
 namespace Files
 {
@@ -38,4 +40,18 @@ namespace Files
         }
         return hash;
     }
+
+    std::array<std::uint64_t, 2> getHash(std::string_view data)
+    {
+        // Hash in the same blocks as the stream overload to get the same value
+        std::array<std::uint64_t, 2> hash {0, 0};
+        for (std::size_t offset = 0; offset < data.size(); offset += 4096)
+        {
+            const std::size_t size = std::min<std::size_t>(4096, data.size() - offset);
+            std::array<std::uint64_t, 2> blockHash {0, 0};
+            MurmurHash3_x64_128(data.data() + offset, static_cast<int>(size), hash.data(), blockHash.data());
+            hash = blockHash;
+        }
+        return hash;
+    }
 }
@@ -5,10 +5,14 @@
 #include <cstdint>
 #include <istream>
 #include <string>
+#include <string_view>
 
 namespace Files
 {
     std::array<std::uint64_t, 2> getHash(const std::string& fileName, std::istream& stream);
+
+    /// Same as the stream overload for the same contents, without the stream overhead.
+    std::array<std::uint64_t, 2> getHash(std::string_view data);
 }
 
 #endif
@@ -0,0 +1,48 @@
+#include "memorymappedfile.hpp"
+
+#include "memorystream.hpp"
+
+#include <stdexcept>
+
+namespace Files
+{
+    namespace
+    {
+        struct FileViewStream : IMemStream
+        {
+            explicit FileViewStream(FileView view)
+                : MemBuf(view.mData, view.mSize)
+                , IMemStream(view.mData, view.mSize)
+                , mView(std::move(view))
+            {
+            }
+
+            FileView mView;
+        };
+    }
+
+    MemoryMappedFile::MemoryMappedFile(const std::string& path)
+    {
+        try
+        {
+            mSource.open(path);
+        }
+        catch (const std::exception& e)
+        {
+            throw std::runtime_error("Failed to map file \"" + path + "\" into memory: " + std::string(e.what()));
+        }
+    }
+
+    FileView makeFileView(const std::shared_ptr<const MemoryMappedFile>& file, std::size_t start, std::size_t length)
+    {
+        if (start > file->size() || length > file->size() - start)
+            throw std::runtime_error("File view [" + std::to_string(start) + ", " + std::to_string(start + length)
+                                     + ") is outside of mapped file of size " + std::to_string(file->size()));
+        return FileView {file->data() + start, length, file};
+    }
+
+    IStreamPtr openFileViewStream(FileView view)
+    {
+        return std::make_shared<FileViewStream>(std::move(view));
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef COMPONENTS_FILES_MEMORYMAPPEDFILE_H
+#define COMPONENTS_FILES_MEMORYMAPPEDFILE_H
+
+#include "constrainedfilestream.hpp"
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace Files
+{
+    /// @brief Read-only view of a contiguous range of file contents.
+    /// @par The view keeps a reference to the owner of the memory it points into, so the data stays valid for as
+    /// long as the view or any copy of it is alive.
+    struct FileView
+    {
+        const char* mData = nullptr;
+        std::size_t mSize = 0;
+        std::shared_ptr<const void> mOwner;
+
+        /// False for a default constructed view, i.e. when no data could be provided.
+        bool isValid() const { return mOwner != nullptr; }
+
+        std::string_view getData() const { return std::string_view(mData, mSize); }
+    };
+
+    /// @brief A whole file mapped into memory for reading.
+    /// @note Thread safe once constructed.
+    class MemoryMappedFile
+    {
+    public:
+        /// @note Throws an exception if the file can not be mapped.
+        explicit MemoryMappedFile(const std::string& path);
+
+        const char* data() const { return mSource.data(); }
+
+        std::size_t size() const { return mSource.size(); }
+
+    private:
+        boost::iostreams::mapped_file_source mSource;
+    };
+
+    /// Make a view of the [start, start + length) range of the given mapping. The view shares ownership of the mapping.
+    /// @note Throws an exception if the range is outside of the mapped file.
+    FileView makeFileView(const std::shared_ptr<const MemoryMappedFile>& file, std::size_t start, std::size_t length);
+
+    /// Wrap a view into a stream for the consumers that still need one. Reading from it does no copies into
+    /// intermediate buffers and no system calls.
+    IStreamPtr openFileViewStream(FileView view);
+}
+
+#endif
@@ -20,18 +20,20 @@ namespace Interpreter
     }
 
     template<typename T>
-    auto& getDispatcher(const T& segment, unsigned int seg, int opcode)
+    auto getDispatcher(const T& segment, unsigned int seg, int opcode)
     {
         auto it = segment.find(opcode);
         if (it == segment.end())
         {
             abortUnknownCode(seg, opcode);
         }
-        return it->second;
+        return it->second.get();
     }
 
-    void Interpreter::execute (Type_Code code)
+    Instruction Interpreter::decodeInstruction (Type_Code code) const
     {
+        Instruction result;
+
         unsigned int segSpec = code >> 30;
 
         switch (segSpec)
@@ -39,17 +41,17 @@ namespace Interpreter
             case 0:
             {
                 const int opcode = code >> 24;
-                const unsigned int arg0 = code & 0xffffff;
-
-                return getDispatcher(mSegment0, 0, opcode)->execute(mRuntime, arg0);
+                result.mOpcode1 = getDispatcher(mSegment0, 0, opcode);
+                result.mArg0 = code & 0xffffff;
+                return result;
             }
 
             case 2:
             {
                 const int opcode = (code >> 20) & 0x3ff;
-                const unsigned int arg0 = code & 0xfffff;
-
-                return getDispatcher(mSegment2, 2, opcode)->execute(mRuntime, arg0);
+                result.mOpcode1 = getDispatcher(mSegment2, 2, opcode);
+                result.mArg0 = code & 0xfffff;
+                return result;
             }
         }
 
@@ -60,22 +62,39 @@ namespace Interpreter
             case 0x30:
             {
                 const int opcode = (code >> 8) & 0x3ffff;
-                const unsigned int arg0 = code & 0xff;
-
-                return getDispatcher(mSegment3, 3, opcode)->execute(mRuntime, arg0);
+                result.mOpcode1 = getDispatcher(mSegment3, 3, opcode);
+                result.mArg0 = code & 0xff;
+                return result;
             }
 
             case 0x32:
             {
                 const int opcode = code & 0x3ffffff;
-
-                return getDispatcher(mSegment5, 5, opcode)->execute(mRuntime);
+                result.mOpcode0 = getDispatcher(mSegment5, 5, opcode);
+                return result;
             }
         }
 
         abortUnknownSegment (code);
     }
 
+    std::vector<Instruction> Interpreter::decode (const Type_Code *code, int codeSize) const
+    {
+        assert (codeSize>=4);
+
+        const int opcodes = static_cast<int> (code[0]);
+
+        const Type_Code *codeBlock = code + 4;
+
+        std::vector<Instruction> result;
+        result.reserve(opcodes);
+
+        for (int i = 0; i < opcodes; ++i)
+            result.push_back(decodeInstruction(codeBlock[i]));
+
+        return result;
+    }
+
     void Interpreter::begin()
     {
         if (mRunning)
@@ -106,9 +125,10 @@ namespace Interpreter
     Interpreter::Interpreter() : mRunning (false)
     {}
 
-    void Interpreter::run (const Type_Code *code, int codeSize, Context& context)
+    void Interpreter::run (const Type_Code *code, int codeSize, const std::vector<Instruction>& instructions, Context& context)
     {
         assert (codeSize>=4);
+        assert (instructions.size() == code[0]);
 
         begin();
 
@@ -116,15 +136,16 @@ namespace Interpreter
         {
             mRuntime.configure (code, codeSize, context);
 
-            int opcodes = static_cast<int> (code[0]);
-
-            const Type_Code *codeBlock = code + 4;
+            const int opcodes = static_cast<int> (instructions.size());
 
             while (mRuntime.getPC()>=0 && mRuntime.getPC()<opcodes)
             {
-                Type_Code runCode = codeBlock[mRuntime.getPC()];
+                const Instruction& instruction = instructions[mRuntime.getPC()];
                 mRuntime.setPC (mRuntime.getPC()+1);
-                execute (runCode);
+                if (instruction.mOpcode1 != nullptr)
+                    instruction.mOpcode1->execute (mRuntime, instruction.mArg0);
+                else
+                    instruction.mOpcode0->execute (mRuntime);
             }
         }
         catch (...)
@@ -135,4 +156,9 @@ namespace Interpreter
 
         end();
     }
+
+    void Interpreter::run (const Type_Code *code, int codeSize, Context& context)
+    {
+        run (code, codeSize, decode (code, codeSize), context);
+    }
 }
@@ -6,6 +6,7 @@
 #include <memory>
 #include <cassert>
 #include <utility>
+#include <vector>
 
 #include "runtime.hpp"
 #include "types.hpp"
@@ -13,6 +14,14 @@
 
 namespace Interpreter
 {
+    /// Instruction with its opcode already looked up, see Interpreter::decode.
+    struct Instruction
+    {
+        Opcode0* mOpcode0 = nullptr; ///< segment 5
+        Opcode1* mOpcode1 = nullptr; ///< other segments
+        unsigned int mArg0 = 0;
+    };
+
     class Interpreter
     {
             std::stack<Runtime> mCallstack;
@@ -27,7 +36,7 @@ namespace Interpreter
             Interpreter (const Interpreter&);
             Interpreter& operator= (const Interpreter&);
 
-            void execute (Type_Code code);
+            Instruction decodeInstruction (Type_Code code) const;
 
             void begin();
 
@@ -68,6 +77,13 @@ namespace Interpreter
                 installSegment(mSegment5, code, std::make_unique<T>(std::forward<TArgs>(args)...));
             }
 
+            std::vector<Instruction> decode (const Type_Code *code, int codeSize) const;
+            ///< Look up the opcodes of all instructions in \a code.
+            /// \note Throws on unknown opcodes, so a script using them is rejected before running.
+
+            void run (const Type_Code *code, int codeSize, const std::vector<Instruction>& instructions, Context& context);
+            ///< \a instructions must be the result of decode for \a code.
+
             void run (const Type_Code *code, int codeSize, Context& context);
     };
 }
@@ -85,6 +85,7 @@ namespace LuaUtil
         virtual ~ScriptsContainer();
 
         ESM::LuaScriptCfg::Flags getAutoStartMode() const { return mAutoStartMode; }
+        LuaState& getLuaState() const { return mLua; }
 
         // Adds package that will be available (via `require`) for all scripts in the container.
         // Automatically applies LuaUtil::makeReadOnly to the package.
@@ -318,14 +318,20 @@ namespace LuaUtil
 
     BinaryData serialize(const sol::object& obj, const UserdataSerializer* customSerializer)
     {
-        if (obj == sol::nil)
-            return "";
         BinaryData res;
-        res.push_back(FORMAT_VERSION);
-        serialize(res, obj, customSerializer, 0);
+        serialize(res, obj, customSerializer);
         return res;
     }
 
+    void serialize(BinaryData& out, const sol::object& obj, const UserdataSerializer* customSerializer)
+    {
+        out.clear();
+        if (obj == sol::nil)
+            return;
+        out.push_back(FORMAT_VERSION);
+        serialize(out, obj, customSerializer, 0);
+    }
+
     sol::object deserialize(lua_State* lua, std::string_view binaryData,
                             const UserdataSerializer* customSerializer, bool readOnly)
     {
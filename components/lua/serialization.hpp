@@ -27,6 +27,8 @@ namespace LuaUtil
     };
 
     BinaryData serialize(const sol::object&, const UserdataSerializer* customSerializer = nullptr);
+    // Same as above, but writes to `out` reusing its memory. Previous content of `out` is discarded.
+    void serialize(BinaryData& out, const sol::object&, const UserdataSerializer* customSerializer = nullptr);
     sol::object deserialize(lua_State* lua, std::string_view binaryData,
                             const UserdataSerializer* customSerializer = nullptr, bool readOnly = false);
 
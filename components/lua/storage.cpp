@@ -22,8 +22,10 @@ namespace LuaUtil
         return deserialize(L, mSerializedValue);
     }
 
-    sol::object LuaStorage::Value::getReadOnly(lua_State* L) const
+    sol::object LuaStorage::Value::getReadOnly(lua_State* L, bool cache) const
     {
+        if (!cache)
+            return mSerializedValue.empty() ? sol::object(sol::nil) : deserialize(L, mSerializedValue, nullptr, true);
         if (mReadOnlyValue == sol::nil && !mSerializedValue.empty())
             mReadOnlyValue = deserialize(L, mSerializedValue, nullptr, true);
         return mReadOnlyValue;
@@ -53,11 +55,17 @@ namespace LuaUtil
         return res;
     }
 
-    sol::table LuaStorage::Section::asTable()
+    sol::object LuaStorage::Section::getReadOnly(lua_State* L, std::string_view key) const
     {
-        sol::table res(mStorage->mLua, sol::create);
+        // The cached value belongs to the Lua state of the storage, other states get their own copy.
+        return get(key).getReadOnly(L, sol::main_thread(L, L) == mStorage->mLua);
+    }
+
+    sol::table LuaStorage::Section::asTable(lua_State* L)
+    {
+        sol::table res(L, sol::create);
         for (const auto& [k, v] : mValues)
-            res[k] = v.getCopy(mStorage->mLua);
+            res[k] = v.getCopy(L);
         return res;
     }
 
@@ -68,24 +76,24 @@ namespace LuaUtil
         sol::usertype<SectionMutableView> mutableView = lua.new_usertype<SectionMutableView>("MutableSection");
         roView["get"] = [](sol::this_state s, SectionReadOnlyView& section, std::string_view key)
         {
-            return section.mSection->get(key).getReadOnly(s);
+            return section.mSection->getReadOnly(s, key);
         };
         roView["getCopy"] = [](sol::this_state s, SectionReadOnlyView& section, std::string_view key)
         {
             return section.mSection->get(key).getCopy(s);
         };
         roView["wasChanged"] = [](SectionReadOnlyView& section) { return section.mSection->wasChanged(section.mLastCheck); };
-        roView["asTable"] = [](SectionReadOnlyView& section) { return section.mSection->asTable(); };
+        roView["asTable"] = [](sol::this_state s, SectionReadOnlyView& section) { return section.mSection->asTable(s); };
         mutableView["get"] = [](sol::this_state s, SectionMutableView& section, std::string_view key)
         {
-            return section.mSection->get(key).getReadOnly(s);
+            return section.mSection->getReadOnly(s, key);
         };
         mutableView["getCopy"] = [](sol::this_state s, SectionMutableView& section, std::string_view key)
         {
             return section.mSection->get(key).getCopy(s);
         };
         mutableView["wasChanged"] = [](SectionMutableView& section) { return section.mSection->wasChanged(section.mLastCheck); };
-        mutableView["asTable"] = [](SectionMutableView& section) { return section.mSection->asTable(); };
+        mutableView["asTable"] = [](sol::this_state s, SectionMutableView& section) { return section.mSection->asTable(s); };
         mutableView["reset"] = [](SectionMutableView& section, sol::optional<sol::table> newValues)
         {
             section.mSection->mValues.clear();
@@ -117,6 +125,7 @@ namespace LuaUtil
 
     void LuaStorage::clearTemporary()
     {
+        const std::lock_guard<std::mutex> lock(mDataMutex);
         auto it = mData.begin();
         while (it != mData.end())
         {
@@ -158,7 +167,7 @@ namespace LuaUtil
         for (const auto& [sectionName, section] : mData)
         {
             if (section->mPermanent)
-                data[sectionName] = section->asTable();
+                data[sectionName] = section->asTable(mLua);
         }
         std::string serializedData = serialize(data);
         Log(Debug::Info) << "Saving Lua storage \"" << path << "\" (" << serializedData.size() << " bytes)";
@@ -169,6 +178,7 @@ namespace LuaUtil
 
     const std::shared_ptr<LuaStorage::Section>& LuaStorage::getSection(std::string_view sectionName)
     {
+        const std::lock_guard<std::mutex> lock(mDataMutex);
         auto it = mData.find(sectionName);
         if (it != mData.end())
             return it->second;
@@ -178,10 +188,10 @@ namespace LuaUtil
         return newIt->second;
     }
 
-    sol::object LuaStorage::getReadOnlySection(std::string_view sectionName)
+    sol::object LuaStorage::getReadOnlySection(std::string_view sectionName, lua_State* L)
     {
         const std::shared_ptr<Section>& section = getSection(sectionName);
-        return sol::make_object<SectionReadOnlyView>(mLua, SectionReadOnlyView{section, section->mChangeCounter});
+        return sol::make_object<SectionReadOnlyView>(L, SectionReadOnlyView{section, section->mChangeCounter});
     }
 
     sol::object LuaStorage::getMutableSection(std::string_view sectionName)
@@ -192,8 +202,14 @@ namespace LuaUtil
 
     sol::table LuaStorage::getAllSections()
     {
+        std::vector<std::string_view> sectionNames;
+        {
+            const std::lock_guard<std::mutex> lock(mDataMutex);
+            for (const auto& [sectionName, _] : mData)
+                sectionNames.push_back(sectionName);
+        }
         sol::table res(mLua, sol::create);
-        for (const auto& [sectionName, _] : mData)
+        for (std::string_view sectionName : sectionNames)
             res[sectionName] = getMutableSection(sectionName);
         return res;
     }
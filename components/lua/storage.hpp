@@ -2,6 +2,7 @@
 #define COMPONENTS_LUA_STORAGE_H
 
 #include <map>
+#include <mutex>
 #include <sol/sol.hpp>
 
 #include "serialization.hpp"
@@ -9,6 +10,8 @@
 namespace LuaUtil
 {
 
+    // Sections can be read from other Lua states (see getReadOnlySection), but can be modified only when nothing reads
+    // them concurrently.
     class LuaStorage
     {
     public:
@@ -20,7 +23,8 @@ namespace LuaUtil
         void load(const std::string& path);
         void save(const std::string& path) const;
 
-        sol::object getReadOnlySection(std::string_view sectionName);
+        sol::object getReadOnlySection(std::string_view sectionName) { return getReadOnlySection(sectionName, mLua); }
+        sol::object getReadOnlySection(std::string_view sectionName, lua_State* L);
         sol::object getMutableSection(std::string_view sectionName);
         sol::table getAllSections();
 
@@ -36,7 +40,7 @@ namespace LuaUtil
             Value() {}
             Value(const sol::object& value) : mSerializedValue(serialize(value)) {}
             sol::object getCopy(lua_State* L) const;
-            sol::object getReadOnly(lua_State* L) const;
+            sol::object getReadOnly(lua_State* L, bool cache) const;
 
         private:
             std::string mSerializedValue;
@@ -49,7 +53,8 @@ namespace LuaUtil
             const Value& get(std::string_view key) const;
             void set(std::string_view key, const sol::object& value);
             bool wasChanged(int64_t& lastCheck);
-            sol::table asTable();
+            sol::table asTable(lua_State* L);
+            sol::object getReadOnly(lua_State* L, std::string_view key) const;
 
             LuaStorage* mStorage;
             std::string mSectionName;
@@ -72,6 +77,7 @@ namespace LuaUtil
         const std::shared_ptr<Section>& getSection(std::string_view sectionName);
 
         lua_State* mLua;
+        std::mutex mDataMutex;
         std::map<std::string_view, std::shared_ptr<Section>> mData;
         std::optional<ListenerFn> mListener;
     };
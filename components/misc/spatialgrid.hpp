@@ -0,0 +1,192 @@
+#ifndef OPENMW_COMPONENTS_MISC_SPATIALGRID_H
+#define OPENMW_COMPONENTS_MISC_SPATIALGRID_H
+
+#include <osg/Vec3f>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Misc
+{
+    /// @brief Uniform grid over the XY plane, mapping values to their last known positions.
+    /// Values are updated incrementally when they move, so queries only visit the grid cells overlapping the
+    /// queried area instead of all values.
+    template <class T, class Compare = std::less<T>>
+    class SpatialGrid
+    {
+    public:
+        explicit SpatialGrid(float cellSize) : mCellSize(cellSize) {}
+
+        std::size_t size() const { return mLocations.size(); }
+
+        bool empty() const { return mLocations.empty(); }
+
+        /// Add the value or update its position.
+        void update(const T& value, const osg::Vec3f& position)
+        {
+            const CellKey key = getCellKey(position);
+            const auto location = mLocations.find(value);
+            if (location == mLocations.end())
+            {
+                mLocations.emplace(value, Location {key, append(key, value, position)});
+                return;
+            }
+            if (location->second.mCell == key)
+            {
+                mCells[key][location->second.mIndex].mPosition = position;
+                return;
+            }
+            removeFromCell(location->second);
+            location->second = Location {key, append(key, value, position)};
+        }
+
+        bool erase(const T& value)
+        {
+            const auto location = mLocations.find(value);
+            if (location == mLocations.end())
+                return false;
+            removeFromCell(location->second);
+            mLocations.erase(location);
+            return true;
+        }
+
+        /// Replace the value keeping its position, for values changing their identity but not their place.
+        void replace(const T& oldValue, const T& newValue)
+        {
+            const auto location = mLocations.find(oldValue);
+            if (location == mLocations.end())
+                return;
+            const Location value = location->second;
+            mLocations.erase(location);
+            mCells[value.mCell][value.mIndex].mValue = newValue;
+            mLocations.insert_or_assign(newValue, value);
+        }
+
+        void clear()
+        {
+            mLocations.clear();
+            mCells.clear();
+        }
+
+        /// Call visitor (value, position) for each value within the radius. Visitor must return a bool. Returning
+        /// false will abort the iteration.
+        /// @return Iteration completed?
+        template <class Visitor>
+        bool forEachInRadius(const osg::Vec3f& center, float radius, Visitor&& visitor) const
+        {
+            const float radius2 = radius * radius;
+            const osg::Vec3f extent(radius, radius, radius);
+            return forEachInCells(center - extent, center + extent, [&] (const Entry& entry)
+            {
+                if ((entry.mPosition - center).length2() > radius2)
+                    return true;
+                return visitor(entry.mValue, entry.mPosition);
+            });
+        }
+
+    private:
+        using CellKey = std::uint64_t;
+
+        struct Entry
+        {
+            T mValue;
+            osg::Vec3f mPosition;
+        };
+
+        struct Location
+        {
+            CellKey mCell;
+            std::size_t mIndex;
+        };
+
+        float mCellSize;
+        std::map<T, Location, Compare> mLocations;
+        std::unordered_map<CellKey, std::vector<Entry>> mCells;
+
+        int getCellIndex(float coordinate) const
+        {
+            // Converting infinite, NaN or out of range values to int is undefined, so clamp them before. The limit
+            // keeps the index arithmetic in forEachInCells from overflowing. NaN is mapped to the lower limit.
+            constexpr double limit = 1 << 30;
+            const double index = std::floor(static_cast<double>(coordinate) / mCellSize);
+            if (!(index > -limit))
+                return -static_cast<int>(limit);
+            if (index > limit)
+                return static_cast<int>(limit);
+            return static_cast<int>(index);
+        }
+
+        static CellKey makeCellKey(int x, int y)
+        {
+            return (static_cast<CellKey>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+        }
+
+        CellKey getCellKey(const osg::Vec3f& position) const
+        {
+            return makeCellKey(getCellIndex(position.x()), getCellIndex(position.y()));
+        }
+
+        std::size_t append(CellKey key, const T& value, const osg::Vec3f& position)
+        {
+            std::vector<Entry>& cell = mCells[key];
+            cell.push_back(Entry {value, position});
+            return cell.size() - 1;
+        }
+
+        void removeFromCell(const Location& location)
+        {
+            const auto cell = mCells.find(location.mCell);
+            std::vector<Entry>& entries = cell->second;
+            if (location.mIndex + 1 != entries.size())
+            {
+                entries[location.mIndex] = std::move(entries.back());
+                mLocations.find(entries[location.mIndex].mValue)->second.mIndex = location.mIndex;
+            }
+            entries.pop_back();
+            if (entries.empty())
+                mCells.erase(cell);
+        }
+
+        template <class Function>
+        bool forEachInCells(const osg::Vec3f& min, const osg::Vec3f& max, Function&& function) const
+        {
+            const int minX = getCellIndex(min.x());
+            const int maxX = getCellIndex(max.x());
+            const int minY = getCellIndex(min.y());
+            const int maxY = getCellIndex(max.y());
+            const auto visitCell = [&] (const std::vector<Entry>& entries)
+            {
+                for (const Entry& entry : entries)
+                    if (!function(entry))
+                        return false;
+                return true;
+            };
+            // Large areas can cover more grid cells than there are populated ones
+            const double covered = (static_cast<double>(maxX) - minX + 1) * (static_cast<double>(maxY) - minY + 1);
+            if (covered > static_cast<double>(mCells.size()))
+            {
+                for (const auto& [key, entries] : mCells)
+                {
+                    const int x = static_cast<int>(static_cast<std::uint32_t>(key >> 32));
+                    const int y = static_cast<int>(static_cast<std::uint32_t>(key));
+                    if (x >= minX && x <= maxX && y >= minY && y <= maxY && !visitCell(entries))
+                        return false;
+                }
+                return true;
+            }
+            for (int x = minX; x <= maxX; ++x)
+                for (int y = minY; y <= maxY; ++y)
+                    if (const auto cell = mCells.find(makeCellKey(x, y)); cell != mCells.end() && !visitCell(cell->second))
+                        return false;
+            return true;
+        }
+    };
+}
+
+#endif
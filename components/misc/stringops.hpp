@@ -2,6 +2,8 @@
 #define MISC_STRINGOPS_H
 
 #include <cctype>
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <algorithm>
 #include <string_view>
@@ -118,21 +120,73 @@ public:
         return out;
     }
 
+    /// Lower-cases the ASCII letters of eight packed characters at once, leaving other bytes unchanged like toLower.
+    static std::uint64_t toLower8(std::uint64_t word)
+    {
+        const std::uint64_t low = word & 0x7f7f7f7f7f7f7f7full;
+        // The high bit of each byte is set for 'A' and above, and for characters past 'Z'
+        const std::uint64_t atLeastA = low + 0x3f3f3f3f3f3f3f3full;
+        const std::uint64_t pastZ = low + 0x2525252525252525ull;
+        const std::uint64_t upper = atLeastA & ~pastZ & ~word & 0x8080808080808080ull;
+        return word | (upper >> 2);
+    }
+
     struct CiEqual
     {
-        bool operator()(const std::string& left, const std::string& right) const
+        using is_transparent = void;
+
+        bool operator()(std::string_view left, std::string_view right) const
         {
             return ciEqual(left, right);
         }
     };
     struct CiHash
     {
-        std::size_t operator()(std::string str) const
+        using is_transparent = void;
+
+        /// Hashes the characters in place eight at a time, so no lower-cased copy is made.
+        std::size_t operator()(std::string_view str) const
+        {
+            std::uint64_t hash = 0xcbf29ce484222325ull ^ str.size();
+            const char* data = str.data();
+            std::size_t left = str.size();
+            for (; left >= sizeof(std::uint64_t); data += sizeof(std::uint64_t), left -= sizeof(std::uint64_t))
+            {
+                std::uint64_t word;
+                std::memcpy(&word, data, sizeof(word));
+                hash = mix(hash, toLower8(word));
+            }
+            if (left > 0)
+            {
+                std::uint64_t word = 0;
+                std::memcpy(&word, data, left);
+                hash = mix(hash, toLower8(word));
+            }
+            return static_cast<std::size_t>(hash ^ (hash >> 32));
+        }
+
+    private:
+        static std::uint64_t mix(std::uint64_t hash, std::uint64_t word)
         {
-            lowerCaseInPlace(str);
-            return std::hash<std::string>{}(str);
+            hash = (hash ^ word) * 0x9e3779b97f4a7c15ull;
+            return hash ^ (hash >> 29);
         }
     };
+
+    /// Looks up a string in a map using CiHash and CiEqual without allocating a key.
+    template <class Map>
+    static auto ciFind(Map& map, std::string_view key)
+    {
+#ifdef __cpp_lib_generic_unordered_lookup
+        return map.find(key);
+#else
+        // Before C++20 unordered containers can only be searched by key_type, so reuse a per thread buffer
+        thread_local std::string buffer;
+        buffer.assign(key);
+        return map.find(buffer);
+#endif
+    }
+
     struct CiComp
     {
         bool operator()(const std::string& left, const std::string& right) const
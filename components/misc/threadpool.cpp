@@ -0,0 +1,94 @@
+#include "threadpool.hpp"
+
+#include <utility>
+
+namespace Misc
+{
+    ThreadPool::ThreadPool(std::size_t threadsCount)
+    {
+        mThreads.reserve(threadsCount);
+        for (std::size_t i = 0; i < threadsCount; ++i)
+            mThreads.emplace_back([this] { work(); });
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            mStop = true;
+        }
+        mHasTask.notify_all();
+        for (std::thread& thread : mThreads)
+            thread.join();
+    }
+
+    void ThreadPool::run(std::size_t count, const std::function<void (std::size_t)>& task)
+    {
+        if (mThreads.empty() || count < 2)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                task(i);
+            return;
+        }
+
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            mTask = &task;
+            mCount = count;
+            mNext = 0;
+            mBusy = mThreads.size();
+            ++mGeneration;
+        }
+        mHasTask.notify_all();
+
+        process();
+
+        std::exception_ptr error;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mTaskDone.wait(lock, [&] { return mBusy == 0; });
+            mTask = nullptr;
+            error = std::exchange(mError, nullptr);
+        }
+        if (error != nullptr)
+            std::rethrow_exception(error);
+    }
+
+    void ThreadPool::work()
+    {
+        std::size_t generation = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mHasTask.wait(lock, [&] { return mStop || mGeneration != generation; });
+                if (mStop)
+                    return;
+                generation = mGeneration;
+            }
+
+            process();
+
+            const std::lock_guard<std::mutex> lock(mMutex);
+            if (--mBusy == 0)
+                mTaskDone.notify_one();
+        }
+    }
+
+    void ThreadPool::process()
+    {
+        for (std::size_t i = mNext++; i < mCount; i = mNext++)
+        {
+            try
+            {
+                (*mTask)(i);
+            }
+            catch (...)
+            {
+                const std::lock_guard<std::mutex> lock(mMutex);
+                if (mError == nullptr)
+                    mError = std::current_exception();
+            }
+        }
+    }
+}
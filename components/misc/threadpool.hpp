@@ -0,0 +1,51 @@
+#ifndef OPENMW_COMPONENTS_MISC_THREADPOOL_H
+#define OPENMW_COMPONENTS_MISC_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Misc
+{
+    /// @brief Persistent worker threads running the iterations of a loop together with the calling thread.
+    /// Intended for short parallel sections executed every frame, where spawning threads each time is too expensive.
+    class ThreadPool
+    {
+        public:
+            /// @param threadsCount number of worker threads in addition to the calling one, 0 runs everything serially
+            explicit ThreadPool(std::size_t threadsCount);
+
+            ~ThreadPool();
+
+            std::size_t getThreadsCount() const { return mThreads.size(); }
+
+            /// @brief Call task for each index in [0, count) and wait for all of them to finish.
+            /// Indices are processed in unspecified order and on unspecified threads. If any call throws, the first
+            /// caught exception is rethrown after all the workers are done.
+            void run(std::size_t count, const std::function<void (std::size_t)>& task);
+
+        private:
+            std::mutex mMutex;
+            std::condition_variable mHasTask;
+            std::condition_variable mTaskDone;
+            const std::function<void (std::size_t)>* mTask = nullptr;
+            std::size_t mCount = 0;
+            std::atomic_size_t mNext {0};
+            std::size_t mGeneration = 0;
+            std::size_t mBusy = 0;
+            bool mStop = false;
+            std::exception_ptr mError;
+            std::vector<std::thread> mThreads;
+
+            void work();
+
+            void process();
+    };
+}
+
+#endif
@@ -4,7 +4,9 @@
 #include <components/files/hash.hpp>
 
 #include <array>
+#include <iterator>
 #include <map>
+#include <memory>
 #include <sstream>
 
 namespace Nif
@@ -14,20 +16,25 @@ namespace Nif
 NIFFile::NIFFile(Files::IStreamPtr stream, const std::string &name)
     : filename(name)
 {
-    parse(stream);
+    auto buffer = std::make_shared<std::string>(std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>());
+    if (stream->bad())
+        fail("Failed to read file");
+    parse(Files::FileView {buffer->data(), buffer->size(), buffer});
 }
 
-NIFFile::~NIFFile()
+NIFFile::NIFFile(Files::FileView data, const std::string &name)
+    : filename(name)
 {
-    for (Record* record : records)
-        delete record;
+    parse(std::move(data));
 }
 
-template <typename NodeType> static Record* construct() { return new NodeType; }
+NIFFile::~NIFFile() = default;
+
+template <typename NodeType> static Record* construct(RecordArena& arena) { return arena.create<NodeType>(); }
 
 struct RecordFactoryEntry {
 
-    using create_t = Record* (*)();
+    using create_t = Record* (*)(RecordArena&);
 
     create_t        mCreate;
     RecordType      mType;
@@ -174,15 +181,15 @@ std::string NIFFile::printVersion(unsigned int version)
     return stream.str();
 }
 
-void NIFFile::parse(Files::IStreamPtr stream)
+void NIFFile::parse(Files::FileView data)
 {
-    const std::array<std::uint64_t, 2> fileHash = Files::getHash(filename, *stream);
+    const std::array<std::uint64_t, 2> fileHash = Files::getHash(data.getData());
     hash.append(reinterpret_cast<const char*>(fileHash.data()), fileHash.size() * sizeof(std::uint64_t));
 
-    NIFStream nif (this, stream);
+    NIFStream nif (this, std::move(data));
 
     // Check the header string
-    std::string head = nif.getVersionString();
+    const std::string_view head = nif.getVersionString();
     static const std::array<std::string, 2> verStrings =
     {
         "NetImmerse File Format",
@@ -196,7 +203,7 @@ void NIFFile::parse(Files::IStreamPtr stream)
             break;
     }
     if (!supported)
-        fail("Invalid NIF header: " + head);
+        fail("Invalid NIF header: " + std::string(head));
 
     supported = false;
 
@@ -315,7 +322,7 @@ void NIFFile::parse(Files::IStreamPtr stream)
 
         if (entry != factories.end())
         {
-            r = entry->second.mCreate ();
+            r = entry->second.mCreate (mArena);
             r->recType = entry->second.mType;
         }
         else
@@ -8,8 +8,10 @@
 
 #include <components/debug/debuglog.hpp>
 #include <components/files/constrainedfilestream.hpp>
+#include <components/files/memorymappedfile.hpp>
 
 #include "record.hpp"
+#include "recordarena.hpp"
 
 namespace Nif
 {
@@ -54,6 +56,9 @@ class NIFFile final : public File
     std::string filename;
     std::string hash;
 
+    /// Owns all the records
+    RecordArena mArena;
+
     /// Record list
     std::vector<Record*> records;
 
@@ -68,7 +73,7 @@ class NIFFile final : public File
     static bool sLoadUnsupportedFiles;
 
     /// Parse the file
-    void parse(Files::IStreamPtr stream);
+    void parse(Files::FileView data);
 
     /// Get the file's version in a human readable form
     ///\returns A string containing a human readable NIF version number
@@ -107,6 +112,8 @@ public:
 
     /// Open a NIF stream. The name is used for error messages.
     NIFFile(Files::IStreamPtr stream, const std::string &name);
+    /// Parse a NIF file from its contents already in memory. The name is used for error messages.
+    NIFFile(Files::FileView data, const std::string &name);
     ~NIFFile();
 
     /// Get a given record
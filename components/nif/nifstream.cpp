@@ -4,16 +4,36 @@
 
 namespace Nif
 {
+    namespace
+    {
+        /// Quaternions are stored as w, x, y, z floats, osg::Quat keeps x, y, z, w doubles.
+        osg::Quat makeQuaternion(const float* f)
+        {
+            return osg::Quat(f[1], f[2], f[3], f[0]);
+        }
+    }
+
+    void NIFStream::failRead(std::size_t size) const
+    {
+        throw std::runtime_error("Failed to read " + std::to_string(size) + " bytes at offset "
+            + std::to_string(mCursor - mData.mData) + " of " + std::to_string(mData.mSize) + " bytes");
+    }
+
     osg::Quat NIFStream::getQuaternion()
     {
         float f[4];
-        readLittleEndianBufferOfType<4, float>(inp, f);
-        osg::Quat quat;
-        quat.w() = f[0];
-        quat.x() = f[1];
-        quat.y() = f[2];
-        quat.z() = f[3];
-        return quat;
+        readLittleEndianBuffer(f, 4);
+        return makeQuaternion(f);
+    }
+
+    void NIFStream::getQuaternions(std::vector<osg::Quat> &quat, size_t size)
+    {
+        // Convert all the floats at once and only then reorder and widen them
+        std::vector<float> f;
+        getFloats(f, size * 4);
+        quat.resize(size);
+        for (size_t i = 0; i < size; i++)
+            quat[i] = makeQuaternion(f.data() + i * 4);
     }
 
     Transformation NIFStream::getTrafo()
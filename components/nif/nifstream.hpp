@@ -4,13 +4,15 @@
 #define OPENMW_COMPONENTS_NIF_NIFSTREAM_HPP
 
 #include <cassert>
+#include <cstring>
 #include <stdint.h>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 #include <vector>
-#include <typeinfo>
 #include <type_traits>
 
-#include <components/files/constrainedfilestream.hpp>
+#include <components/files/memorymappedfile.hpp>
 #include <components/misc/endianness.hpp>
 
 #include <osg/Vec3f>
@@ -24,103 +26,111 @@ namespace Nif
 
 class NIFFile;
 
-template <std::size_t numInstances, typename T> inline void readLittleEndianBufferOfType(Files::IStreamPtr &pIStream, T* dest)
+class NIFStream
 {
-    static_assert(std::is_arithmetic_v<T>, "Buffer element type is not arithmetic");
-    pIStream->read((char*)dest, numInstances * sizeof(T));
-    if (pIStream->bad())
-        throw std::runtime_error("Failed to read little endian typed (" + std::string(typeid(T).name()) + ") buffer of "
-                                 + std::to_string(numInstances) + " instances");
-    if constexpr (Misc::IS_BIG_ENDIAN)
-        for (std::size_t i = 0; i < numInstances; i++)
-            Misc::swapEndiannessInplace(dest[i]);
-}
+    /// Whole file contents
+    Files::FileView mData;
+    /// Read position within mData
+    const char* mCursor;
+
+    /// Check that size more bytes can be read and move the cursor past them.
+    /// @return Start of the bytes that were skipped.
+    const char* advance(std::size_t size)
+    {
+        if (size > static_cast<std::size_t>(mData.mData + mData.mSize - mCursor))
+            failRead(size);
+        const char* const result = mCursor;
+        mCursor += size;
+        return result;
+    }
 
-template <typename T> inline void readLittleEndianDynamicBufferOfType(Files::IStreamPtr &pIStream, T* dest, std::size_t numInstances)
-{
-    static_assert(std::is_arithmetic_v<T>, "Buffer element type is not arithmetic");
-    pIStream->read((char*)dest, numInstances * sizeof(T));
-    if (pIStream->bad())
-        throw std::runtime_error("Failed to read little endian dynamic buffer of " + std::to_string(numInstances) + " instances");
-    if constexpr (Misc::IS_BIG_ENDIAN)
-        for (std::size_t i = 0; i < numInstances; i++)
-            Misc::swapEndiannessInplace(dest[i]);
-}
-template<typename type> type inline readLittleEndianType(Files::IStreamPtr &pIStream)
-{
-    type val;
-    readLittleEndianBufferOfType<1, type>(pIStream, &val);
-    return val;
-}
+    [[noreturn]] void failRead(std::size_t size) const;
 
-class NIFStream
-{
-    /// Input stream
-    Files::IStreamPtr inp;
+    template <typename T> void readLittleEndianBuffer(T* dest, std::size_t numInstances)
+    {
+        static_assert(std::is_arithmetic_v<T>, "Buffer element type is not arithmetic");
+        if (numInstances == 0)
+            return;
+        const std::size_t size = numInstances * sizeof(T);
+        // The data is already in memory, so on little endian hosts this is a single bulk copy. On big endian hosts the
+        // swap loop has no dependencies between iterations and gets vectorized.
+        std::memcpy(dest, advance(size), size);
+        if constexpr (Misc::IS_BIG_ENDIAN)
+            for (std::size_t i = 0; i < numInstances; i++)
+                Misc::swapEndiannessInplace(dest[i]);
+    }
+
+    template <typename T> T readLittleEndianType()
+    {
+        T val;
+        readLittleEndianBuffer(&val, 1);
+        return val;
+    }
 
 public:
 
     NIFFile * const file;
 
-    NIFStream (NIFFile * file, Files::IStreamPtr inp): inp (inp), file (file) {}
+    /// @param data Contents of the whole file, must stay valid while the stream is used.
+    NIFStream (NIFFile * file, Files::FileView data): mData(std::move(data)), mCursor(mData.mData), file (file) {}
 
-    void skip(size_t size) { inp->ignore(size); }
+    void skip(size_t size) { advance(size); }
 
     char getChar()
     {
-        return readLittleEndianType<char>(inp);
+        return readLittleEndianType<char>();
     }
 
     short getShort()
     {
-        return readLittleEndianType<short>(inp);
+        return readLittleEndianType<short>();
     }
 
     unsigned short getUShort()
     {
-        return readLittleEndianType<unsigned short>(inp);
+        return readLittleEndianType<unsigned short>();
     }
 
     int getInt()
     {
-        return readLittleEndianType<int>(inp);
+        return readLittleEndianType<int>();
     }
 
     unsigned int getUInt()
     {
-        return readLittleEndianType<unsigned int>(inp);
+        return readLittleEndianType<unsigned int>();
     }
 
     float getFloat()
     {
-        return readLittleEndianType<float>(inp);
+        return readLittleEndianType<float>();
     }
 
     osg::Vec2f getVector2()
     {
         osg::Vec2f vec;
-        readLittleEndianBufferOfType<2,float>(inp, vec._v);
+        readLittleEndianBuffer(vec._v, 2);
         return vec;
     }
 
     osg::Vec3f getVector3()
     {
         osg::Vec3f vec;
-        readLittleEndianBufferOfType<3, float>(inp, vec._v);
+        readLittleEndianBuffer(vec._v, 3);
         return vec;
     }
 
     osg::Vec4f getVector4()
     {
         osg::Vec4f vec;
-        readLittleEndianBufferOfType<4, float>(inp, vec._v);
+        readLittleEndianBuffer(vec._v, 4);
         return vec;
     }
 
     Matrix3 getMatrix3()
     {
         Matrix3 mat;
-        readLittleEndianBufferOfType<9, float>(inp, (float*)&mat.mValues);
+        readLittleEndianBuffer((float*)&mat.mValues, 9);
         return mat;
     }
 
@@ -142,105 +152,104 @@ public:
         return (major << 24) + (minor << 16) + (patch << 8) + rev;
     }
 
+    ///Read in a string of the given length, pointing into the file contents
+    std::string_view getSizedStringView(size_t length)
+    {
+        std::string_view str(advance(length), length);
+        const size_t end = str.find('\0');
+        if (end != std::string_view::npos)
+            str.remove_suffix(length - end);
+        return str;
+    }
     ///Read in a string of the given length
     std::string getSizedString(size_t length)
     {
-        std::string str(length, '\0');
-        inp->read(str.data(), length);
-        if (inp->bad())
-            throw std::runtime_error("Failed to read sized string of " + std::to_string(length) + " chars");
-        size_t end = str.find('\0');
-        if (end != std::string::npos)
-            str.erase(end);
-        return str;
+        return std::string(getSizedStringView(length));
     }
     ///Read in a string of the length specified in the file
     std::string getSizedString()
     {
-        size_t size = readLittleEndianType<uint32_t>(inp);
+        size_t size = readLittleEndianType<uint32_t>();
         return getSizedString(size);
     }
 
     ///Specific to Bethesda headers, uses a byte for length
-    std::string getExportString()
+    std::string_view getExportString()
     {
-        size_t size = static_cast<size_t>(readLittleEndianType<uint8_t>(inp));
-        return getSizedString(size);
+        size_t size = static_cast<size_t>(readLittleEndianType<uint8_t>());
+        return getSizedStringView(size);
     }
 
     ///This is special since the version string doesn't start with a number, and ends with "\n"
-    std::string getVersionString()
+    std::string_view getVersionString()
     {
-        std::string result;
-        std::getline(*inp, result);
-        if (inp->bad())
-            throw std::runtime_error("Failed to read version string");
+        const size_t left = static_cast<size_t>(mData.mData + mData.mSize - mCursor);
+        const char* const newLine = static_cast<const char*>(std::memchr(mCursor, '\n', left));
+        const size_t length = newLine != nullptr ? static_cast<size_t>(newLine - mCursor) : left;
+        std::string_view result(advance(length), length);
+        if (newLine != nullptr)
+            advance(1);
         return result;
     }
 
     void getChars(std::vector<char> &vec, size_t size)
     {
         vec.resize(size);
-        readLittleEndianDynamicBufferOfType<char>(inp, vec.data(), size);
+        readLittleEndianBuffer(vec.data(), size);
     }
 
     void getUChars(std::vector<unsigned char> &vec, size_t size)
     {
         vec.resize(size);
-        readLittleEndianDynamicBufferOfType<unsigned char>(inp, vec.data(), size);
+        readLittleEndianBuffer(vec.data(), size);
     }
 
     void getUShorts(std::vector<unsigned short> &vec, size_t size)
     {
         vec.resize(size);
-        readLittleEndianDynamicBufferOfType<unsigned short>(inp, vec.data(), size);
+        readLittleEndianBuffer(vec.data(), size);
     }
 
     void getFloats(std::vector<float> &vec, size_t size)
     {
         vec.resize(size);
-        readLittleEndianDynamicBufferOfType<float>(inp, vec.data(), size);
+        readLittleEndianBuffer(vec.data(), size);
     }
 
     void getInts(std::vector<int> &vec, size_t size)
     {
         vec.resize(size);
-        readLittleEndianDynamicBufferOfType<int>(inp, vec.data(), size);
+        readLittleEndianBuffer(vec.data(), size);
     }
 
     void getUInts(std::vector<unsigned int> &vec, size_t size)
     {
         vec.resize(size);
-        readLittleEndianDynamicBufferOfType<unsigned int>(inp, vec.data(), size);
+        readLittleEndianBuffer(vec.data(), size);
     }
 
     void getVector2s(std::vector<osg::Vec2f> &vec, size_t size)
     {
         vec.resize(size);
         /* The packed storage of each Vec2f is 2 floats exactly */
-        readLittleEndianDynamicBufferOfType<float>(inp,(float*)vec.data(), size*2);
+        readLittleEndianBuffer((float*)vec.data(), size*2);
     }
 
     void getVector3s(std::vector<osg::Vec3f> &vec, size_t size)
     {
         vec.resize(size);
         /* The packed storage of each Vec3f is 3 floats exactly */
-        readLittleEndianDynamicBufferOfType<float>(inp, (float*)vec.data(), size*3);
+        readLittleEndianBuffer((float*)vec.data(), size*3);
     }
 
     void getVector4s(std::vector<osg::Vec4f> &vec, size_t size)
     {
         vec.resize(size);
         /* The packed storage of each Vec4f is 4 floats exactly */
-        readLittleEndianDynamicBufferOfType<float>(inp, (float*)vec.data(), size*4);
+        readLittleEndianBuffer((float*)vec.data(), size*4);
     }
 
-    void getQuaternions(std::vector<osg::Quat> &quat, size_t size)
-    {
-        quat.resize(size);
-        for (size_t i = 0;i < quat.size();i++)
-            quat[i] = getQuaternion();
-    }
+    void getQuaternions(std::vector<osg::Quat> &quat, size_t size);
 
     void getStrings(std::vector<std::string> &vec, size_t size)
     {
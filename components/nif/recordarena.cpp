@@ -0,0 +1,35 @@
+#include "recordarena.hpp"
+
+#include <algorithm>
+
+namespace Nif
+{
+    RecordArena::RecordArena(std::size_t blockSize)
+        : mBlockSize(blockSize)
+    {
+    }
+
+    RecordArena::~RecordArena()
+    {
+        for (auto it = mDestructors.rbegin(); it != mDestructors.rend(); ++it)
+            it->mDestroy(it->mObject);
+    }
+
+    void* RecordArena::allocate(std::size_t size, std::size_t alignment)
+    {
+        void* current = mCurrent;
+        if (current == nullptr || std::align(alignment, size, current, mLeft) == nullptr)
+        {
+            // Objects larger than a block get a block of their own
+            const std::size_t blockSize = std::max(mBlockSize, size + alignment);
+            mBlocks.emplace_back(static_cast<std::byte*>(::operator new(blockSize)));
+            mAllocatedSize += blockSize;
+            current = mBlocks.back().get();
+            mLeft = blockSize;
+            std::align(alignment, size, current, mLeft);
+        }
+        mCurrent = static_cast<std::byte*>(current) + size;
+        mLeft -= size;
+        return current;
+    }
+}
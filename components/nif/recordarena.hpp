@@ -0,0 +1,63 @@
+#ifndef OPENMW_COMPONENTS_NIF_RECORDARENA_HPP
+#define OPENMW_COMPONENTS_NIF_RECORDARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Nif
+{
+    /// @brief Monotonic arena for the records of a single file.
+    /// @par Objects are placed next to each other in large blocks and only destroyed together with the arena, which
+    /// replaces a heap allocation per record with a pointer bump and keeps the records of a file close in memory.
+    /// @note Not thread safe.
+    class RecordArena
+    {
+    public:
+        explicit RecordArena(std::size_t blockSize = 64 * 1024);
+
+        RecordArena(const RecordArena&) = delete;
+        RecordArena& operator=(const RecordArena&) = delete;
+
+        /// Destroy the objects in the reverse order of creation and free the memory.
+        ~RecordArena();
+
+        template <class T, class ... Args>
+        T* create(Args&& ... args)
+        {
+            T* const result = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args) ...);
+            if constexpr (!std::is_trivially_destructible_v<T>)
+                mDestructors.push_back(Destructor {result, [] (void* object) { static_cast<T*>(object)->~T(); }});
+            return result;
+        }
+
+        /// Total size of the allocated blocks.
+        std::size_t getAllocatedSize() const { return mAllocatedSize; }
+
+    private:
+        struct Destructor
+        {
+            void* mObject;
+            void (*mDestroy)(void*);
+        };
+
+        struct FreeBlock
+        {
+            void operator()(std::byte* block) const { ::operator delete(block); }
+        };
+
+        const std::size_t mBlockSize;
+        std::vector<std::unique_ptr<std::byte, FreeBlock>> mBlocks;
+        std::byte* mCurrent = nullptr;
+        std::size_t mLeft = 0;
+        std::size_t mAllocatedSize = 0;
+        std::vector<Destructor> mDestructors;
+
+        void* allocate(std::size_t size, std::size_t alignment);
+    };
+}
+
+#endif
@@ -43,13 +43,22 @@ namespace Resource
 
 
     Nif::NIFFilePtr NifFileManager::get(const std::string &name)
+    {
+        // Don't read the file if it's cached
+        osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(name);
+        if (obj)
+            return static_cast<NifFileHolder*>(obj.get())->mNifFile;
+        return get(name, mVFS->getView(name));
+    }
+
+    Nif::NIFFilePtr NifFileManager::get(const std::string &name, Files::FileView data)
     {
         osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(name);
         if (obj)
             return static_cast<NifFileHolder*>(obj.get())->mNifFile;
         else
         {
-            Nif::NIFFilePtr file (new Nif::NIFFile(mVFS->get(name), name));
+            Nif::NIFFilePtr file (new Nif::NIFFile(std::move(data), name));
             obj = new NifFileHolder(file);
             mCache->addEntryToObjectCache(name, obj);
             return file;
@@ -23,6 +23,9 @@ namespace Resource
         /// to be done in advance by other managers accessing the NifFileManager.
         Nif::NIFFilePtr get(const std::string& name);
 
+        /// Same as above, but parses the given file contents instead of reading them from the VFS when not cached yet.
+        Nif::NIFFilePtr get(const std::string& name, Files::FileView data);
+
         void reportStats(unsigned int frameNumber, osg::Stats *stats) const override;
     };
 
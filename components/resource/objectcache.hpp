@@ -3,6 +3,8 @@
 // - removeExpiredObjectsInCache no longer keeps a lock while the unref happens.
 // - template allows customized KeyType.
 // - objects with uninitialized time stamp are not removed.
+// - entries are distributed between shards with own locks, lookups are counted.
+// - expired objects can be removed incrementally, a few shards per call.
 
 /* -*-c++-*- OpenSceneGraph - Copyright (C) 1998-2006 Robert Osfield
  *
@@ -23,10 +25,19 @@
 #include <osg/Referenced>
 #include <osg/ref_ptr>
 #include <osg/Node>
+#include <osg/Vec2f>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
 #include <string>
 #include <map>
 #include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace osg
 {
@@ -37,11 +48,56 @@ namespace osg
 
 namespace Resource {
 
+/// Hash of the cache keys, only used to pick a shard so the key types don't need a std::hash specialization.
+struct ObjectCacheKeyHash
+{
+    template <class T>
+    std::size_t operator()(const T& value) const { return std::hash<T>()(value); }
+
+    std::size_t operator()(const osg::Vec2f& value) const
+    {
+        std::size_t seed = 0;
+        combine(seed, value.x());
+        combine(seed, value.y());
+        return seed;
+    }
+
+    template <class First, class Second>
+    std::size_t operator()(const std::pair<First, Second>& value) const
+    {
+        std::size_t seed = 0;
+        combine(seed, value.first);
+        combine(seed, value.second);
+        return seed;
+    }
+
+    template <class ... Types>
+    std::size_t operator()(const std::tuple<Types ...>& value) const
+    {
+        std::size_t seed = 0;
+        std::apply([&] (const auto& ... values) { (combine(seed, values), ...); }, value);
+        return seed;
+    }
+
+    template <class T>
+    void combine(std::size_t& seed, const T& value) const
+    {
+        seed ^= (*this)(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+};
+
 template <typename KeyType>
 class GenericObjectCache : public osg::Referenced
 {
     public:
 
+        struct Stats
+        {
+            std::size_t mHits = 0;
+            std::size_t mMisses = 0;
+            std::size_t mContentions = 0; ///< times a shard lock was held by another thread
+        };
+
         GenericObjectCache()
             : osg::Referenced(true) {}
 
@@ -54,13 +110,17 @@ class GenericObjectCache : public osg::Referenced
         void updateTimeStampOfObjectsInCacheWithExternalReferences(double referenceTime)
         {
             // look for objects with external references and update their time stamp.
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            for(typename ObjectCacheMap::iterator itr=_objectCache.begin(); itr!=_objectCache.end(); ++itr)
+            // Only one shard is locked at a time, so lookups in the other shards are not blocked.
+            for (Shard& shard : _shards)
             {
-                // If ref count is greater than 1, the object has an external reference.
-                // If the timestamp is yet to be initialized, it needs to be updated too.
-                if (itr->second.first->referenceCount()>1 || itr->second.second == 0.0)
-                    itr->second.second = referenceTime;
+                const std::unique_lock<std::mutex> lock = lockShard(shard);
+                for(typename ObjectCacheMap::iterator itr=shard._objectCache.begin(); itr!=shard._objectCache.end(); ++itr)
+                {
+                    // If ref count is greater than 1, the object has an external reference.
+                    // If the timestamp is yet to be initialized, it needs to be updated too.
+                    if (itr->second.first->referenceCount()>1 || itr->second.second == 0.0)
+                        itr->second.second = referenceTime;
+                }
             }
         }
 
@@ -71,63 +131,110 @@ class GenericObjectCache : public osg::Referenced
         void removeExpiredObjectsInCache(double expiryTime)
         {
             std::vector<osg::ref_ptr<osg::Object> > objectsToRemove;
+            for (Shard& shard : _shards)
+            {
+                {
+                    const std::unique_lock<std::mutex> lock = lockShard(shard);
+                    // Remove expired entries from object cache
+                    typename ObjectCacheMap::iterator oitr = shard._objectCache.begin();
+                    while(oitr != shard._objectCache.end())
+                    {
+                        if (oitr->second.second<=expiryTime)
+                        {
+                            objectsToRemove.push_back(oitr->second.first);
+                            shard._objectCache.erase(oitr++);
+                        }
+                        else
+                            ++oitr;
+                    }
+                }
+                // note, actual unref happens outside of the lock
+                objectsToRemove.clear();
+            }
+        }
+
+        /** Incremental version of updateTimeStampOfObjectsInCacheWithExternalReferences(referenceTime) followed by
+          * removeExpiredObjectsInCache(expiryTime). Only the next shardsCount shards in round robin order are processed,
+          * so the cost of a call doesn't grow with the number of shards. An object is removed at most
+          * _shardsCount / shardsCount calls later than by the full sweep.*/
+        void updateAndRemoveExpiredObjectsInCache(double referenceTime, double expiryTime, std::size_t shardsCount)
+        {
+            shardsCount = std::min(shardsCount, _shardsCount);
+            const std::size_t first = _nextSweptShard.fetch_add(shardsCount, std::memory_order_relaxed);
+            std::vector<osg::ref_ptr<osg::Object> > objectsToRemove;
+            for (std::size_t i = 0; i < shardsCount; ++i)
             {
-                std::lock_guard<std::mutex> lock(_objectCacheMutex);
-                // Remove expired entries from object cache
-                typename ObjectCacheMap::iterator oitr = _objectCache.begin();
-                while(oitr != _objectCache.end())
+                Shard& shard = _shards[(first + i) % _shardsCount];
                 {
-                    if (oitr->second.second<=expiryTime)
+                    const std::unique_lock<std::mutex> lock = lockShard(shard);
+                    typename ObjectCacheMap::iterator oitr = shard._objectCache.begin();
+                    while (oitr != shard._objectCache.end())
                     {
-                        objectsToRemove.push_back(oitr->second.first);
-                        _objectCache.erase(oitr++);
+                        if (oitr->second.first->referenceCount()>1 || oitr->second.second == 0.0)
+                            oitr->second.second = referenceTime;
+                        if (oitr->second.second<=expiryTime)
+                        {
+                            objectsToRemove.push_back(oitr->second.first);
+                            shard._objectCache.erase(oitr++);
+                        }
+                        else
+                            ++oitr;
                     }
-                    else
-                        ++oitr;
                 }
+                // note, actual unref happens outside of the lock
+                objectsToRemove.clear();
             }
-            // note, actual unref happens outside of the lock
-            objectsToRemove.clear();
         }
 
         /** Remove all objects in the cache regardless of having external references or expiry times.*/
         void clear()
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            _objectCache.clear();
+            for (Shard& shard : _shards)
+            {
+                const std::unique_lock<std::mutex> lock = lockShard(shard);
+                shard._objectCache.clear();
+            }
         }
 
         /** Add a key,object,timestamp triple to the Registry::ObjectCache.*/
         void addEntryToObjectCache(const KeyType& key, osg::Object* object, double timestamp = 0.0)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            _objectCache[key]=ObjectTimeStampPair(object,timestamp);
+            Shard& shard = getShard(key);
+            const std::unique_lock<std::mutex> lock = lockShard(shard);
+            shard._objectCache[key]=ObjectTimeStampPair(object,timestamp);
         }
 
         /** Remove Object from cache.*/
         void removeFromObjectCache(const KeyType& key)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            typename ObjectCacheMap::iterator itr = _objectCache.find(key);
-            if (itr!=_objectCache.end()) _objectCache.erase(itr);
+            Shard& shard = getShard(key);
+            const std::unique_lock<std::mutex> lock = lockShard(shard);
+            typename ObjectCacheMap::iterator itr = shard._objectCache.find(key);
+            if (itr!=shard._objectCache.end()) shard._objectCache.erase(itr);
         }
 
         /** Get an ref_ptr<Object> from the object cache*/
         osg::ref_ptr<osg::Object> getRefFromObjectCache(const KeyType& key)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            typename ObjectCacheMap::iterator itr = _objectCache.find(key);
-            if (itr!=_objectCache.end())
+            Shard& shard = getShard(key);
+            const std::unique_lock<std::mutex> lock = lockShard(shard);
+            typename ObjectCacheMap::iterator itr = shard._objectCache.find(key);
+            if (itr!=shard._objectCache.end())
+            {
+                _hits.fetch_add(1, std::memory_order_relaxed);
                 return itr->second.first;
-            else return nullptr;
+            }
+            _misses.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
         }
 
         /** Check if an object is in the cache, and if it is, update its usage time stamp. */
         bool checkInObjectCache(const KeyType& key, double timeStamp)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            typename ObjectCacheMap::iterator itr = _objectCache.find(key);
-            if (itr!=_objectCache.end())
+            Shard& shard = getShard(key);
+            const std::unique_lock<std::mutex> lock = lockShard(shard);
+            typename ObjectCacheMap::iterator itr = shard._objectCache.find(key);
+            if (itr!=shard._objectCache.end())
             {
                 itr->second.second = timeStamp;
                 return true;
@@ -138,44 +245,70 @@ class GenericObjectCache : public osg::Referenced
         /** call releaseGLObjects on all objects attached to the object cache.*/
         void releaseGLObjects(osg::State* state)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            for(typename ObjectCacheMap::iterator itr = _objectCache.begin(); itr != _objectCache.end(); ++itr)
+            for (Shard& shard : _shards)
             {
-                osg::Object* object = itr->second.first.get();
-                object->releaseGLObjects(state);
+                const std::unique_lock<std::mutex> lock = lockShard(shard);
+                for(typename ObjectCacheMap::iterator itr = shard._objectCache.begin(); itr != shard._objectCache.end(); ++itr)
+                {
+                    osg::Object* object = itr->second.first.get();
+                    object->releaseGLObjects(state);
+                }
             }
         }
 
         /** call node->accept(nv); for all nodes in the objectCache. */
         void accept(osg::NodeVisitor& nv)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            for(typename ObjectCacheMap::iterator itr = _objectCache.begin(); itr != _objectCache.end(); ++itr)
+            for (Shard& shard : _shards)
             {
-                osg::Object* object = itr->second.first.get();
-                if (object)
+                const std::unique_lock<std::mutex> lock = lockShard(shard);
+                for(typename ObjectCacheMap::iterator itr = shard._objectCache.begin(); itr != shard._objectCache.end(); ++itr)
                 {
-                    osg::Node* node = dynamic_cast<osg::Node*>(object);
-                    if (node)
-                        node->accept(nv);
+                    osg::Object* object = itr->second.first.get();
+                    if (object)
+                    {
+                        osg::Node* node = dynamic_cast<osg::Node*>(object);
+                        if (node)
+                            node->accept(nv);
+                    }
                 }
             }
         }
 
-        /** call operator()(KeyType, osg::Object*) for each object in the cache. */
+        /** call operator()(KeyType, osg::Object*) for each object in the cache. Objects are visited shard by shard,
+          * not in the key order. */
         template <class Functor>
         void call(Functor& f)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            for (typename ObjectCacheMap::iterator it = _objectCache.begin(); it != _objectCache.end(); ++it)
-                f(it->first, it->second.first.get());
+            for (Shard& shard : _shards)
+            {
+                const std::unique_lock<std::mutex> lock = lockShard(shard);
+                for (typename ObjectCacheMap::iterator it = shard._objectCache.begin(); it != shard._objectCache.end(); ++it)
+                    f(it->first, it->second.first.get());
+            }
         }
 
         /** Get the number of objects in the cache. */
         unsigned int getCacheSize() const
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            return _objectCache.size();
+            std::size_t result = 0;
+            for (const Shard& shard : _shards)
+            {
+                const std::unique_lock<std::mutex> lock = lockShard(shard);
+                result += shard._objectCache.size();
+            }
+            return static_cast<unsigned int>(result);
+        }
+
+        /** Get the lookup and lock contention counters accumulated since the previous call and reset them,
+          * so that the stats of each frame are reported separately. */
+        Stats takeStats()
+        {
+            Stats result;
+            result.mHits = _hits.exchange(0, std::memory_order_relaxed);
+            result.mMisses = _misses.exchange(0, std::memory_order_relaxed);
+            result.mContentions = _contentions.exchange(0, std::memory_order_relaxed);
+            return result;
         }
 
     protected:
@@ -185,8 +318,35 @@ class GenericObjectCache : public osg::Referenced
         typedef std::pair<osg::ref_ptr<osg::Object>, double >           ObjectTimeStampPair;
         typedef std::map<KeyType, ObjectTimeStampPair >             ObjectCacheMap;
 
-        ObjectCacheMap                          _objectCache;
-        mutable std::mutex                      _objectCacheMutex;
+        struct Shard
+        {
+            ObjectCacheMap                      _objectCache;
+            mutable std::mutex                  _objectCacheMutex;
+        };
+
+        static constexpr std::size_t            _shardsCount = 16;
+
+        std::array<Shard, _shardsCount>         _shards;
+        mutable std::atomic_size_t              _hits {0};
+        mutable std::atomic_size_t              _misses {0};
+        mutable std::atomic_size_t              _contentions {0};
+        std::atomic_size_t                      _nextSweptShard {0};
+
+        Shard& getShard(const KeyType& key)
+        {
+            return _shards[ObjectCacheKeyHash()(key) % _shardsCount];
+        }
+
+        std::unique_lock<std::mutex> lockShard(const Shard& shard) const
+        {
+            std::unique_lock<std::mutex> lock(shard._objectCacheMutex, std::try_to_lock);
+            if (!lock.owns_lock())
+            {
+                _contentions.fetch_add(1, std::memory_order_relaxed);
+                lock.lock();
+            }
+            return lock;
+        }
 
 };
 
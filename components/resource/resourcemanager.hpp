@@ -48,10 +48,10 @@ namespace Resource
         virtual ~GenericResourceManager() {}
 
         /// Clear cache entries that have not been referenced for longer than expiryDelay.
+        /// Called every frame, so only a part of the cache is checked each time.
         void updateCache(double referenceTime) override
         {
-            mCache->updateTimeStampOfObjectsInCacheWithExternalReferences(referenceTime);
-            mCache->removeExpiredObjectsInCache(referenceTime - mExpiryDelay);
+            mCache->updateAndRemoveExpiredObjectsInCache(referenceTime, referenceTime - mExpiryDelay, 4);
         }
 
         /// Clear all cache entries.
@@ -2,6 +2,12 @@
 
 #include <algorithm>
 
+#include <osg/Stats>
+
+#include <components/bsa/decompressedcache.hpp>
+#include <components/sceneutil/workqueue.hpp>
+#include <components/vfs/manager.hpp>
+
 #include "scenemanager.hpp"
 #include "imagemanager.hpp"
 #include "niffilemanager.hpp"
@@ -10,6 +16,35 @@
 namespace Resource
 {
 
+    namespace
+    {
+        class PrefetchFileItem : public SceneUtil::WorkItem
+        {
+        public:
+            PrefetchFileItem(const VFS::Manager* vfs, const std::string& name)
+                : mVFS(vfs)
+                , mName(name)
+            {
+            }
+
+            void doWork() override
+            {
+                try
+                {
+                    mVFS->prefetch(mName);
+                }
+                catch (const std::exception&)
+                {
+                    // ignore, the error will be reported when the file is actually used
+                }
+            }
+
+        private:
+            const VFS::Manager* mVFS;
+            std::string mName;
+        };
+    }
+
     ResourceSystem::ResourceSystem(const VFS::Manager *vfs)
         : mVFS(vfs)
     {
@@ -95,6 +130,26 @@ namespace Resource
     {
         for (std::vector<BaseResourceManager*>::const_iterator it = mResourceManagers.begin(); it != mResourceManagers.end(); ++it)
             (*it)->reportStats(frameNumber, stats);
+
+        const Bsa::DecompressedCache::Stats cacheStats = Bsa::getDecompressedCache().getStats();
+        stats->setAttribute(frameNumber, "Decompressed Files", cacheStats.mFiles);
+        stats->setAttribute(frameNumber, "Decompressed Bytes", cacheStats.mBytes);
+        stats->setAttribute(frameNumber, "Decompressed Hits", cacheStats.mHits);
+        stats->setAttribute(frameNumber, "Decompressed Misses", cacheStats.mMisses);
+    }
+
+    void ResourceSystem::prefetchFiles(const std::vector<std::string>& names, SceneUtil::WorkQueue& workQueue) const
+    {
+        if (Bsa::getDecompressedCache().getMaxSize() == 0)
+            return;
+        std::vector<std::string> normalized;
+        normalized.reserve(names.size());
+        for (const std::string& name : names)
+            normalized.push_back(mVFS->normalizeFilename(name));
+        std::sort(normalized.begin(), normalized.end());
+        normalized.erase(std::unique(normalized.begin(), normalized.end()), normalized.end());
+        for (const std::string& name : normalized)
+            workQueue.addWorkItem(new PrefetchFileItem(mVFS, name));
     }
 
     void ResourceSystem::releaseGLObjects(osg::State *state)
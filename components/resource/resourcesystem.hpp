@@ -2,6 +2,7 @@
 #define OPENMW_COMPONENTS_RESOURCE_RESOURCESYSTEM_H
 
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace VFS
@@ -15,6 +16,11 @@ namespace osg
     class State;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace Resource
 {
 
@@ -61,6 +67,10 @@ namespace Resource
 
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const;
 
+        /// Decompress the given files into the decompressed archive entries cache in parallel, one work item per distinct file.
+        /// @note Does nothing if the cache is disabled. Missing and uncompressed files are skipped.
+        void prefetchFiles(const std::vector<std::string>& names, SceneUtil::WorkQueue& workQueue) const;
+
         /// Call releaseGLObjects for each resource manager.
         void releaseGLObjects(osg::State* state);
 
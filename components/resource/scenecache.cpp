@@ -0,0 +1,250 @@
+#include "scenecache.hpp"
+
+#include <osg/Drawable>
+#include <osg/Node>
+#include <osg/NodeVisitor>
+#include <osg/StateSet>
+#include <osg/Texture>
+#include <osg/UserDataContainer>
+#include <osg/Version>
+#include <osgDB/Options>
+#include <osgDB/ReaderWriter>
+#include <osgDB/Registry>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/hash.hpp>
+#include <components/sceneutil/serialize.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace Resource
+{
+    namespace
+    {
+        bool isOsgObject(const osg::Object& object)
+        {
+            return std::strcmp(object.libraryName(), "osg") == 0;
+        }
+
+        bool isSerializableNode(const osg::Node& node)
+        {
+            if (isOsgObject(node))
+                return true;
+            // Has a complete serializer registered by SceneUtil::registerNifOsgSerializers
+            return std::strcmp(node.libraryName(), "NifOsg") == 0 && std::strcmp(node.className(), "MatrixTransform") == 0;
+        }
+
+        bool isSerializable(const osg::UserDataContainer* container)
+        {
+            if (container == nullptr)
+                return true;
+            if (!isOsgObject(*container) || container->getUserData() != nullptr)
+                return false;
+            for (unsigned int i = 0; i < container->getNumUserObjects(); ++i)
+            {
+                const osg::Object* const object = container->getUserObject(i);
+                if (object != nullptr && !isOsgObject(*object))
+                    return false;
+            }
+            return true;
+        }
+
+        bool isSerializable(const osg::StateAttribute& attribute)
+        {
+            if (!isOsgObject(attribute) || attribute.getUpdateCallback() != nullptr || attribute.getEventCallback() != nullptr
+                || !isSerializable(attribute.getUserDataContainer()))
+                return false;
+            if (const osg::Texture* const texture = attribute.asTexture())
+            {
+                for (unsigned int i = 0; i < texture->getNumImages(); ++i)
+                {
+                    const osg::Image* const image = texture->getImage(i);
+                    if (image != nullptr && image->getFileName().empty())
+                        return false;
+                }
+            }
+            return true;
+        }
+
+        bool isSerializable(const osg::StateSet* stateSet)
+        {
+            if (stateSet == nullptr)
+                return true;
+            if (stateSet->getUpdateCallback() != nullptr || stateSet->getEventCallback() != nullptr
+                || !isSerializable(stateSet->getUserDataContainer()))
+                return false;
+            for (const auto& [type, attribute] : stateSet->getAttributeList())
+                if (!isSerializable(*attribute.first))
+                    return false;
+            for (const osg::StateSet::AttributeList& attributes : stateSet->getTextureAttributeList())
+                for (const auto& [type, attribute] : attributes)
+                    if (!isSerializable(*attribute.first))
+                        return false;
+            for (const auto& [name, uniform] : stateSet->getUniformList())
+                if (!isOsgObject(*uniform.first) || uniform.first->getUpdateCallback() != nullptr
+                    || uniform.first->getEventCallback() != nullptr)
+                    return false;
+            return true;
+        }
+
+        class IsSerializableVisitor : public osg::NodeVisitor
+        {
+        public:
+            bool mResult = true;
+
+            IsSerializableVisitor()
+                : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+            {
+            }
+
+            void apply(osg::Node& node) override
+            {
+                if (!mResult)
+                    return;
+                if (!isSerializableNode(node) || node.getUpdateCallback() != nullptr || node.getEventCallback() != nullptr
+                    || node.getCullCallback() != nullptr || node.getComputeBoundingSphereCallback() != nullptr
+                    || !isSerializable(node.getStateSet()) || !isSerializable(node.getUserDataContainer()))
+                {
+                    mResult = false;
+                    return;
+                }
+                if (const osg::Drawable* const drawable = node.asDrawable())
+                {
+                    if (drawable->getDrawCallback() != nullptr || drawable->getComputeBoundingBoxCallback() != nullptr)
+                    {
+                        mResult = false;
+                        return;
+                    }
+                }
+                traverse(node);
+            }
+        };
+
+        void removeStoredScenes(const std::filesystem::path& path)
+        {
+            for (const auto& entry : std::filesystem::directory_iterator(path))
+                if (entry.path().extension() == ".osgb")
+                    std::filesystem::remove(entry.path());
+        }
+    }
+
+    SceneCache::SceneCache(const std::filesystem::path& path, const std::string& version)
+        : mPath(path)
+    {
+        try
+        {
+            std::filesystem::create_directories(mPath);
+
+            const std::filesystem::path versionPath = mPath / "version";
+            std::string storedVersion;
+            std::getline(std::ifstream(versionPath), storedVersion);
+            // The format of the stored scenes depends on the OSG build too
+            const std::string fullVersion = version + " OSG " + osgGetVersion();
+            if (storedVersion != fullVersion)
+            {
+                removeStoredScenes(mPath);
+                std::ofstream(versionPath) << fullVersion << '\n';
+            }
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to prepare scene cache at " << mPath << ", disabling it: " << e.what();
+            return;
+        }
+
+        SceneUtil::registerNifOsgSerializers();
+
+        mReaderWriter = osgDB::Registry::instance()->getReaderWriterForExtension("osgb");
+        if (mReaderWriter == nullptr)
+            Log(Debug::Warning) << "No reader and writer for osgb files found, disabling scene cache";
+    }
+
+    osg::ref_ptr<osg::Node> SceneCache::read(const std::string& key, const osgDB::Options* options)
+    {
+        // Debug serializers replace the wrappers the stored scenes were written with
+        if (mReaderWriter == nullptr || SceneUtil::areDebugSerializersRegistered())
+            return nullptr;
+
+        std::ifstream stream(getPath(key), std::ios_base::binary);
+        if (!stream.is_open())
+        {
+            ++mMisses;
+            return nullptr;
+        }
+
+        osgDB::ReaderWriter::ReadResult result = mReaderWriter->readNode(stream, options);
+        if (!result.success() || result.getNode() == nullptr)
+        {
+            Log(Debug::Warning) << "Failed to read cached scene " << getPath(key) << ": " << result.message();
+            ++mMisses;
+            return nullptr;
+        }
+
+        ++mHits;
+        return result.getNode();
+    }
+
+    void SceneCache::write(const std::string& key, const osg::Node& node)
+    {
+        // Debug serializers drop the geometry data, so the scene would not be read back as it is
+        if (mReaderWriter == nullptr || SceneUtil::areDebugSerializersRegistered() || !isSerializable(node))
+            return;
+
+        const std::filesystem::path path = getPath(key);
+        std::filesystem::path temporaryPath = path;
+        temporaryPath += "." + std::to_string(mNextTemporary++) + ".tmp";
+
+        osg::ref_ptr<osgDB::Options> options = new osgDB::Options("WriteImageHint=UseExternal");
+
+        try
+        {
+            {
+                std::ofstream stream(temporaryPath, std::ios_base::binary);
+                const osgDB::ReaderWriter::WriteResult result = mReaderWriter->writeNode(node, stream, options);
+                if (!result.success() || !stream.good())
+                {
+                    Log(Debug::Warning) << "Failed to write cached scene " << path << ": " << result.message();
+                    stream.close();
+                    std::filesystem::remove(temporaryPath);
+                    return;
+                }
+            }
+            // Another thread might be writing the same scene, so readers must never see a partially written file
+            std::filesystem::rename(temporaryPath, path);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write cached scene " << path << ": " << e.what();
+            std::error_code ec;
+            std::filesystem::remove(temporaryPath, ec);
+        }
+    }
+
+    SceneCache::Stats SceneCache::getStats() const
+    {
+        Stats stats;
+        stats.mHits = mHits;
+        stats.mMisses = mMisses;
+        return stats;
+    }
+
+    bool SceneCache::isSerializable(const osg::Node& node)
+    {
+        IsSerializableVisitor visitor;
+        const_cast<osg::Node&>(node).accept(visitor);
+        return visitor.mResult;
+    }
+
+    std::filesystem::path SceneCache::getPath(const std::string& key) const
+    {
+        const std::array<std::uint64_t, 2> hash = Files::getHash(key);
+        std::ostringstream name;
+        name << std::hex << std::setfill('0') << std::setw(16) << hash[0] << std::setw(16) << hash[1] << ".osgb";
+        return mPath / name.str();
+    }
+}
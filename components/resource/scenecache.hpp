@@ -0,0 +1,66 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_SCENECACHE_H
+#define OPENMW_COMPONENTS_RESOURCE_SCENECACHE_H
+
+#include <osg/ref_ptr>
+
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <string>
+
+namespace osg
+{
+    class Node;
+}
+
+namespace osgDB
+{
+    class Options;
+    class ReaderWriter;
+}
+
+namespace Resource
+{
+    /// @brief Persistent cache of scene graphs converted from model files, stored as OSG binaries.
+    /// @par Only graphs made entirely of classes that can be written and read back without losing data are stored,
+    /// so it's always safe to use the result of read() in place of a conversion.
+    /// @note Thread safe.
+    class SceneCache
+    {
+    public:
+        struct Stats
+        {
+            std::size_t mHits = 0;
+            std::size_t mMisses = 0;
+        };
+
+        /// @param path Directory to store the scenes in. Created if missing.
+        /// @param version Identifies the engine build. Scenes stored by another build are removed.
+        SceneCache(const std::filesystem::path& path, const std::string& version);
+
+        /// @param key Identifies the source file contents and the settings affecting the conversion.
+        /// @param options Used to read the external files referenced by the scene, like images.
+        /// @return Scene stored for the key, or nullptr.
+        osg::ref_ptr<osg::Node> read(const std::string& key, const osgDB::Options* options);
+
+        /// Store the scene for the key. Scenes that can't be stored without losing data are ignored.
+        void write(const std::string& key, const osg::Node& node);
+
+        Stats getStats() const;
+
+        /// @return True if writing and reading back the scene gives the same scene. Images must be references to
+        /// files, since only their names are stored.
+        static bool isSerializable(const osg::Node& node);
+
+    private:
+        const std::filesystem::path mPath;
+        osgDB::ReaderWriter* mReaderWriter = nullptr;
+        std::atomic_size_t mNextTemporary {0};
+        std::atomic_size_t mHits {0};
+        std::atomic_size_t mMisses {0};
+
+        std::filesystem::path getPath(const std::string& key) const;
+    };
+}
+
+#endif
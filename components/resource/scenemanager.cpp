@@ -2,6 +2,7 @@
 
 #include <cstdlib>
 #include <filesystem>
+#include <sstream>
 
 #include <osg/AlphaFunc>
 #include <osg/Node>
@@ -45,6 +46,7 @@
 #include "imagemanager.hpp"
 #include "niffilemanager.hpp"
 #include "objectcache.hpp"
+#include "scenecache.hpp"
 
 namespace
 {
@@ -450,6 +452,22 @@ namespace Resource
         // this has to be defined in the .cpp file as we can't delete incomplete types
     }
 
+    void SceneManager::setSceneCache(std::unique_ptr<SceneCache> cache)
+    {
+        mSceneCache = std::move(cache);
+
+        // The converted scenes refer to textures by the paths resolved against the files existing in the VFS, e.g.
+        // .dds or .tga, so a different set of data directories or archives needs different cached scenes.
+        std::string texturePaths;
+        for (const std::string& path : mVFS->getRecursiveDirectoryIterator("textures/"))
+        {
+            texturePaths += path;
+            texturePaths += '\0';
+        }
+        const std::array<std::uint64_t, 2> hash = Files::getHash(texturePaths);
+        mTexturePathsKey = std::to_string(hash[0]) + ' ' + std::to_string(hash[1]);
+    }
+
     Shader::ShaderManager &SceneManager::getShaderManager()
     {
         return *mShaderManager.get();
@@ -676,7 +694,7 @@ namespace Resource
             osg::ref_ptr<osg::Node> loaded;
             try
             {
-                loaded = load(normalized, mVFS, mImageManager, mNifFileManager);
+                loaded = loadCached(normalized);
             }
             catch (const std::exception& e)
             {
@@ -732,6 +750,33 @@ namespace Resource
         }
     }
 
+    osg::ref_ptr<osg::Node> SceneManager::loadCached(const std::string& normalizedFilename)
+    {
+        if (mSceneCache == nullptr || Misc::getFileExtension(normalizedFilename) != "nif")
+            return load(normalizedFilename, mVFS, mImageManager, mNifFileManager);
+
+        // The conversion depends only on the file contents, the loader settings and the available textures
+        Files::FileView data = mVFS->getView(normalizedFilename);
+        const std::array<std::uint64_t, 2> fileHash = Files::getHash(data.getData());
+        std::ostringstream key;
+        key << normalizedFilename << ' ' << fileHash[0] << ' ' << fileHash[1]
+            << ' ' << NifOsg::Loader::getShowMarkers()
+            << ' ' << NifOsg::Loader::getHiddenNodeMask()
+            << ' ' << NifOsg::Loader::getIntersectionDisabledNodeMask()
+            << ' ' << mTexturePathsKey;
+
+        osg::ref_ptr<osgDB::Options> options (new osgDB::Options);
+        options->setReadFileCallback(new ImageReadCallback(mImageManager));
+        if (osg::ref_ptr<osg::Node> cached = mSceneCache->read(key.str(), options))
+            return cached;
+
+        // Parse the contents read for the hash instead of reading the file again
+        osg::ref_ptr<osg::Node> loaded = NifOsg::Loader::load(mNifFileManager->get(normalizedFilename, std::move(data)),
+            mImageManager);
+        mSceneCache->write(key.str(), *loaded);
+        return loaded;
+    }
+
     osg::ref_ptr<osg::Node> SceneManager::getInstance(const std::string& name)
     {
         osg::ref_ptr<const osg::Node> scene = getTemplate(name);
@@ -917,6 +962,18 @@ namespace Resource
         }
 
         stats->setAttribute(frameNumber, "Node", mCache->getCacheSize());
+
+        const ObjectCache::Stats nodeCacheStats = mCache->takeStats();
+        stats->setAttribute(frameNumber, "Node Hits", nodeCacheStats.mHits);
+        stats->setAttribute(frameNumber, "Node Misses", nodeCacheStats.mMisses);
+        stats->setAttribute(frameNumber, "Node Contentions", nodeCacheStats.mContentions);
+
+        if (mSceneCache != nullptr)
+        {
+            const SceneCache::Stats sceneCacheStats = mSceneCache->getStats();
+            stats->setAttribute(frameNumber, "Scene Cache Hits", sceneCacheStats.mHits);
+            stats->setAttribute(frameNumber, "Scene Cache Misses", sceneCacheStats.mMisses);
+        }
     }
 
     Shader::ShaderVisitor *SceneManager::createShaderVisitor(const std::string& shaderPrefix)
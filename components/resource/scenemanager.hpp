@@ -19,6 +19,7 @@ namespace Resource
 {
     class ImageManager;
     class NifFileManager;
+    class SceneCache;
     class SharedStateManager;
 }
 
@@ -188,6 +189,9 @@ namespace Resource
         /// otherwise should be disabled to reduce memory usage.
         void setUnRefImageDataAfterApply(bool unref);
 
+        /// Store the scenes converted from NIF files in the given cache and reuse them instead of converting again.
+        void setSceneCache(std::unique_ptr<SceneCache> cache);
+
         /// @see ResourceManager::updateCache
         void updateCache(double referenceTime) override;
 
@@ -199,6 +203,8 @@ namespace Resource
 
         Shader::ShaderVisitor* createShaderVisitor(const std::string& shaderPrefix = "objects");
 
+        osg::ref_ptr<osg::Node> loadCached(const std::string& normalizedFilename);
+
         std::unique_ptr<Shader::ShaderManager> mShaderManager;
         bool mForceShaders;
         bool mClampLighting;
@@ -227,6 +233,9 @@ namespace Resource
 
         osg::ref_ptr<osgUtil::IncrementalCompileOperation> mIncrementalCompileOperation;
 
+        std::unique_ptr<SceneCache> mSceneCache;
+        std::string mTexturePathsKey;
+
         unsigned int mParticleSystemMask;
 
         SceneManager(const SceneManager&);
@@ -376,15 +376,30 @@ void StatsHandler::setUpScene(osgViewer::ViewerBase *viewer)
             "Texture",
             "StateSet",
             "Node",
+            "Node Hits",
+            "Node Misses",
+            "Node Contentions",
             "Shape",
             "Shape Instance",
             "Image",
             "Nif",
             "Keyframe",
+            "Decompressed Files",
+            "Decompressed Bytes",
+            "Decompressed Hits",
+            "Decompressed Misses",
+            "Scene Cache Hits",
+            "Scene Cache Misses",
             "",
             "Groundcover Chunk",
             "Object Chunk",
+            "Object Chunk Hits",
+            "Object Chunk Misses",
+            "Object Chunk Contentions",
             "Terrain Chunk",
+            "Terrain Chunk Hits",
+            "Terrain Chunk Misses",
+            "Terrain Chunk Contentions",
             "Terrain Texture",
             "Land",
             "Composite",
@@ -407,6 +422,10 @@ void StatsHandler::setUpScene(osgViewer::ViewerBase *viewer)
             "Physics Objects",
             "Physics Projectiles",
             "Physics HeightFields",
+            "",
+            "Lua Events",
+            "Lua Event Bytes",
+            "Lua Event Time",
         });
 
         static const auto longest = std::max_element(statNames.begin(), statNames.end(),
@@ -6,15 +6,20 @@
 #include <components/resource/scenemanager.hpp>
 #include <osg/MatrixTransform>
 
+#include <algorithm>
+#include <map>
+#include <utility>
+
 #include "skeleton.hpp"
 #include "util.hpp"
 
 namespace
 {
-    inline void accumulateMatrix(const osg::Matrixf& invBindMatrix, const osg::Matrixf& matrix, const float weight, osg::Matrixf& result)
+    thread_local SceneUtil::SkinningBatch* sCurrentSkinningBatch = nullptr;
+
+    inline void accumulateMatrix(const osg::Matrixf& m, const float weight, osg::Matrixf& result)
     {
-        osg::Matrixf m = invBindMatrix * matrix;
-        float* ptr = m.ptr();
+        const float* ptr = m.ptr();
         float* ptrresult = result.ptr();
         ptrresult[0] += ptr[0] * weight;
         ptrresult[1] += ptr[1] * weight;
@@ -32,6 +37,21 @@ namespace
         ptrresult[13] += ptr[13] * weight;
         ptrresult[14] += ptr[14] * weight;
     }
+
+    // Skinning matrices are affine, so unlike osg::Matrixf::preMult there is no need for the projective divide
+    inline osg::Vec3f transformPoint(const float* m, const osg::Vec3f& v)
+    {
+        return osg::Vec3f(m[0] * v.x() + m[4] * v.y() + m[8] * v.z() + m[12],
+                          m[1] * v.x() + m[5] * v.y() + m[9] * v.z() + m[13],
+                          m[2] * v.x() + m[6] * v.y() + m[10] * v.z() + m[14]);
+    }
+
+    inline osg::Vec3f transformVector(const float* m, float x, float y, float z)
+    {
+        return osg::Vec3f(m[0] * x + m[4] * y + m[8] * z,
+                          m[1] * x + m[5] * y + m[9] * z,
+                          m[2] * x + m[6] * y + m[10] * z);
+    }
 }
 
 namespace SceneUtil
@@ -50,7 +70,7 @@ RigGeometry::RigGeometry(const RigGeometry &copy, const osg::CopyOp &copyop)
     : Drawable(copy, copyop)
     , mSkeleton(nullptr)
     , mInfluenceMap(copy.mInfluenceMap)
-    , mBone2VertexVector(copy.mBone2VertexVector)
+    , mVertexGroups(copy.mVertexGroups)
     , mBoneSphereVector(copy.mBoneSphereVector)
     , mLastFrameNumber(0)
     , mBoundsFirstFrame(true)
@@ -165,23 +185,6 @@ bool RigGeometry::initFromParentSkeleton(osg::NodeVisitor* nv)
         mBoneNodesVector.push_back(bone);
     }
 
-    for (auto& pair : mBone2VertexVector->mData)
-    {
-        for (auto &weight : pair.first)
-        {
-            const std::string& boneName = weight.first.first;
-            Bone* bone = mSkeleton->getBone(boneName);
-            if (!bone)
-            {
-                mBoneNodesVector.push_back(nullptr);
-                Log(Debug::Error) << "Error: RigGeometry did not find bone " << boneName;
-                continue;
-            }
-
-            mBoneNodesVector.push_back(bone);
-        }
-    }
-
     return true;
 }
 
@@ -207,66 +210,119 @@ void RigGeometry::cull(osg::NodeVisitor* nv)
     mLastFrameNumber = traversalNumber;
     osg::Geometry& geom = *getGeometry(mLastFrameNumber);
 
-    mSkeleton->updateBoneMatrices(traversalNumber);
-
-    // skinning
-    const osg::Vec3Array* positionSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getVertexArray());
-    const osg::Vec3Array* normalSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getNormalArray());
-    const osg::Vec4Array* tangentSrc = mSourceTangents;
+    if (SkinningBatch* batch = SkinningBatch::getCurrent())
+        batch->add(*this, geom);
+    else
+        updateVertices(geom);
 
     osg::Vec3Array* positionDst = static_cast<osg::Vec3Array*>(geom.getVertexArray());
     osg::Vec3Array* normalDst = static_cast<osg::Vec3Array*>(geom.getNormalArray());
     osg::Vec4Array* tangentDst = static_cast<osg::Vec4Array*>(geom.getTexCoordArray(7));
 
-    int index = mBoneSphereVector->mData.size();
-    for (auto &pair : mBone2VertexVector->mData)
+    positionDst->dirty();
+    if (normalDst)
+        normalDst->dirty();
+    if (tangentDst)
+        tangentDst->dirty();
+
+#if OSG_MIN_VERSION_REQUIRED(3, 5, 10)
+    geom.osg::Drawable::dirtyGLObjects();
+#endif
+
+    nv->pushOntoNodePath(&geom);
+    nv->apply(geom);
+    nv->popFromNodePath();
+}
+
+void RigGeometry::updateVertices(osg::Geometry& geom)
+{
+    mSkeleton->updateBoneMatrices(mLastFrameNumber);
+
+    updateGroupMatrices();
+
+    skin(geom);
+}
+
+void RigGeometry::updateGroupMatrices()
+{
+    const std::vector<std::pair<std::string, BoneInfluence>>& influences = mInfluenceMap->mData;
+    mBoneMatrices.resize(influences.size());
+    for (std::size_t i = 0; i < influences.size(); ++i)
+    {
+        if (const Bone* bone = mBoneNodesVector[i])
+            mBoneMatrices[i] = influences[i].second.mInvBindMatrix * bone->mMatrixInSkeletonSpace;
+    }
+
+    const VertexGroups& groups = *mVertexGroups;
+    mGroupMatrices.resize(groups.mGroups.size());
+    std::size_t weight = 0;
+    for (std::size_t i = 0; i < groups.mGroups.size(); ++i)
     {
-        osg::Matrixf resultMat (0, 0, 0, 0,
-                                0, 0, 0, 0,
-                                0, 0, 0, 0,
-                                0, 0, 0, 1);
+        osg::Matrixf& resultMat = mGroupMatrices[i];
+        resultMat.set(0, 0, 0, 0,
+                      0, 0, 0, 0,
+                      0, 0, 0, 0,
+                      0, 0, 0, 1);
 
-        for (auto &weight : pair.first)
+        for (const std::size_t end = groups.mGroups[i].mWeightsEnd; weight < end; ++weight)
         {
-            Bone* bone = mBoneNodesVector[index];
-            if (bone == nullptr)
+            const BoneWeight& boneWeight = groups.mWeights[weight];
+            if (mBoneNodesVector[boneWeight.first] == nullptr)
                 continue;
 
-            accumulateMatrix(weight.first.second, bone->mMatrixInSkeletonSpace, weight.second, resultMat);
-            index++;
+            accumulateMatrix(mBoneMatrices[boneWeight.first], boneWeight.second, resultMat);
         }
 
         if (mGeomToSkelMatrix)
             resultMat *= (*mGeomToSkelMatrix);
+    }
+}
+
+void RigGeometry::skin(osg::Geometry& geom) const
+{
+    const osg::Vec3Array& positionSrc = *static_cast<osg::Vec3Array*>(mSourceGeometry->getVertexArray());
+    const osg::Vec3Array* normalSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getNormalArray());
+    const osg::Vec4Array* tangentSrc = mSourceTangents;
+
+    osg::Vec3Array& positionDst = *static_cast<osg::Vec3Array*>(geom.getVertexArray());
+    osg::Vec3Array* normalDst = static_cast<osg::Vec3Array*>(geom.getNormalArray());
+    osg::Vec4Array* tangentDst = static_cast<osg::Vec4Array*>(geom.getTexCoordArray(7));
 
-        for (auto &vertex : pair.second)
+    const VertexGroups& groups = *mVertexGroups;
+    std::size_t begin = 0;
+    for (std::size_t i = 0; i < groups.mGroups.size(); ++i)
+    {
+        const float* m = mGroupMatrices[i].ptr();
+        const std::size_t end = groups.mGroups[i].mVerticesEnd;
+
+        for (std::size_t vertex = begin; vertex < end; ++vertex)
         {
-            (*positionDst)[vertex] = resultMat.preMult((*positionSrc)[vertex]);
-            if (normalDst)
-                (*normalDst)[vertex] = osg::Matrixf::transform3x3((*normalSrc)[vertex], resultMat);
+            const unsigned short index = groups.mVertices[vertex];
+            positionDst[index] = transformPoint(m, positionSrc[index]);
+        }
 
-            if (tangentDst)
+        if (normalDst)
+        {
+            for (std::size_t vertex = begin; vertex < end; ++vertex)
             {
-                const osg::Vec4f& srcTangent = (*tangentSrc)[vertex];
-                osg::Vec3f transformedTangent = osg::Matrixf::transform3x3(osg::Vec3f(srcTangent.x(), srcTangent.y(), srcTangent.z()), resultMat);
-                (*tangentDst)[vertex] = osg::Vec4f(transformedTangent, srcTangent.w());
+                const unsigned short index = groups.mVertices[vertex];
+                const osg::Vec3f& srcNormal = (*normalSrc)[index];
+                (*normalDst)[index] = transformVector(m, srcNormal.x(), srcNormal.y(), srcNormal.z());
             }
         }
-    }
 
-    positionDst->dirty();
-    if (normalDst)
-        normalDst->dirty();
-    if (tangentDst)
-        tangentDst->dirty();
-
-#if OSG_MIN_VERSION_REQUIRED(3, 5, 10)
-    geom.osg::Drawable::dirtyGLObjects();
-#endif
+        if (tangentDst)
+        {
+            for (std::size_t vertex = begin; vertex < end; ++vertex)
+            {
+                const unsigned short index = groups.mVertices[vertex];
+                const osg::Vec4f& srcTangent = (*tangentSrc)[index];
+                (*tangentDst)[index] = osg::Vec4f(transformVector(m, srcTangent.x(), srcTangent.y(), srcTangent.z()), srcTangent.w());
+            }
+        }
 
-    nv->pushOntoNodePath(&geom);
-    nv->apply(geom);
-    nv->popFromNodePath();
+        begin = end;
+    }
 }
 
 void RigGeometry::updateBounds(osg::NodeVisitor *nv)
@@ -287,15 +343,13 @@ void RigGeometry::updateBounds(osg::NodeVisitor *nv)
 
     osg::BoundingBox box;
 
-    int index = 0;
-    for (auto& boundPair : mBoneSphereVector->mData)
+    for (std::size_t i = 0; i < mBoneSphereVector->mData.size(); ++i)
     {
-        Bone* bone = mBoneNodesVector[index];
+        Bone* bone = mBoneNodesVector[i];
         if (bone == nullptr)
             continue;
 
-        index++;
-        osg::BoundingSpheref bs = boundPair.second;
+        osg::BoundingSpheref bs = mBoneSphereVector->mData[i].second;
         if (mGeomToSkelMatrix)
             transformBoundingSphere(bone->mMatrixInSkeletonSpace * (*mGeomToSkelMatrix), bs);
         else
@@ -358,29 +412,37 @@ void RigGeometry::setInfluenceMap(osg::ref_ptr<InfluenceMap> influenceMap)
     Vertex2BoneMap vertex2BoneMap;
     mBoneSphereVector = new BoneSphereVector;
     mBoneSphereVector->mData.reserve(mInfluenceMap->mData.size());
-    mBone2VertexVector = new Bone2VertexVector;
-    for (auto& influencePair : mInfluenceMap->mData)
+    for (std::size_t i = 0; i < mInfluenceMap->mData.size(); ++i)
     {
-        const std::string& boneName = influencePair.first;
-        const BoneInfluence& bi = influencePair.second;
+        const std::string& boneName = mInfluenceMap->mData[i].first;
+        const BoneInfluence& bi = mInfluenceMap->mData[i].second;
         mBoneSphereVector->mData.emplace_back(boneName, bi.mBoundSphere);
 
         for (auto& weightPair: bi.mWeights)
         {
             std::vector<BoneWeight>& vec = vertex2BoneMap[weightPair.first];
 
-            vec.emplace_back(std::make_pair(boneName, bi.mInvBindMatrix), weightPair.second);
+            vec.emplace_back(static_cast<unsigned int>(i), weightPair.second);
         }
     }
 
+    typedef std::map<std::vector<BoneWeight>, std::vector<unsigned short> > Bone2VertexMap;
     Bone2VertexMap bone2VertexMap;
     for (auto& vertexPair : vertex2BoneMap)
     {
         bone2VertexMap[vertexPair.second].emplace_back(vertexPair.first);
     }
 
-    mBone2VertexVector->mData.reserve(bone2VertexMap.size());
-    mBone2VertexVector->mData.assign(bone2VertexMap.begin(), bone2VertexMap.end());
+    mVertexGroups = new VertexGroups;
+    mVertexGroups->mGroups.reserve(bone2VertexMap.size());
+    mVertexGroups->mVertices.reserve(vertex2BoneMap.size());
+    for (auto& bonePair : bone2VertexMap)
+    {
+        VertexGroups& groups = *mVertexGroups;
+        groups.mWeights.insert(groups.mWeights.end(), bonePair.first.begin(), bonePair.first.end());
+        groups.mVertices.insert(groups.mVertices.end(), bonePair.second.begin(), bonePair.second.end());
+        groups.mGroups.push_back(VertexGroups::Group {groups.mWeights.size(), groups.mVertices.size()});
+    }
 }
 
 void RigGeometry::accept(osg::NodeVisitor &nv)
@@ -410,5 +472,59 @@ osg::Geometry* RigGeometry::getGeometry(unsigned int frame) const
     return mGeometry[frame%2].get();
 }
 
+SkinningBatch::SkinningBatch(std::size_t threadsCount)
+    : mThreadPool(threadsCount)
+{
+}
+
+void SkinningBatch::operator()(osg::Node* node, osg::NodeVisitor* nv)
+{
+    SkinningBatch* const previous = std::exchange(sCurrentSkinningBatch, this);
+    try
+    {
+        traverse(node, nv);
+    }
+    catch (...)
+    {
+        sCurrentSkinningBatch = previous;
+        mPending.clear();
+        throw;
+    }
+    sCurrentSkinningBatch = previous;
+
+    std::vector<std::pair<osg::ref_ptr<RigGeometry>, osg::Geometry*>> pending;
+    pending.swap(mPending);
+
+    // RigGeometries sharing a skeleton are updated by the same task, so the skeleton is updated only once
+    const auto bySkeleton = [] (const auto& lhs, const auto& rhs) { return lhs.first->mSkeleton < rhs.first->mSkeleton; };
+    std::sort(pending.begin(), pending.end(), bySkeleton);
+    mSkeletonRanges.clear();
+    for (auto it = pending.begin(); it != pending.end(); )
+    {
+        const auto end = std::upper_bound(it, pending.end(), *it, bySkeleton);
+        mSkeletonRanges.emplace_back(it - pending.begin(), end - pending.begin());
+        it = end;
+    }
+
+    mThreadPool.run(mSkeletonRanges.size(), [&] (std::size_t i)
+    {
+        for (std::size_t j = mSkeletonRanges[i].first; j < mSkeletonRanges[i].second; ++j)
+            pending[j].first->updateVertices(*pending[j].second);
+    });
+    pending.clear();
+    // Reuse the allocated storage in the next frame
+    mPending.swap(pending);
+}
+
+SkinningBatch* SkinningBatch::getCurrent()
+{
+    return sCurrentSkinningBatch;
+}
+
+void SkinningBatch::add(RigGeometry& rig, osg::Geometry& geom)
+{
+    mPending.emplace_back(&rig, &geom);
+}
+
 
 }
@@ -4,6 +4,10 @@
 #include <osg/Geometry>
 #include <osg/Matrixf>
 
+#include <components/misc/threadpool.hpp>
+
+#include "nodecallback.hpp"
+
 namespace SceneUtil
 {
     class Skeleton;
@@ -72,9 +76,21 @@ namespace SceneUtil
         };
 
     private:
+        friend class SkinningBatch;
+
         void cull(osg::NodeVisitor* nv);
         void updateBounds(osg::NodeVisitor* nv);
 
+        /// Update the skeleton and skin the given geometry for the last culled frame.
+        /// @note Only touches this RigGeometry and its skeleton, so RigGeometries of different skeletons can be updated in parallel.
+        void updateVertices(osg::Geometry& geom);
+
+        /// Compute the skinning matrix of each vertex group from the current bone matrices.
+        void updateGroupMatrices();
+
+        /// Transform the source vertices into the given geometry using the skinning matrices of the vertex groups.
+        void skin(osg::Geometry& geom) const;
+
         osg::ref_ptr<osg::Geometry> mGeometry[2];
         osg::Geometry* getGeometry(unsigned int frame) const;
 
@@ -86,25 +102,32 @@ namespace SceneUtil
 
         osg::ref_ptr<InfluenceMap> mInfluenceMap;
 
-        typedef std::pair<std::string, osg::Matrixf> BoneBindMatrixPair;
-
-        typedef std::pair<BoneBindMatrixPair, float> BoneWeight;
-
-        typedef std::vector<unsigned short> VertexList;
-
-        typedef std::map<std::vector<BoneWeight>, VertexList> Bone2VertexMap;
+        // <index in the influence map, weight>
+        typedef std::pair<unsigned int, float> BoneWeight;
 
-        struct Bone2VertexVector : public osg::Referenced
+        /// Vertices influenced by the same bones with the same weights, stored contiguously group after group.
+        struct VertexGroups : public osg::Referenced
         {
-            std::vector<std::pair<std::vector<BoneWeight>, VertexList>> mData;
+            struct Group
+            {
+                std::size_t mWeightsEnd;
+                std::size_t mVerticesEnd;
+            };
+
+            std::vector<Group> mGroups;
+            std::vector<BoneWeight> mWeights;
+            std::vector<unsigned short> mVertices;
         };
-        osg::ref_ptr<Bone2VertexVector> mBone2VertexVector;
+        osg::ref_ptr<VertexGroups> mVertexGroups;
+        std::vector<osg::Matrixf> mBoneMatrices;
+        std::vector<osg::Matrixf> mGroupMatrices;
 
         struct BoneSphereVector : public osg::Referenced
         {
             std::vector<std::pair<std::string, osg::BoundingSpheref>> mData;
         };
         osg::ref_ptr<BoneSphereVector> mBoneSphereVector;
+        // Same order as the influence map
         std::vector<Bone*> mBoneNodesVector;
 
         unsigned int mLastFrameNumber;
@@ -115,6 +138,29 @@ namespace SceneUtil
         void updateGeomToSkelMatrix(const osg::NodePath& nodePath);
     };
 
+    /// @brief Cull callback deferring the skinning of the RigGeometries culled below its node until the traversal is done,
+    /// then updating their skeletons and skinning all of them at once on the culling thread and a pool of worker threads.
+    /// @note Vertex data is only read by the draw, which starts after the cull traversal, so the results are the same.
+    /// RigGeometries culled outside of such a node are skinned immediately.
+    class SkinningBatch : public SceneUtil::NodeCallback<SkinningBatch>
+    {
+    public:
+        /// @param threadsCount number of worker threads in addition to the culling one
+        explicit SkinningBatch(std::size_t threadsCount);
+
+        void operator()(osg::Node* node, osg::NodeVisitor* nv);
+
+        /// Batch active on the calling thread, if any.
+        static SkinningBatch* getCurrent();
+
+        void add(RigGeometry& rig, osg::Geometry& geom);
+
+    private:
+        Misc::ThreadPool mThreadPool;
+        std::vector<std::pair<osg::ref_ptr<RigGeometry>, osg::Geometry*>> mPending;
+        std::vector<std::pair<std::size_t, std::size_t>> mSkeletonRanges;
+    };
+
 }
 
 #endif
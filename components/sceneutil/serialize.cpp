@@ -1,6 +1,8 @@
 #include "serialize.hpp"
 
+#include <osgDB/InputStream>
 #include <osgDB/ObjectWrapper>
+#include <osgDB/OutputStream>
 #include <osgDB/Registry>
 
 #include <components/nifosg/matrixtransform.hpp>
@@ -10,6 +12,8 @@
 #include <components/sceneutil/riggeometry.hpp>
 #include <components/sceneutil/morphgeometry.hpp>
 
+#include <atomic>
+
 namespace SceneUtil
 {
 
@@ -82,6 +86,33 @@ public:
     MatrixTransformSerializer()
         : osgDB::ObjectWrapper(createInstanceFunc<NifOsg::MatrixTransform>, "NifOsg::MatrixTransform", "osg::Object osg::Node osg::Group osg::Transform osg::MatrixTransform NifOsg::MatrixTransform")
     {
+        addSerializer( new osgDB::UserSerializer< NifOsg::MatrixTransform >(
+            "RotationScale", &checkRotationScale, &readRotationScale, &writeRotationScale), osgDB::BaseSerializer::RW_USER );
+    }
+
+private:
+    static bool checkRotationScale(const NifOsg::MatrixTransform& /*node*/)
+    {
+        return true;
+    }
+
+    static bool readRotationScale(osgDB::InputStream& is, NifOsg::MatrixTransform& node)
+    {
+        is >> node.mScale;
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                is >> node.mRotationScale.mValues[i][j];
+        return true;
+    }
+
+    static bool writeRotationScale(osgDB::OutputStream& os, const NifOsg::MatrixTransform& node)
+    {
+        os << node.mScale;
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                os << node.mRotationScale.mValues[i][j];
+        os << std::endl;
+        return true;
     }
 };
 
@@ -99,11 +130,28 @@ public:
     }
 };
 
+static std::atomic_bool sDebugSerializersRegistered {false};
+
+void registerNifOsgSerializers()
+{
+    static const bool done = [] {
+        osgDB::Registry::instance()->getObjectWrapperManager()->addWrapper(new MatrixTransformSerializer);
+        return true;
+    } ();
+    static_cast<void>(done);
+}
+
+bool areDebugSerializersRegistered()
+{
+    return sDebugSerializersRegistered;
+}
+
 void registerSerializers()
 {
     static bool done = false;
     if (!done)
     {
+        sDebugSerializersRegistered = true;
         osgDB::ObjectWrapperManager* mgr = osgDB::Registry::instance()->getObjectWrapperManager();
         mgr->addWrapper(new PositionAttitudeTransformSerializer);
         mgr->addWrapper(new SkeletonSerializer);
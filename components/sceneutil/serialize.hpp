@@ -7,6 +7,13 @@ namespace SceneUtil
     /// Register osg node serializers for certain SceneUtil classes if not already done so
     void registerSerializers();
 
+    /// Register osg node serializers for the NifOsg classes that can be written and read back without losing data.
+    /// @note Thread safe.
+    void registerNifOsgSerializers();
+
+    /// @return True once registerSerializers() was called. From then on osg::Geometry is written without its data.
+    bool areDebugSerializersRegistered();
+
 }
 
 #endif
@@ -2,37 +2,39 @@
 
 #include <osg/MatrixTransform>
 
-#include <components/debug/debuglog.hpp>
-#include <components/misc/stringops.hpp>
+#include <algorithm>
 
 namespace SceneUtil
 {
 
-class InitBoneCacheVisitor : public osg::NodeVisitor
+class InitBoneIndexVisitor : public osg::NodeVisitor
 {
 public:
-    typedef std::vector<osg::MatrixTransform*> TransformPath;
-    InitBoneCacheVisitor(std::unordered_map<std::string, TransformPath>& cache)
+    InitBoneIndexVisitor(std::vector<Skeleton::BoneNode>& nodes, Skeleton::BoneIndex& index)
         : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
-        , mCache(cache)
+        , mNodes(nodes)
+        , mIndex(index)
     {
     }
 
     void apply(osg::MatrixTransform &node) override
     {
-        mPath.push_back(&node);
-        mCache[Misc::StringUtils::lowerCase(node.getName())] = mPath;
+        const std::size_t index = mNodes.size();
+        mNodes.push_back(Skeleton::BoneNode {&node, mPath.empty() ? Skeleton::sNoParent : mPath.back(), nullptr});
+        mIndex[node.getName()] = index;
+        mPath.push_back(index);
         traverse(node);
         mPath.pop_back();
     }
 
 private:
-    TransformPath mPath;
-    std::unordered_map<std::string, TransformPath>& mCache;
+    std::vector<std::size_t> mPath;
+    std::vector<Skeleton::BoneNode>& mNodes;
+    Skeleton::BoneIndex& mIndex;
 };
 
 Skeleton::Skeleton()
-    : mBoneCacheInit(false)
+    : mBoneIndexInit(false)
     , mNeedToUpdateBoneMatrices(true)
     , mActive(Active)
     , mLastFrameNumber(0)
@@ -43,7 +45,7 @@ Skeleton::Skeleton()
 
 Skeleton::Skeleton(const Skeleton &copy, const osg::CopyOp &copyop)
     : osg::Group(copy, copyop)
-    , mBoneCacheInit(false)
+    , mBoneIndexInit(false)
     , mNeedToUpdateBoneMatrices(true)
     , mActive(copy.mActive)
     , mLastFrameNumber(0)
@@ -54,49 +56,41 @@ Skeleton::Skeleton(const Skeleton &copy, const osg::CopyOp &copyop)
 
 Bone* Skeleton::getBone(const std::string &name)
 {
-    if (!mBoneCacheInit)
+    if (!mBoneIndexInit)
     {
-        InitBoneCacheVisitor visitor(mBoneCache);
+        InitBoneIndexVisitor visitor(mBoneNodes, mBoneIndex);
         accept(visitor);
-        mBoneCacheInit = true;
+        mBoneIndexInit = true;
     }
 
-    BoneCache::iterator found = mBoneCache.find(Misc::StringUtils::lowerCase(name));
-    if (found == mBoneCache.end())
+    BoneIndex::const_iterator found = Misc::StringUtils::ciFind(mBoneIndex, name);
+    if (found == mBoneIndex.end())
         return nullptr;
 
-    // find or insert in the bone hierarchy
+    return getOrCreateBone(found->second);
+}
 
-    if (!mRootBone.get())
-    {
-        mRootBone.reset(new Bone);
-    }
+Bone* Skeleton::getOrCreateBone(std::size_t index)
+{
+    BoneNode& boneNode = mBoneNodes[index];
+    if (boneNode.mBone != nullptr)
+        return boneNode.mBone;
 
-    Bone* bone = mRootBone.get();
-    for (osg::MatrixTransform* matrixTransform : found->second)
+    Bone* parent = boneNode.mParent == sNoParent ? nullptr : getOrCreateBone(boneNode.mParent);
+
+    // find or insert in the bone hierarchy, bones created before markDirty are still referenced by RigGeometries
+    const auto existing = std::find_if(mBones.begin(), mBones.end(),
+        [&] (const std::unique_ptr<Bone>& bone) { return bone->mNode == boneNode.mNode && bone->mParent == parent; });
+    if (existing != mBones.end())
     {
-        Bone* child = nullptr;
-        for (unsigned int i=0; i<bone->mChildren.size(); ++i)
-        {
-            if (bone->mChildren[i]->mNode == matrixTransform)
-            {
-                child = bone->mChildren[i];
-                break;
-            }
-        }
-
-        if (!child)
-        {
-            child = new Bone;
-            bone->mChildren.push_back(child);
-            mNeedToUpdateBoneMatrices = true;
-        }
-        bone = child;
-
-        bone->mNode = matrixTransform;
+        boneNode.mBone = existing->get();
+        return boneNode.mBone;
     }
 
-    return bone;
+    mBones.push_back(std::make_unique<Bone>(boneNode.mNode, parent));
+    mNeedToUpdateBoneMatrices = true;
+    boneNode.mBone = mBones.back().get();
+    return boneNode.mBone;
 }
 
 void Skeleton::updateBoneMatrices(unsigned int traversalNumber)
@@ -108,11 +102,8 @@ void Skeleton::updateBoneMatrices(unsigned int traversalNumber)
 
     if (mNeedToUpdateBoneMatrices)
     {
-        if (mRootBone.get())
-        {
-            for (unsigned int i=0; i<mRootBone->mChildren.size(); ++i)
-                mRootBone->mChildren[i]->update(nullptr);
-        }
+        for (const std::unique_ptr<Bone>& bone : mBones)
+            bone->update();
 
         mNeedToUpdateBoneMatrices = false;
     }
@@ -131,8 +122,9 @@ bool Skeleton::getActive() const
 void Skeleton::markDirty()
 {
     mLastFrameNumber = 0;
-    mBoneCache.clear();
-    mBoneCacheInit = false;
+    mBoneNodes.clear();
+    mBoneIndex.clear();
+    mBoneIndexInit = false;
 }
 
 void Skeleton::traverse(osg::NodeVisitor& nv)
@@ -160,34 +152,27 @@ void Skeleton::childRemoved(unsigned int, unsigned int)
     markDirty();
 }
 
-Bone::Bone()
-    : mNode(nullptr)
-{
-}
-
-Bone::~Bone()
+Bone::Bone(osg::MatrixTransform* node, Bone* parent)
+    : mNode(node)
+    , mParent(parent)
+    , mChanged(false)
+    , mInitialized(false)
 {
-    for (unsigned int i=0; i<mChildren.size(); ++i)
-        delete mChildren[i];
-    mChildren.clear();
 }
 
-void Bone::update(const osg::Matrixf* parentMatrixInSkeletonSpace)
+void Bone::update()
 {
-    if (!mNode)
-    {
-        Log(Debug::Error) << "Error: Bone without node";
+    const osg::Matrix& matrix = mNode->getMatrix();
+    mChanged = !mInitialized || (mParent != nullptr && mParent->mChanged) || matrix != mMatrix;
+    if (!mChanged)
         return;
-    }
-    if (parentMatrixInSkeletonSpace)
-        mMatrixInSkeletonSpace = mNode->getMatrix() * (*parentMatrixInSkeletonSpace);
-    else
-        mMatrixInSkeletonSpace = mNode->getMatrix();
 
-    for (unsigned int i=0; i<mChildren.size(); ++i)
-    {
-        mChildren[i]->update(&mMatrixInSkeletonSpace);
-    }
+    mInitialized = true;
+    mMatrix = matrix;
+    if (mParent != nullptr)
+        mMatrixInSkeletonSpace = matrix * mParent->mMatrixInSkeletonSpace;
+    else
+        mMatrixInSkeletonSpace = matrix;
 }
 
 }
@@ -2,9 +2,13 @@
 #define OPENMW_COMPONENTS_NIFOSG_SKELETON_H
 
 #include <osg/Group>
+#include <osg/Matrix>
+
+#include <components/misc/stringops.hpp>
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace SceneUtil
 {
@@ -14,19 +18,24 @@ namespace SceneUtil
     class Bone
     {
     public:
-        Bone();
-        ~Bone();
+        Bone(osg::MatrixTransform* node, Bone* parent);
 
         osg::Matrixf mMatrixInSkeletonSpace;
 
         osg::MatrixTransform* mNode;
 
-        std::vector<Bone*> mChildren;
+        /// nullptr for the bones attached directly to the skeleton.
+        Bone* mParent;
 
-        /// Update the skeleton-space matrix of this bone and all its children.
-        void update(const osg::Matrixf* parentMatrixInSkeletonSpace);
+        /// Update the skeleton-space matrix of this bone if its node or parent has changed since the last update.
+        /// @note The parent has to be updated first.
+        void update();
 
     private:
+        osg::Matrix mMatrix;
+        bool mChanged;
+        bool mInitialized;
+
         Bone(const Bone&);
         void operator=(const Bone&);
     };
@@ -46,6 +55,7 @@ namespace SceneUtil
         Bone* getBone(const std::string& name);
 
         /// Request an update of bone matrices. May be a no-op if already updated in this frame.
+        /// @note Only touches this skeleton, so different skeletons can be updated in parallel.
         void updateBoneMatrices(unsigned int traversalNumber);
 
         enum ActiveType
@@ -69,13 +79,27 @@ namespace SceneUtil
         void childRemoved(unsigned int, unsigned int) override;
 
     private:
-        // The root bone is not a "real" bone, it has no corresponding node in the scene graph.
-        // As far as the scene graph goes we support multiple root bones.
-        std::unique_ptr<Bone> mRootBone;
+        friend class InitBoneIndexVisitor;
 
-        typedef std::unordered_map<std::string, std::vector<osg::MatrixTransform*> > BoneCache;
-        BoneCache mBoneCache;
-        bool mBoneCacheInit;
+        static constexpr std::size_t sNoParent = static_cast<std::size_t>(-1);
+
+        struct BoneNode
+        {
+            osg::MatrixTransform* mNode;
+            std::size_t mParent; ///< index of the closest osg::MatrixTransform above, sNoParent if none
+            Bone* mBone; ///< nullptr until requested
+        };
+
+        // All osg::MatrixTransform nodes below the skeleton, parents before their children
+        std::vector<BoneNode> mBoneNodes;
+
+        typedef std::unordered_map<std::string, std::size_t, Misc::StringUtils::CiHash, Misc::StringUtils::CiEqual> BoneIndex;
+        BoneIndex mBoneIndex;
+        bool mBoneIndexInit;
+
+        // Bones in the order of creation, so parents are always updated before their children.
+        // As far as the scene graph goes we support multiple root bones.
+        std::vector<std::unique_ptr<Bone>> mBones;
 
         bool mNeedToUpdateBoneMatrices;
 
@@ -83,6 +107,8 @@ namespace SceneUtil
 
         unsigned int mLastFrameNumber;
         unsigned int mLastCullFrameNumber;
+
+        Bone* getOrCreateBone(std::size_t index);
     };
 
 }
@@ -74,6 +74,11 @@ osg::ref_ptr<osg::Node> ChunkManager::getChunk(float size, const osg::Vec2f& cen
 void ChunkManager::reportStats(unsigned int frameNumber, osg::Stats *stats) const
 {
     stats->setAttribute(frameNumber, "Terrain Chunk", mCache->getCacheSize());
+
+    const auto cacheStats = mCache->takeStats();
+    stats->setAttribute(frameNumber, "Terrain Chunk Hits", cacheStats.mHits);
+    stats->setAttribute(frameNumber, "Terrain Chunk Misses", cacheStats.mMisses);
+    stats->setAttribute(frameNumber, "Terrain Chunk Contentions", cacheStats.mContentions);
 }
 
 void ChunkManager::clearCache()
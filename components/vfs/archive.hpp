@@ -4,6 +4,7 @@
 #include <map>
 
 #include <components/files/constrainedfilestream.hpp>
+#include <components/files/memorymappedfile.hpp>
 
 namespace VFS
 {
@@ -14,6 +15,14 @@ namespace VFS
         virtual ~File() {}
 
         virtual Files::IStreamPtr open() = 0;
+
+        /// Get a read-only view of the file contents without copying them.
+        /// @return An invalid view if the archive can not provide one, open() has to be used instead.
+        virtual Files::FileView view() { return {}; }
+
+        /// Prepare the file so that a later open() is cheaper, e.g. by decompressing it into a cache.
+        /// @note Thread safe.
+        virtual void prefetch() {}
     };
 
     class Archive
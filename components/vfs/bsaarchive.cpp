@@ -6,10 +6,12 @@
 namespace VFS
 {
 
-BsaArchive::BsaArchive(const std::string &filename)
+BsaArchive::BsaArchive(const std::string &filename, bool memoryMap)
 {
     mFile = std::make_unique<Bsa::BSAFile>(Bsa::BSAFile());
     mFile->open(filename);
+    if (memoryMap)
+        mFile->mapArchive();
 
     const Bsa::BSAFile::FileList &filelist = mFile->getList();
     for(Bsa::BSAFile::FileList::const_iterator it = filelist.begin();it != filelist.end();++it)
@@ -53,18 +55,21 @@ std::string BsaArchive::getDescription() const
     return std::string{"BSA: "} + mFile->getFilename();
 }
 
-CompressedBsaArchive::CompressedBsaArchive(const std::string &filename)
+CompressedBsaArchive::CompressedBsaArchive(const std::string &filename, bool memoryMap)
     : BsaArchive()
 {
-    mFile = std::make_unique<Bsa::BSAFile>(Bsa::CompressedBSAFile());
-    mFile->open(filename);
+    auto compressedFile = std::make_unique<Bsa::CompressedBSAFile>();
+    compressedFile->open(filename);
+    if (memoryMap)
+        compressedFile->mapArchive();
 
-    const Bsa::BSAFile::FileList &filelist = mFile->getList();
+    const Bsa::BSAFile::FileList &filelist = compressedFile->getList();
     for(Bsa::BSAFile::FileList::const_iterator it = filelist.begin();it != filelist.end();++it)
     {
-        mResources.emplace_back(&*it, mFile.get());
-        mCompressedResources.emplace_back(&*it, static_cast<Bsa::CompressedBSAFile*>(mFile.get()));
+        mResources.emplace_back(&*it, compressedFile.get());
+        mCompressedResources.emplace_back(&*it, compressedFile.get());
     }
+    mFile = std::move(compressedFile);
 }
 
 void CompressedBsaArchive::listResources(std::map<std::string, File *> &out, char (*normalize_function)(char))
@@ -92,6 +97,11 @@ Files::IStreamPtr BsaArchiveFile::open()
     return mFile->getFile(mInfo);
 }
 
+Files::FileView BsaArchiveFile::view()
+{
+    return mFile->getFileView(mInfo);
+}
+
 CompressedBsaArchiveFile::CompressedBsaArchiveFile(const Bsa::BSAFile::FileStruct *info, Bsa::CompressedBSAFile* bsa)
     : BsaArchiveFile(info, bsa)
     , mCompressedFile(bsa)
@@ -104,4 +114,14 @@ Files::IStreamPtr CompressedBsaArchiveFile::open()
     return mCompressedFile->getFile(mInfo);
 }
 
+Files::FileView CompressedBsaArchiveFile::view()
+{
+    return mCompressedFile->getFileView(mInfo);
+}
+
+void CompressedBsaArchiveFile::prefetch()
+{
+    mCompressedFile->prefetch(mInfo);
+}
+
 }
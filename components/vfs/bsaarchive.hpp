@@ -14,6 +14,7 @@ namespace VFS
         BsaArchiveFile(const Bsa::BSAFile::FileStruct* info, Bsa::BSAFile* bsa);
 
         Files::IStreamPtr open() override;
+        Files::FileView view() override;
 
         const Bsa::BSAFile::FileStruct* mInfo;
         Bsa::BSAFile* mFile;
@@ -25,6 +26,8 @@ namespace VFS
         CompressedBsaArchiveFile(const Bsa::BSAFile::FileStruct* info, Bsa::CompressedBSAFile* bsa);
 
         Files::IStreamPtr open() override;
+        Files::FileView view() override;
+        void prefetch() override;
         Bsa::CompressedBSAFile* mCompressedFile;
     };
 
@@ -32,7 +35,8 @@ namespace VFS
     class BsaArchive : public Archive
     {
     public:
-        BsaArchive(const std::string& filename);
+        /// @param memoryMap Map the whole archive into memory and serve files from the mapping.
+        BsaArchive(const std::string& filename, bool memoryMap = false);
         BsaArchive();
         virtual ~BsaArchive();
         void listResources(std::map<std::string, File*>& out, char (*normalize_function) (char)) override;
@@ -47,12 +51,11 @@ namespace VFS
     class CompressedBsaArchive : public BsaArchive
     {
     public:
-        CompressedBsaArchive(const std::string& filename);
+        CompressedBsaArchive(const std::string& filename, bool memoryMap = false);
         void listResources(std::map<std::string, File*>& out, char (*normalize_function) (char)) override;
         virtual ~CompressedBsaArchive() {}
 
     private:
-        std::unique_ptr<Bsa::CompressedBSAFile> mCompressedFile;
         std::vector<CompressedBsaArchiveFile> mCompressedResources;
     };
 
@@ -2,16 +2,17 @@
 
 #include <algorithm>
 
-#include <boost/filesystem.hpp>
-
 #include <components/debug/debuglog.hpp>
 
+#include "indexcache.hpp"
+
 namespace VFS
 {
 
-    FileSystemArchive::FileSystemArchive(const std::string &path)
+    FileSystemArchive::FileSystemArchive(const std::string &path, IndexCache* indexCache)
         : mBuiltIndex(false)
         , mPath(path)
+        , mIndexCache(indexCache)
     {
 
     }
@@ -20,22 +21,24 @@ namespace VFS
     {
         if (!mBuiltIndex)
         {
-            typedef boost::filesystem::recursive_directory_iterator directory_iterator;
-
-            directory_iterator end;
+            std::optional<DirectoryListing> listing;
+            if (mIndexCache != nullptr)
+                listing = mIndexCache->get(mPath);
+            if (!listing.has_value())
+            {
+                listing = scanDirectory(mPath);
+                if (mIndexCache != nullptr)
+                    mIndexCache->set(mPath, *listing);
+            }
+            mIndexCache = nullptr;
 
             size_t prefix = mPath.size ();
 
             if (mPath.size () > 0 && mPath [prefix - 1] != '\\' && mPath [prefix - 1] != '/')
                 ++prefix;
 
-            for (directory_iterator i (mPath); i != end; ++i)
+            for (const std::string& proper : listing->mFiles)
             {
-                if(boost::filesystem::is_directory (*i))
-                    continue;
-
-                std::string proper = i->path ().string ();
-
                 FileSystemArchiveFile file(proper);
 
                 std::string searchable;
@@ -3,8 +3,11 @@
 
 #include "archive.hpp"
 
+#include <string>
+
 namespace VFS
 {
+    class IndexCache;
 
     class FileSystemArchiveFile : public File
     {
@@ -21,7 +24,9 @@ namespace VFS
     class FileSystemArchive : public Archive
     {
     public:
-        FileSystemArchive(const std::string& path);
+        /// @param indexCache Optional snapshot of directory listings to use instead of scanning the directory.
+        /// Only used by the first listResources() call, so it only needs to outlive that.
+        FileSystemArchive(const std::string& path, IndexCache* indexCache = nullptr);
 
         void listResources(std::map<std::string, File*>& out, char (*normalize_function) (char)) override;
 
@@ -35,6 +40,7 @@ namespace VFS
 
         bool mBuiltIndex;
         std::string mPath;
+        IndexCache* mIndexCache;
 
     };
 
@@ -0,0 +1,238 @@
+#include "indexcache.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/serialization/binaryreader.hpp>
+#include <components/serialization/binarywriter.hpp>
+#include <components/serialization/format.hpp>
+#include <components/serialization/sizeaccumulator.hpp>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <cstring>
+#include <ctime>
+#include <iterator>
+#include <type_traits>
+
+namespace VFS
+{
+namespace
+{
+    constexpr char indexCacheMagic[] = {'O', 'M', 'W', 'V', 'F', 'S', 'I', 'X'};
+    constexpr std::uint32_t indexCacheVersion = 1;
+
+    using Listings = std::vector<std::pair<std::string, DirectoryListing>>;
+
+    struct IndexCacheData
+    {
+        Listings mListings;
+    };
+
+    template <Serialization::Mode mode>
+    struct Format : Serialization::Format<mode, Format<mode>>
+    {
+        using Serialization::Format<mode, Format<mode>>::operator();
+
+        template <class Visitor, class T>
+        auto operator()(Visitor&& visitor, T& value) const
+            -> std::enable_if_t<std::is_same_v<std::decay_t<T>, std::string>>
+        {
+            if constexpr (mode == Serialization::Mode::Write)
+                visitor(*this, value.size());
+            else
+            {
+                static_assert(mode == Serialization::Mode::Read);
+                std::size_t size = 0;
+                visitor(*this, size);
+                value.resize(size);
+            }
+            visitor(*this, value.data(), value.size());
+        }
+
+        template <class Visitor, class T>
+        auto operator()(Visitor&& visitor, T& value) const
+            -> std::enable_if_t<std::is_same_v<std::decay_t<T>, DirectoryTimestamp>>
+        {
+            visitor(*this, value.mPath);
+            visitor(*this, value.mLastWriteTime);
+        }
+
+        template <class Visitor, class T>
+        auto operator()(Visitor&& visitor, T& value) const
+            -> std::enable_if_t<std::is_same_v<std::decay_t<T>, DirectoryListing>>
+        {
+            visitor(*this, value.mDirectories);
+            visitor(*this, value.mFiles);
+        }
+
+        template <class Visitor, class T>
+        auto operator()(Visitor&& visitor, T& value) const
+            -> std::enable_if_t<std::is_same_v<std::decay_t<T>, std::pair<std::string, DirectoryListing>>>
+        {
+            visitor(*this, value.first);
+            visitor(*this, value.second);
+        }
+
+        template <class Visitor, class T>
+        auto operator()(Visitor&& visitor, T& value) const
+            -> std::enable_if_t<std::is_same_v<std::decay_t<T>, IndexCacheData>>
+        {
+            if constexpr (mode == Serialization::Mode::Write)
+            {
+                visitor(*this, indexCacheMagic);
+                visitor(*this, indexCacheVersion);
+            }
+            else
+            {
+                static_assert(mode == Serialization::Mode::Read);
+                char magic[std::size(indexCacheMagic)];
+                visitor(*this, magic);
+                if (std::memcmp(magic, indexCacheMagic, sizeof(magic)) != 0)
+                    throw std::runtime_error("Bad VFS index cache magic");
+                std::uint32_t version = 0;
+                visitor(*this, version);
+                if (version != indexCacheVersion)
+                    throw std::runtime_error("Bad VFS index cache version");
+            }
+            visitor(*this, value.mListings);
+        }
+    };
+
+    std::int64_t getLastWriteTime(const boost::filesystem::path& path)
+    {
+        boost::system::error_code ec;
+        const std::time_t result = boost::filesystem::last_write_time(path, ec);
+        if (ec)
+            return -1;
+        return static_cast<std::int64_t>(result);
+    }
+
+    bool isUpToDate(const DirectoryListing& listing)
+    {
+        for (const DirectoryTimestamp& directory : listing.mDirectories)
+            if (getLastWriteTime(directory.mPath) != directory.mLastWriteTime)
+                return false;
+        return true;
+    }
+}
+
+    DirectoryListing scanDirectory(const std::string& path)
+    {
+        DirectoryListing result;
+        result.mDirectories.push_back(DirectoryTimestamp {path, getLastWriteTime(path)});
+
+        typedef boost::filesystem::recursive_directory_iterator directory_iterator;
+
+        directory_iterator end;
+
+        for (directory_iterator i (path); i != end; ++i)
+        {
+            if (boost::filesystem::is_directory (*i))
+                result.mDirectories.push_back(DirectoryTimestamp {i->path().string(), getLastWriteTime(i->path())});
+            else
+                result.mFiles.push_back(i->path().string());
+        }
+
+        return result;
+    }
+
+    IndexCache::IndexCache(const boost::filesystem::path& path)
+        : mPath(path)
+    {
+    }
+
+    void IndexCache::load()
+    {
+        IndexCacheData cacheData;
+        try
+        {
+            boost::filesystem::ifstream stream(mPath, std::ios_base::binary);
+            if (!stream.is_open())
+                return;
+            std::vector<char> data((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+            const std::byte* begin = reinterpret_cast<const std::byte*>(data.data());
+            constexpr Format<Serialization::Mode::Read> format;
+            format(Serialization::BinaryReader(begin, begin + data.size()), cacheData);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Ignoring VFS index cache \"" << mPath.string() << "\": " << e.what();
+            return;
+        }
+
+        const std::lock_guard<std::mutex> lock(mMutex);
+        mEntries.clear();
+        for (auto& [path, listing] : cacheData.mListings)
+            mEntries.emplace(std::move(path), Entry {std::move(listing), false});
+        mChanged = false;
+    }
+
+    void IndexCache::save()
+    {
+        IndexCacheData cacheData;
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            for (const auto& [path, entry] : mEntries)
+            {
+                if (entry.mUsed)
+                    cacheData.mListings.emplace_back(path, entry.mListing);
+                else
+                    mChanged = true;
+            }
+            if (!mChanged)
+                return;
+            mChanged = false;
+        }
+
+        try
+        {
+            constexpr Format<Serialization::Mode::Write> format;
+            Serialization::SizeAccumulator sizeAccumulator;
+            format(sizeAccumulator, cacheData);
+            std::vector<std::byte> data(sizeAccumulator.value());
+            format(Serialization::BinaryWriter(data.data(), data.data() + data.size()), cacheData);
+            boost::filesystem::create_directories(mPath.parent_path());
+            boost::filesystem::ofstream stream(mPath, std::ios_base::binary | std::ios_base::trunc);
+            stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+            if (!stream)
+                throw std::runtime_error("failed to write file");
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to save VFS index cache \"" << mPath.string() << "\": " << e.what();
+        }
+    }
+
+    std::optional<DirectoryListing> IndexCache::get(const std::string& path)
+    {
+        DirectoryListing listing;
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            const auto it = mEntries.find(path);
+            if (it == mEntries.end())
+                return {};
+            listing = it->second.mListing;
+        }
+
+        if (!isUpToDate(listing))
+            return {};
+
+        const std::lock_guard<std::mutex> lock(mMutex);
+        mEntries[path].mUsed = true;
+        return listing;
+    }
+
+    void IndexCache::set(const std::string& path, DirectoryListing listing)
+    {
+        // Modification times have a resolution of a second, a change made in the same second as the scan
+        // would go unnoticed
+        const std::int64_t now = static_cast<std::int64_t>(std::time(nullptr));
+        for (const DirectoryTimestamp& directory : listing.mDirectories)
+            if (directory.mLastWriteTime < 0 || directory.mLastWriteTime >= now - 1)
+                return;
+
+        const std::lock_guard<std::mutex> lock(mMutex);
+        mEntries[path] = Entry {std::move(listing), true};
+        mChanged = true;
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef OPENMW_COMPONENTS_VFS_INDEXCACHE_H
+#define OPENMW_COMPONENTS_VFS_INDEXCACHE_H
+
+#include <boost/filesystem/path.hpp>
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace VFS
+{
+    struct DirectoryTimestamp
+    {
+        std::string mPath;
+        std::int64_t mLastWriteTime = 0;
+    };
+
+    /// Files found in a directory tree, and the modification time of every directory in it at the time of the scan.
+    /// Adding, removing or renaming an entry updates the modification time of its parent directory, so a listing is
+    /// up to date as long as all of its directories have the same modification times.
+    struct DirectoryListing
+    {
+        std::vector<DirectoryTimestamp> mDirectories;
+        std::vector<std::string> mFiles;
+    };
+
+    /// Recursively list all files in the given directory.
+    DirectoryListing scanDirectory(const std::string& path);
+
+    /// @brief On-disk snapshot of the loose file data directory listings, so the directories don't have to be scanned
+    /// again on start when nothing in them has changed.
+    /// @note Thread safe.
+    class IndexCache
+    {
+    public:
+        explicit IndexCache(const boost::filesystem::path& path);
+
+        /// Read the snapshot from disk. A missing, outdated or corrupted snapshot is ignored.
+        void load();
+
+        /// Write listings used since load() to disk, dropping the ones for directories that are no longer used.
+        void save();
+
+        /// @return Listing of the given directory, or nothing if there is none or the directory has changed since.
+        std::optional<DirectoryListing> get(const std::string& path);
+
+        void set(const std::string& path, DirectoryListing listing);
+
+    private:
+        struct Entry
+        {
+            DirectoryListing mListing;
+            bool mUsed = false;
+        };
+
+        const boost::filesystem::path mPath;
+        std::mutex mMutex;
+        std::map<std::string, Entry> mEntries;
+        bool mChanged = false;
+    };
+}
+
+#endif
@@ -1,6 +1,12 @@
 #include "manager.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iterator>
+#include <map>
 #include <stdexcept>
+#include <thread>
 
 #include <components/misc/stringops.hpp>
 
@@ -25,6 +31,29 @@ namespace
         std::transform(path.begin(), path.end(), path.begin(), normalize_char);
     }
 
+    char normalize_char(char ch, bool strict)
+    {
+        return strict ? strict_normalize_char(ch) : nonstrict_normalize_char(ch);
+    }
+
+    /// FNV-1a over the normalized characters of the path.
+    std::uint64_t hash_path(std::string_view path, bool strict)
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (char ch : path)
+        {
+            hash ^= static_cast<unsigned char>(normalize_char(ch, strict));
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    bool equal_path(std::string_view normalized, std::string_view path, bool strict)
+    {
+        return normalized.size() == path.size() && std::equal(path.begin(), path.end(), normalized.begin(),
+            [strict] (char ch, char normalizedCh) { return normalize_char(ch, strict) == normalizedCh; });
+    }
+
 }
 
 namespace VFS
@@ -43,7 +72,8 @@ namespace VFS
 
     void Manager::reset()
     {
-        mIndex.clear();
+        mFiles.clear();
+        mSlots.clear();
         for (std::vector<Archive*>::iterator it = mArchives.begin(); it != mArchives.end(); ++it)
             delete *it;
         mArchives.clear();
@@ -56,34 +86,125 @@ namespace VFS
 
     void Manager::buildIndex()
     {
-        mIndex.clear();
+        // Archives don't share any state, so each one is listed into its own partial index concurrently
+        std::vector<std::map<std::string, File*>> partialIndices(mArchives.size());
+        std::vector<std::exception_ptr> errors(mArchives.size());
+        std::atomic_size_t nextArchive {0};
+        const auto listArchives = [&]
+        {
+            for (std::size_t i = nextArchive++; i < mArchives.size(); i = nextArchive++)
+            {
+                try
+                {
+                    mArchives[i]->listResources(partialIndices[i], mStrict ? &strict_normalize_char : &nonstrict_normalize_char);
+                }
+                catch (...)
+                {
+                    errors[i] = std::current_exception();
+                }
+            }
+        };
+
+        const std::size_t threadsCount = std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), mArchives.size());
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < threadsCount; ++i)
+            threads.emplace_back(listArchives);
+        listArchives();
+        for (std::thread& thread : threads)
+            thread.join();
+
+        for (const std::exception_ptr& error : errors)
+            if (error != nullptr)
+                std::rethrow_exception(error);
+
+        // Merge in the registration order, so files from the last added archive have priority
+        std::map<std::string, File*> index;
+        for (std::map<std::string, File*>& partialIndex : partialIndices)
+        {
+            if (index.empty())
+                index.swap(partialIndex);
+            else
+                for (const auto& [name, file] : partialIndex)
+                    index.insert_or_assign(name, file);
+        }
 
-        for (std::vector<Archive*>::const_iterator it = mArchives.begin(); it != mArchives.end(); ++it)
-            (*it)->listResources(mIndex, mStrict ? &strict_normalize_char : &nonstrict_normalize_char);
+        mFiles.assign(index.begin(), index.end());
+
+        // Keep the load factor at or below 1/2 so probe sequences stay short
+        std::size_t slotCount = 1;
+        while (slotCount < mFiles.size() * 2)
+            slotCount *= 2;
+        const std::size_t mask = slotCount - 1;
+
+        mSlots.assign(slotCount, IndexSlot {});
+        for (std::size_t i = 0; i < mFiles.size(); ++i)
+        {
+            const std::uint64_t hash = hash_path(mFiles[i].first, mStrict);
+            std::size_t slot = static_cast<std::size_t>(hash) & mask;
+            while (mSlots[slot].mFileIndex != 0)
+                slot = (slot + 1) & mask;
+            mSlots[slot] = IndexSlot {hash, i + 1};
+        }
     }
 
-    Files::IStreamPtr Manager::get(const std::string &name) const
+    File* Manager::lookup(std::string_view name) const
     {
-        std::string normalized = name;
-        normalize_path(normalized, mStrict);
+        if (mSlots.empty())
+            return nullptr;
 
-        return getNormalized(normalized);
+        const std::uint64_t hash = hash_path(name, mStrict);
+        const std::size_t mask = mSlots.size() - 1;
+        for (std::size_t slot = static_cast<std::size_t>(hash) & mask; mSlots[slot].mFileIndex != 0; slot = (slot + 1) & mask)
+        {
+            if (mSlots[slot].mHash != hash)
+                continue;
+            const IndexEntry& entry = mFiles[mSlots[slot].mFileIndex - 1];
+            if (equal_path(entry.first, name, mStrict))
+                return entry.second;
+        }
+        return nullptr;
+    }
+
+    Files::IStreamPtr Manager::get(std::string_view name) const
+    {
+        File* const file = lookup(name);
+        if (file == nullptr)
+            throw std::runtime_error("Resource '" + normalizeFilename(std::string(name)) + "' not found");
+        return file->open();
     }
 
     Files::IStreamPtr Manager::getNormalized(const std::string &normalizedName) const
     {
-        std::map<std::string, File*>::const_iterator found = mIndex.find(normalizedName);
-        if (found == mIndex.end())
+        File* const file = lookup(normalizedName);
+        if (file == nullptr)
             throw std::runtime_error("Resource '" + normalizedName + "' not found");
-        return found->second->open();
+        return file->open();
     }
 
-    bool Manager::exists(const std::string &name) const
+    Files::FileView Manager::getView(std::string_view name) const
     {
-        std::string normalized = name;
-        normalize_path(normalized, mStrict);
+        File* const file = lookup(name);
+        if (file == nullptr)
+            throw std::runtime_error("Resource '" + normalizeFilename(std::string(name)) + "' not found");
 
-        return mIndex.find(normalized) != mIndex.end();
+        Files::FileView view = file->view();
+        if (view.isValid())
+            return view;
+
+        const Files::IStreamPtr stream = file->open();
+        auto buffer = std::make_shared<std::string>(std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>());
+        return Files::FileView {buffer->data(), buffer->size(), buffer};
+    }
+
+    void Manager::prefetch(std::string_view name) const
+    {
+        if (File* const file = lookup(name))
+            file->prefetch();
+    }
+
+    bool Manager::exists(std::string_view name) const
+    {
+        return lookup(name) != nullptr;
     }
 
     std::string Manager::normalizeFilename(const std::string& name) const
@@ -111,17 +232,23 @@ namespace VFS
         {
             return text.rfind(start, 0) == 0;
         }
+
+        struct CompareName
+        {
+            template <class Entry>
+            bool operator()(const Entry& entry, std::string_view name) const { return entry.first < name; }
+        };
     }
 
     Manager::RecursiveDirectoryRange Manager::getRecursiveDirectoryIterator(const std::string& path) const
     {
         if (path.empty())
-            return { mIndex.begin(), mIndex.end() };
+            return { mFiles.begin(), mFiles.end() };
         auto normalized = normalizeFilename(path);
-        const auto it = mIndex.lower_bound(normalized);
-        if (it == mIndex.end() || !startsWith(it->first, normalized))
+        const auto it = std::lower_bound(mFiles.begin(), mFiles.end(), normalized, CompareName {});
+        if (it == mFiles.end() || !startsWith(it->first, normalized))
             return { it, it };
         ++normalized.back();
-        return { it, mIndex.lower_bound(normalized) };
+        return { it, std::lower_bound(it, mFiles.end(), normalized, CompareName {}) };
     }
 }
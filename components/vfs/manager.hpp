@@ -2,9 +2,13 @@
 #define OPENMW_COMPONENTS_RESOURCEMANAGER_H
 
 #include <components/files/constrainedfilestream.hpp>
+#include <components/files/memorymappedfile.hpp>
 
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
-#include <map>
 
 namespace VFS
 {
@@ -32,17 +36,27 @@ namespace VFS
     /// @par Most of the methods in this class are considered thread-safe, see each method documentation for details.
     class Manager
     {
+        using IndexEntry = std::pair<std::string, File*>;
+
+        /// Slot of the open addressing hash table over normalized file names.
+        struct IndexSlot
+        {
+            std::uint64_t mHash = 0;
+            /// Index into mFiles plus one, zero marks an empty slot.
+            std::size_t mFileIndex = 0;
+        };
+
         class RecursiveDirectoryIterator
         {
         public:
-            RecursiveDirectoryIterator(std::map<std::string, File*>::const_iterator it) : mIt(it) {}
+            RecursiveDirectoryIterator(std::vector<IndexEntry>::const_iterator it) : mIt(it) {}
             const std::string& operator*() const { return mIt->first; }
             const std::string* operator->() const { return &mIt->first; }
             bool operator!=(const RecursiveDirectoryIterator& other) { return mIt != other.mIt; }
             RecursiveDirectoryIterator& operator++() { ++mIt; return *this; }
 
         private:
-            std::map<std::string, File*>::const_iterator mIt;
+            std::vector<IndexEntry>::const_iterator mIt;
         };
 
         using RecursiveDirectoryRange = IteratorPair<RecursiveDirectoryIterator>;
@@ -62,11 +76,12 @@ namespace VFS
         void addArchive(Archive* archive);
 
         /// Build the file index. Should be called when all archives have been registered.
+        /// @note Archives are listed concurrently, so Archive::listResources must not touch state shared with other archives.
         void buildIndex();
 
         /// Does a file with this name exist?
         /// @note May be called from any thread once the index has been built.
-        bool exists(const std::string& name) const;
+        bool exists(std::string_view name) const;
 
         /// Normalize the given filename, making slashes/backslashes consistent, and lower-casing if mStrict is false.
         /// @note May be called from any thread once the index has been built.
@@ -75,13 +90,24 @@ namespace VFS
         /// Retrieve a file by name.
         /// @note Throws an exception if the file can not be found.
         /// @note May be called from any thread once the index has been built.
-        Files::IStreamPtr get(const std::string& name) const;
+        Files::IStreamPtr get(std::string_view name) const;
 
         /// Retrieve a file by name (name is already normalized).
         /// @note Throws an exception if the file can not be found.
         /// @note May be called from any thread once the index has been built.
         Files::IStreamPtr getNormalized(const std::string& normalizedName) const;
 
+        /// Retrieve a read-only view of a file's contents by name. The view is served without copying when the
+        /// archive containing the file is memory mapped, otherwise the file is read into a buffer owned by the view.
+        /// @note Throws an exception if the file can not be found.
+        /// @note May be called from any thread once the index has been built.
+        Files::FileView getView(std::string_view name) const;
+
+        /// Prepare a file for reading ahead of time, e.g. by decompressing it into a cache.
+        /// @note Does nothing if the file can not be found.
+        /// @note May be called from any thread once the index has been built.
+        void prefetch(std::string_view name) const;
+
         std::string getArchive(const std::string& name) const;
 
         /// Recursivly iterate over the elements of the given path
@@ -95,7 +121,15 @@ namespace VFS
 
         std::vector<Archive*> mArchives;
 
-        std::map<std::string, File*> mIndex;
+        /// All indexed files sorted by normalized name, for prefix searches.
+        std::vector<IndexEntry> mFiles;
+
+        /// Hash table over mFiles with a power of two size, resolving collisions with linear probing.
+        std::vector<IndexSlot> mSlots;
+
+        /// Find a file by name, normalizing the name on the fly without allocating.
+        /// @return nullptr if there is no such file.
+        File* lookup(std::string_view name) const;
     };
 
 }
@@ -12,7 +12,8 @@
 namespace VFS
 {
 
-    void registerArchives(VFS::Manager *vfs, const Files::Collections &collections, const std::vector<std::string> &archives, bool useLooseFiles)
+    void registerArchives(VFS::Manager *vfs, const Files::Collections &collections, const std::vector<std::string> &archives, bool useLooseFiles, bool memoryMapArchives,
+        IndexCache* indexCache)
     {
         const Files::PathContainer& dataDirs = collections.getPaths();
 
@@ -26,9 +27,9 @@ namespace VFS
                 Bsa::BsaVersion bsaVersion = Bsa::CompressedBSAFile::detectVersion(archivePath);
 
                 if (bsaVersion == Bsa::BSAVER_COMPRESSED)
-                    vfs->addArchive(new CompressedBsaArchive(archivePath));
+                    vfs->addArchive(new CompressedBsaArchive(archivePath, memoryMapArchives));
                 else
-                    vfs->addArchive(new BsaArchive(archivePath));
+                    vfs->addArchive(new BsaArchive(archivePath, memoryMapArchives));
             }
             else
             {
@@ -47,7 +48,7 @@ namespace VFS
                 {
                     Log(Debug::Info) << "Adding data directory " << iter->string();
                     // Last data dir has the highest priority
-                    vfs->addArchive(new FileSystemArchive(iter->string()));
+                    vfs->addArchive(new FileSystemArchive(iter->string(), indexCache));
                 }
                 else
                     Log(Debug::Info) << "Ignoring duplicate data directory " << iter->string();
@@ -6,10 +6,14 @@
 namespace VFS
 {
     class Manager;
+    class IndexCache;
 
     /// @brief Register BSA and file system archives based on the given OpenMW configuration.
+    /// @param memoryMapArchives Map BSA archives into memory instead of opening a file stream for each read.
+    /// @param indexCache Optional snapshot of data directory listings, used to skip scanning unchanged directories.
     void registerArchives (VFS::Manager* vfs, const Files::Collections& collections,
-        const std::vector<std::string>& archives, bool useLooseFiles);
+        const std::vector<std::string>& archives, bool useLooseFiles, bool memoryMapArchives = false,
+        IndexCache* indexCache = nullptr);
 }
 
 #endif